@@ -63,7 +63,9 @@ void exposeConstraintManager() {
           bp::make_getter(&ConstraintItem::constraint,
                           bp::return_value_policy<bp::return_by_value>()),
           "constraint model")
-      .def_readwrite("active", &ConstraintItem::active, "constraint status")
+      .def_readwrite(
+          "active", &ConstraintItem::active,
+          "constraint status (modify it with changeConstraintStatus)")
       .def(CopyableVisitor<ConstraintItem>())
       .def(PrintableVisitor<ConstraintItem>());
 
@@ -43,6 +43,7 @@ void exposeCore() {
   exposeDifferentialActionNumDiff();
   exposeActivationNumDiff();
   exposeStateNumDiff();
+  exposeExecutor();
   exposeShootingProblem();
   exposeSolverAbstract();
   exposeStateEuclidean();
@@ -68,6 +69,7 @@ void exposeCore() {
   exposeSolverBoxDDP();
   exposeSolverBoxFDDP();
   exposeSolverIntro();
+  exposeSolverBatch();
 #ifdef CROCODDYL_WITH_IPOPT
   exposeSolverIpopt();
 #endif
@@ -70,12 +70,14 @@ void exposeSolverBoxQP();
 void exposeSolverBoxDDP();
 void exposeSolverBoxFDDP();
 void exposeSolverIntro();
+void exposeSolverBatch();
 #ifdef CROCODDYL_WITH_IPOPT
 void exposeSolverIpopt();
 #endif
 void exposeCallbacks();
 void exposeException();
 void exposeStopWatch();
+void exposeExecutor();
 
 void exposeCore();
 
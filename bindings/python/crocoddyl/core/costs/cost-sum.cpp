@@ -57,7 +57,8 @@ void exposeCostSum() {
                           bp::return_value_policy<bp::return_by_value>()),
           "cost model")
       .def_readwrite("weight", &CostItem::weight, "cost weight")
-      .def_readwrite("active", &CostItem::active, "cost status")
+      .def_readwrite("active", &CostItem::active,
+                     "cost status (modify it with changeCostStatus)")
       .def(CopyableVisitor<CostItem>())
       .def(PrintableVisitor<CostItem>());
 
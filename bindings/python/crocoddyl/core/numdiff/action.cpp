@@ -83,6 +83,19 @@ void exposeActionNumDiff() {
           bp::make_function(&ActionModelNumDiff::get_with_gauss_approx,
                             bp::return_value_policy<bp::return_by_value>()),
           "Gauss approximation for computing the Hessians")
+      .add_property(
+          "nthreads", bp::make_function(&ActionModelNumDiff::get_nthreads),
+          bp::make_function(&ActionModelNumDiff::set_nthreads),
+          "number of threads used to compute the perturbations (it is "
+          "resolved by the executor, so set the executor first; for the "
+          "default executor, if you set nthreads <= 1, then "
+          "nthreads=CROCODDYL_WITH_NTHREADS)")
+      .add_property(
+          "executor",
+          bp::make_function(&ActionModelNumDiff::get_executor,
+                            bp::return_value_policy<bp::return_by_value>()),
+          &ActionModelNumDiff::set_executor,
+          "executor used to compute the perturbations in parallel")
       .def(CopyableVisitor<ActionModelNumDiff>());
 
   bp::register_ptr_to_python<std::shared_ptr<ActionDataNumDiff> >();
@@ -88,6 +88,20 @@ void exposeDifferentialActionNumDiff() {
                     bp::make_function(
                         &DifferentialActionModelNumDiff::get_with_gauss_approx),
                     "Gauss approximation for computing the Hessians")
+      .add_property(
+          "nthreads",
+          bp::make_function(&DifferentialActionModelNumDiff::get_nthreads),
+          bp::make_function(&DifferentialActionModelNumDiff::set_nthreads),
+          "number of threads used to compute the perturbations (it is "
+          "resolved by the executor, so set the executor first; for the "
+          "default executor, if you set nthreads <= 1, then "
+          "nthreads=CROCODDYL_WITH_NTHREADS)")
+      .add_property(
+          "executor",
+          bp::make_function(&DifferentialActionModelNumDiff::get_executor,
+                            bp::return_value_policy<bp::return_by_value>()),
+          &DifferentialActionModelNumDiff::set_executor,
+          "executor used to compute the perturbations in parallel")
       .def(CopyableVisitor<DifferentialActionModelNumDiff>());
 
   bp::register_ptr_to_python<std::shared_ptr<DifferentialActionDataNumDiff> >();
@@ -68,14 +68,31 @@ void exposeShootingProblem() {
            ":param xs: time-discrete state trajectory (size T+1)\n"
            ":param us: time-discrete control sequence (size T)\n"
            ":returns the total cost value")
-      .def("calcDiff", &ShootingProblem::calcDiff, bp::args("self", "xs", "us"),
-           "Compute the derivatives of the cost and dynamics.\n\n"
-           "For each node k, and along the state x_s and control u_s "
-           "trajectories, it computes the derivatives of\n"
-           "the cost (lx, lu, lxx, lxu, luu) and dynamics (fx, fu).\n"
-           ":param xs: time-discrete state trajectory (size T+1)\n"
-           ":param us: time-discrete control sequence (size T)\n"
-           ":returns the total cost value")
+      .def<double (ShootingProblem::*)(const std::vector<Eigen::VectorXd>&,
+                                       const std::vector<Eigen::VectorXd>&)>(
+          "calcDiff", &ShootingProblem::calcDiff, bp::args("self", "xs", "us"),
+          "Compute the derivatives of the cost and dynamics.\n\n"
+          "For each node k, and along the state x_s and control u_s "
+          "trajectories, it computes the derivatives of\n"
+          "the cost (lx, lu, lxx, lxu, luu) and dynamics (fx, fu).\n"
+          ":param xs: time-discrete state trajectory (size T+1)\n"
+          ":param us: time-discrete control sequence (size T)\n"
+          ":returns the total cost value")
+      .def<double (ShootingProblem::*)(const std::vector<Eigen::VectorXd>&,
+                                       const std::vector<Eigen::VectorXd>&,
+                                       const std::vector<Eigen::VectorXd>&)>(
+          "calcDiff", &ShootingProblem::calcDiff,
+          bp::args("self", "xs", "us", "lambdas"),
+          "Compute the derivatives of the cost and dynamics, and the "
+          "second-order terms of the dynamics.\n\n"
+          "Along with the derivatives, it computes the Hessian of "
+          "lambda_{k+1}^T f_k with respect to (dx, u) in each running node\n"
+          "(see dynamicsHessians). It requires to enable the second-order "
+          "terms.\n"
+          ":param xs: time-discrete state trajectory (size T+1)\n"
+          ":param us: time-discrete control sequence (size T)\n"
+          ":param lambdas: time-discrete costates (size T+1)\n"
+          ":returns the total cost value")
       .def("rollout", &ShootingProblem::rollout_us, bp::args("self", "us"),
            "Integrate the dynamics given a control sequence.\n\n"
            "Rollout the dynamics give a sequence of control commands\n"
@@ -101,7 +118,8 @@ void exposeShootingProblem() {
           "Circular append the model and data onto the end running node.\n\n"
           "Once we update the end running node, the first running mode is "
           "removed as in a circular buffer.\n"
-          "Note that this method allocates new data for the end running node.\n"
+          "Note that this method allocates new data for the end running node, "
+          "unless the data pool contains a data of this model.\n"
           ":param model: new model")
       .def("updateNode", &ShootingProblem::updateNode,
            bp::args("self", "i", "model", "data"),
@@ -112,8 +130,17 @@ void exposeShootingProblem() {
       .def("updateModel", &ShootingProblem::updateModel,
            bp::args("self", "i", "model"),
            "Update a model and allocated new data for a specific node.\n\n"
+           "The data is taken from the data pool if it contains a data of "
+           "this model.\n"
            ":param i: index of the node (0 <= i <= T + 1)\n"
            ":param model: new model")
+      .def("reserveDatas", &ShootingProblem::reserveDatas,
+           bp::args("self", "model", "n"),
+           "Create datas of a model and store them in the data pool.\n\n"
+           "This allows to later update the nodes with this model without "
+           "allocating new data.\n"
+           ":param model: action model\n"
+           ":param n: number of datas")
       .add_property("T", bp::make_function(&ShootingProblem::get_T),
                     "number of running nodes")
       .add_property("x0",
@@ -144,8 +171,50 @@ void exposeShootingProblem() {
                     bp::make_function(&ShootingProblem::get_nthreads),
                     bp::make_function(&ShootingProblem::set_nthreads),
                     "number of threads launch by the multi-threading support "
-                    "(if you set nthreads <= 1, then "
-                    "nthreads=CROCODDYL_WITH_NTHREADS)")
+                    "(it is resolved by the executor, so set the executor "
+                    "first; for the default executor, if you set "
+                    "nthreads <= 1, then nthreads=CROCODDYL_WITH_NTHREADS)")
+      .add_property(
+          "executor",
+          bp::make_function(&ShootingProblem::get_executor,
+                            bp::return_value_policy<bp::return_by_value>()),
+          &ShootingProblem::set_executor,
+          "executor used to compute the nodes in parallel")
+      .add_property("balance_nodes", &ShootingProblem::get_balance_nodes,
+                    &ShootingProblem::set_balance_nodes,
+                    "true if the nodes are balanced across threads using "
+                    "their measured timings (default False)")
+      .add_property("use_arena", &ShootingProblem::get_use_arena,
+                    &ShootingProblem::set_use_arena,
+                    "true if the data of each node is allocated in its own "
+                    "arena (default False)")
+      .add_property("data_pool_size", &ShootingProblem::get_data_pool_size,
+                    &ShootingProblem::set_data_pool_size,
+                    "maximum number of datas recycled from the removed nodes "
+                    "(default 0)")
+      .add_property("second_order", &ShootingProblem::get_second_order,
+                    &ShootingProblem::set_second_order,
+                    "true if the second-order terms of the dynamics are "
+                    "computed, i.e., the DDP-based solvers run the full DDP "
+                    "(default False)")
+      .add_property(
+          "dynamicsHessians",
+          bp::make_function(&ShootingProblem::get_dynamicsHessians,
+                            bp::return_value_policy<bp::return_by_value>()),
+          "second-order terms of the dynamics in each running node")
+      .add_property("data_pool_ndatas",
+                    bp::make_function(&ShootingProblem::get_data_pool_ndatas),
+                    "number of datas stored in the data pool")
+      .add_property(
+          "calc_times",
+          bp::make_function(&ShootingProblem::get_calc_times,
+                            bp::return_value_policy<bp::return_by_value>()),
+          "smoothed wall time of calc in each node (in microseconds)")
+      .add_property(
+          "calcDiff_times",
+          bp::make_function(&ShootingProblem::get_calcDiff_times,
+                            bp::return_value_policy<bp::return_by_value>()),
+          "smoothed wall time of calcDiff in each node (in microseconds)")
       .add_property("nx", bp::make_function(&ShootingProblem::get_nx),
                     "dimension of state tuple")
       .add_property("ndx", bp::make_function(&ShootingProblem::get_ndx),
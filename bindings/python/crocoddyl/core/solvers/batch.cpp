@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/batch.hpp"
+
+#include "python/crocoddyl/core/core.hpp"
+#include "python/crocoddyl/utils/copyable.hpp"
+#include "python/crocoddyl/utils/vector-converter.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverBatch_solves, SolverBatch::solve,
+                                       0, 5)
+
+void exposeSolverBatch() {
+  // Register custom converters between std::vector and Python list
+  typedef std::shared_ptr<SolverAbstract> SolverAbstractPtr;
+  StdVectorPythonVisitor<std::vector<SolverAbstractPtr>, true>::expose(
+      "StdVec_SolverAbstract");
+  StdVectorPythonVisitor<std::vector<std::vector<Eigen::VectorXd> >,
+                         true>::expose("StdVec_StdVec_VectorX");
+
+  bp::class_<SolverBatchResult>(
+      "SolverBatchResult", "Result of a problem solved within a batch.\n\n",
+      bp::init<>(bp::args("self"), "Initialize the batch result."))
+      .def_readwrite("is_converged", &SolverBatchResult::is_converged,
+                     "true if the solver has reached convergence")
+      .def_readwrite("iter", &SolverBatchResult::iter,
+                     "number of iterations performed by the solver")
+      .def_readwrite("cost", &SolverBatchResult::cost,
+                     "total cost of the optimal trajectory")
+      .def_readwrite("stop", &SolverBatchResult::stop,
+                     "value computed by the stopping criteria")
+      .def_readwrite("ffeas", &SolverBatchResult::ffeas,
+                     "feasibility of the dynamic constraints")
+      .def_readwrite("preg", &SolverBatchResult::preg,
+                     "primal regularization value")
+      .def_readwrite("error", &SolverBatchResult::error,
+                     "message of the exception thrown by the solver (empty if "
+                     "it has not failed)")
+      .def(CopyableVisitor<SolverBatchResult>());
+
+  StdVectorPythonVisitor<std::vector<SolverBatchResult>, true>::expose(
+      "StdVec_SolverBatchResult");
+
+  bp::register_ptr_to_python<std::shared_ptr<SolverBatch> >();
+
+  bp::class_<SolverBatch>(
+      "SolverBatch",
+      "Batch solver for independent optimal control problems.\n\n"
+      "It solves a set of independent shooting problems with their own "
+      "solvers.\n"
+      "The parallelism is across problems instead of across nodes, i.e., each "
+      "problem\n"
+      "is solved by a single thread and the problems are dynamically "
+      "scheduled.\n"
+      "Note that the solvers must not share their shooting problems, and "
+      "that\n"
+      "Python-derived models, callbacks and the profiler are not thread-safe.",
+      bp::init<std::vector<std::shared_ptr<SolverAbstract> > >(
+          bp::args("self", "solvers"),
+          "Initialize the batch solver.\n\n"
+          ":param solvers: solvers of each problem"))
+      .def("solve", &SolverBatch::solve,
+           SolverBatch_solves(
+               bp::args("self", "init_xs", "init_us", "maxiter", "is_feasible",
+                        "init_reg"),
+               "Solve all the problems of the batch.\n\n"
+               "The exceptions thrown by a solver do not stop the batch; "
+               "instead, they\n"
+               "are reported in its result.\n"
+               ":param init_xs: initial guess for the state trajectory of "
+               "each problem (default [])\n"
+               ":param init_us: initial guess for the control trajectory of "
+               "each problem (default [])\n"
+               ":param maxiter: maximum allowed number of iterations (default "
+               "100)\n"
+               ":param is_feasible: true if the init_xs are obtained from "
+               "integrating the init_us (rollout) (default False)\n"
+               ":param init_reg: initial guess for the regularization value\n"
+               ":returns true if all the problems have reached convergence."))
+      .add_property("solvers",
+                    bp::make_function(&SolverBatch::get_solvers,
+                                      bp::return_value_policy<
+                                          bp::copy_const_reference>()),
+                    bp::make_function(&SolverBatch::set_solvers),
+                    "solvers of each problem")
+      .add_property("results",
+                    bp::make_function(&SolverBatch::get_results,
+                                      bp::return_value_policy<
+                                          bp::copy_const_reference>()),
+                    "result of each problem")
+      .add_property("nthreads", bp::make_function(&SolverBatch::get_nthreads),
+                    bp::make_function(&SolverBatch::set_nthreads),
+                    "number of threads used to solve the batch")
+      .def(CopyableVisitor<SolverBatch>());
+}
+
+}  // namespace python
+}  // namespace crocoddyl
@@ -32,7 +32,8 @@ void exposeSolverBoxQP() {
                     bp::make_getter(&BoxQPSolution::Hff_inv,
                                     bp::return_internal_reference<>()),
                     bp::make_setter(&BoxQPSolution::Hff_inv),
-                    "inverse of the free Hessian matrix")
+                    "inverse of the free Hessian matrix (stored in the "
+                    "top-left block of dimension len(free_idx))")
       .add_property(
           "x",
           bp::make_getter(&BoxQPSolution::x, bp::return_internal_reference<>()),
@@ -66,7 +67,11 @@ void exposeSolverBoxQP() {
           ":param th_acceptstep: acceptance step condition (default 0.1)\n"
           ":param th_grad: gradient tolerance condition (default 1e-9)\n"
           ":param reg: regularization (default 1e-9)"))
-      .def("solve", &BoxQP::solve,
+      .def("solve",
+           static_cast<const BoxQPSolution& (BoxQP::*)(
+               const Eigen::MatrixXd&, const Eigen::VectorXd&,
+               const Eigen::VectorXd&, const Eigen::VectorXd&,
+               const Eigen::VectorXd&)>(&BoxQP::solve),
            bp::return_value_policy<bp::return_by_value>(),
            bp::args("H", "q", "lb", "ub", "xinit"),
            "Compute the solution of bound-constrained QP based on Newton "
@@ -76,6 +81,22 @@ void exposeSolverBoxQP() {
            ":param lb: lower bound (dimension nx)\n"
            ":param ub: upper bound (dimension nx)\n"
            ":param xinit: initial guess")
+      .def("solve",
+           static_cast<const BoxQPSolution& (BoxQP::*)(
+               const Eigen::MatrixXd&, const Eigen::VectorXd&,
+               const Eigen::VectorXd&, const Eigen::VectorXd&,
+               const Eigen::VectorXd&, const std::vector<std::size_t>&)>(
+               &BoxQP::solve),
+           bp::return_value_policy<bp::return_by_value>(),
+           bp::args("H", "q", "lb", "ub", "xinit", "clamped_init"),
+           "Compute the solution of bound-constrained QP based on Newton "
+           "projection warm-started from a previous active set.\n\n"
+           ":param H: Hessian (dimension nx * nx)\n"
+           ":param q: gradient (dimension nx)\n"
+           ":param lb: lower bound (dimension nx)\n"
+           ":param ub: upper bound (dimension nx)\n"
+           ":param xinit: initial guess\n"
+           ":param clamped_init: initial clamped indexes")
       .add_property("solution",
                     bp::make_function(
                         &BoxQP::get_solution,
@@ -108,6 +129,10 @@ void exposeSolverBoxQP() {
                         bp::return_value_policy<bp::copy_const_reference>()),
                     bp::make_function(&BoxQP::set_alphas),
                     "list of step length (alpha) values")
+      .add_property("compute_inverse",
+                    bp::make_function(&BoxQP::get_compute_inverse),
+                    bp::make_function(&BoxQP::set_compute_inverse),
+                    "compute the inverse of the free space Hessian.")
       .def(CopyableVisitor<BoxQP>());
 }
 
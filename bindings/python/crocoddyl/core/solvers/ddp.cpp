@@ -247,6 +247,20 @@ void exposeSolverDDP() {
               bp::return_value_policy<bp::reference_existing_object>()),
           bp::make_function(&SolverDDP::set_alphas),
           "list of step length (alpha) values")
+      .add_property("ls_nthreads",
+                    bp::make_function(&SolverDDP::get_ls_nthreads),
+                    bp::make_function(&SolverDDP::set_ls_nthreads),
+                    "number of step lengths rolled out concurrently by the "
+                    "line search (default 1)")
+      .add_property("bp_nthreads",
+                    bp::make_function(&SolverDDP::get_bp_nthreads),
+                    bp::make_function(&SolverDDP::set_bp_nthreads),
+                    "number of threads used by the backward pass (default 1)")
+      .add_property("bp_fixed_size",
+                    bp::make_function(&SolverDDP::get_bp_fixed_size),
+                    bp::make_function(&SolverDDP::set_bp_fixed_size),
+                    "use the fixed-size Riccati step for the supported "
+                    "dimensions (default False)")
       .def(CopyableVisitor<SolverDDP>());
 }
 
@@ -13,6 +13,12 @@ BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverIpopt_solves, SolverIpopt::solve,
 
 void exposeSolverIpopt() {
   bp::register_ptr_to_python<std::shared_ptr<SolverIpopt>>();
+
+  bp::enum_<IpoptHessianType>("IpoptHessianType")
+      .value("FullHessian", FullHessian)
+      .value("LimitedMemoryHessian", LimitedMemoryHessian)
+      .export_values();
+
   bp::class_<SolverIpopt, bp::bases<SolverAbstract>>(
       "SolverIpopt",
       bp::init<const std::shared_ptr<crocoddyl::ShootingProblem>&>(
@@ -53,6 +59,20 @@ void exposeSolverIpopt() {
       .add_property("th_stop", bp::make_function(&SolverIpopt::get_th_stop),
                     bp::make_function(&SolverIpopt::set_th_stop),
                     "threshold for stopping criteria")
+      .add_property(
+          "sparsity_detection",
+          bp::make_function(&SolverIpopt::get_sparsity_detection),
+          bp::make_function(&SolverIpopt::set_sparsity_detection),
+          "detect the sparsity pattern of the NLP derivatives (default "
+          "False).\n\n"
+          "Warning: the pattern is detected by sampling a few random points, "
+          "so it misses the entries that are zero at all of them (e.g., the "
+          "Hessian of costs with dead zones). Do not enable it for these "
+          "problems.")
+      .add_property("hessian_type",
+                    bp::make_function(&SolverIpopt::get_hessian_type),
+                    bp::make_function(&SolverIpopt::set_hessian_type),
+                    "type of Hessian of the Lagrangian (default FullHessian)")
       .def(CopyableVisitor<SolverIpopt>());
 }
 
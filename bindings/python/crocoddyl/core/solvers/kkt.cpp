@@ -85,11 +85,8 @@ void exposeSolverKKT() {
            "improvement model is described as dV = f_0 - f_+ = d1*a + "
            "d2*a**2/2.")
       .add_property(
-          "kkt",
-          make_function(
-              &SolverKKT::get_kkt,
-              bp::return_value_policy<bp::reference_existing_object>()),
-          "kkt")
+          "kkt", &SolverKKT::get_kkt,
+          "kkt matrix (dense copy of its sparse storage)")
       .add_property(
           "kktref",
           make_function(
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/executor.hpp"
+
+#include "python/crocoddyl/core/core.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+void exposeExecutor() {
+  bp::register_ptr_to_python<std::shared_ptr<ExecutorAbstract> >();
+
+  bp::class_<ExecutorAbstract, boost::noncopyable>(
+      "ExecutorAbstract",
+      "Abstract class for executing parallel loops.\n\n"
+      "An executor computes the nodes of a shooting problem in parallel.",
+      bp::no_init);
+
+  bp::register_ptr_to_python<std::shared_ptr<ExecutorOpenMP> >();
+
+  bp::class_<ExecutorOpenMP, bp::bases<ExecutorAbstract>, boost::noncopyable>(
+      "ExecutorOpenMP",
+      "OpenMP executor.\n\n"
+      "It runs the loops inside an OpenMP parallel region (default executor).",
+      bp::init<>(bp::args("self"), "Initialize the OpenMP executor."));
+
+  bp::register_ptr_to_python<std::shared_ptr<ExecutorWorkStealing> >();
+
+  bp::class_<ExecutorWorkStealing, bp::bases<ExecutorAbstract>,
+             boost::noncopyable>(
+      "ExecutorWorkStealing",
+      "Work-stealing executor.\n\n"
+      "It runs the loops on a persistent pool of threads, which steal chunks\n"
+      "of iterations from each other to balance their loads.",
+      bp::init<bp::optional<int, std::size_t> >(
+          bp::args("self", "nthreads", "nchunks"),
+          "Initialize the work-stealing executor.\n\n"
+          ":param nthreads: number of threads including the calling thread\n"
+          "(if nthreads < 1, then nthreads=CROCODDYL_WITH_NTHREADS, or the\n"
+          "number of hardware threads without multithreading support)\n"
+          ":param nchunks: number of chunks per thread (default 4)"))
+      .add_property("nthreads", &ExecutorWorkStealing::get_nthreads,
+                    "number of threads of the pool")
+      .add_property("nchunks", &ExecutorWorkStealing::get_nchunks,
+                    &ExecutorWorkStealing::set_nchunks,
+                    "number of chunks per thread");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
@@ -166,6 +166,13 @@ void exposeDifferentialActionContactFwdDynamics() {
           bp::make_function(
               &DifferentialActionModelContactFwdDynamics::set_damping_factor),
           "Damping factor for cholesky decomposition of JMinvJt")
+      .add_property(
+          "lazy_kinematics",
+          &DifferentialActionModelContactFwdDynamics::get_lazy_kinematics,
+          &DifferentialActionModelContactFwdDynamics::set_lazy_kinematics,
+          "true if calc computes only the kinematic terms needed by the "
+          "dynamics and residual values, and calcDiff the deferred ones "
+          "(default False)")
       .def(CopyableVisitor<DifferentialActionModelContactFwdDynamics>());
 
   bp::register_ptr_to_python<
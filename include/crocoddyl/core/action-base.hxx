@@ -106,7 +106,7 @@ template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar> >
 ActionModelAbstractTpl<Scalar>::createData() {
   return std::allocate_shared<ActionDataAbstract>(
-      Eigen::aligned_allocator<ActionDataAbstract>(), this);
+      DataAllocator<ActionDataAbstract>(), this);
 }
 
 template <typename Scalar>
@@ -228,7 +228,7 @@ void DifferentialActionModelLQRTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<DifferentialActionDataAbstractTpl<Scalar> >
 DifferentialActionModelLQRTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
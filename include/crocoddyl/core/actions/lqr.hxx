@@ -219,7 +219,7 @@ void ActionModelLQRTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar>>
 ActionModelLQRTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -112,7 +112,7 @@ void ActionModelUnicycleTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar> >
 ActionModelUnicycleTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -40,7 +40,7 @@ class ActivationModelAbstractTpl {
                         const Eigen::Ref<const VectorXs>& r) = 0;
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
     return std::allocate_shared<ActivationDataAbstract>(
-        Eigen::aligned_allocator<ActivationDataAbstract>(), this);
+        DataAllocator<ActivationDataAbstract>(), this);
   };
 
   std::size_t get_nr() const { return nr_; };
@@ -131,7 +131,7 @@ class ActivationModel2NormBarrierTpl
    * @return the activation data
    */
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
   };
 
   /**
@@ -150,7 +150,7 @@ class ActivationModelQuadraticBarrierTpl
   };
 
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
   };
 
   const ActivationBounds& get_bounds() const { return bounds_; };
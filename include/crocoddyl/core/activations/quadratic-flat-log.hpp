@@ -107,7 +107,7 @@ class ActivationModelQuadFlatLogTpl
    */
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     return data;
   };
 
@@ -60,7 +60,7 @@ class ActivationModelQuadTpl : public ActivationModelAbstractTpl<_Scalar> {
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
     std::shared_ptr<ActivationDataAbstract> data =
         std::allocate_shared<ActivationDataAbstract>(
-            Eigen::aligned_allocator<ActivationDataAbstract>(), this);
+            DataAllocator<ActivationDataAbstract>(), this);
     data->Arr.diagonal().setOnes();
     return data;
   };
@@ -114,7 +114,7 @@ class ActivationModelSmooth1NormTpl
    * @return the activation data
    */
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
   };
 
   /**
@@ -104,7 +104,7 @@ class ActivationModelSmooth2NormTpl
    */
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
     return std::allocate_shared<ActivationDataAbstract>(
-        Eigen::aligned_allocator<ActivationDataAbstract>(), this);
+        DataAllocator<ActivationDataAbstract>(), this);
   };
 
  protected:
@@ -77,7 +77,7 @@ class ActivationModelWeightedQuadraticBarrierTpl
   };
 
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
   };
 
   const ActivationBounds& get_bounds() const { return bounds_; };
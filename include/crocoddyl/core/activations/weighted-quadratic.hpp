@@ -70,7 +70,7 @@ class ActivationModelWeightedQuadTpl
 
   virtual std::shared_ptr<ActivationDataAbstract> createData() {
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     data->Arr.diagonal() = weights_;
 
 #ifndef NDEBUG
@@ -25,7 +25,7 @@ template <typename Scalar>
 std::shared_ptr<ActuationDataAbstractTpl<Scalar> >
 ActuationModelAbstractTpl<Scalar>::createData() {
   return std::allocate_shared<ActuationDataAbstract>(
-      Eigen::aligned_allocator<ActuationDataAbstract>(), this);
+      DataAllocator<ActuationDataAbstract>(), this);
 }
 
 template <typename Scalar>
@@ -73,7 +73,7 @@ class ActuationSquashingModelTpl : public ActuationModelAbstractTpl<_Scalar> {
   }
 
   std::shared_ptr<ActuationDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
   };
 
   const std::shared_ptr<SquashingModelAbstract>& get_squashing() const {
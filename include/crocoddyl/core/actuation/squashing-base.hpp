@@ -42,7 +42,7 @@ class SquashingModelAbstractTpl {
                         const Eigen::Ref<const VectorXs>& s) = 0;
   virtual std::shared_ptr<SquashingDataAbstract> createData() {
     return std::allocate_shared<SquashingDataAbstract>(
-        Eigen::aligned_allocator<SquashingDataAbstract>(), this);
+        DataAllocator<SquashingDataAbstract>(), this);
   }
 
   std::size_t get_ns() const { return ns_; };
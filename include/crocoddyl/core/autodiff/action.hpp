@@ -0,0 +1,283 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_AUTODIFF_ACTION_HPP_
+#define CROCODDYL_CORE_AUTODIFF_ACTION_HPP_
+
+#include <Eigen/Core>
+#include <unsupported/Eigen/AutoDiff>
+#include <vector>
+
+#include "crocoddyl/core/action-base.hpp"
+#include "crocoddyl/core/fwd.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief This class computes the derivatives of an action model via
+ * forward-mode automatic differentiation.
+ *
+ * It evaluates the action model instantiated with a dual-number scalar (i.e.,
+ * `Eigen::AutoDiffScalar`), whose derivative vector has one entry per
+ * direction of \f$(\delta\mathbf{x},\mathbf{u})\f$. Therefore, a single `calc`
+ * pass gives the exact Jacobians of the dynamics, cost, cost residual and
+ * constraints, in contrast to the \f$n_{dx}+n_u\f$ passes and truncation
+ * errors of `ActionModelNumDiffTpl`. The states are disturbed in the tangent
+ * space through the `integrate` and `diff` operators of the dual-number state,
+ * as done in the numerical differentiation.
+ *
+ * The Hessians of the cost are computed through the Gauss-Newton approximation
+ * (as in `ActionModelNumDiffTpl`), or by differentiating numerically the exact
+ * gradients, which needs one pass per direction and keeps roughly half of the
+ * digits.
+ *
+ * Note that the action model needs to be instantiated with `ADScalar`, as in
+ * `ActionModelCodeGenTpl`, and all its operations need to support this
+ * scalar.
+ *
+ * \sa `ActionModelNumDiffTpl`, `calcDiff()`
+ */
+template <typename _Scalar>
+class ActionModelAutoDiffTpl : public ActionModelAbstractTpl<_Scalar> {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef _Scalar Scalar;
+  typedef ActionDataAbstractTpl<Scalar> ActionDataAbstract;
+  typedef ActionModelAbstractTpl<Scalar> Base;
+  typedef ActionDataAutoDiffTpl<Scalar> Data;
+  typedef MathBaseTpl<Scalar> MathBase;
+  typedef typename MathBaseTpl<Scalar>::VectorXs VectorXs;
+  typedef typename MathBaseTpl<Scalar>::MatrixXs MatrixXs;
+
+  typedef Eigen::AutoDiffScalar<VectorXs> ADScalar;
+  typedef ActionModelAbstractTpl<ADScalar> ADBase;
+  typedef ActionDataAbstractTpl<ADScalar> ADActionDataAbstract;
+  typedef typename MathBaseTpl<ADScalar>::VectorXs ADVectorXs;
+
+  /**
+   * @brief Initialize the autodiff action model
+   *
+   * @param[in] admodel            Action model instantiated with `ADScalar`
+   * @param[in] model              Action model used to compute `calc()`
+   * @param[in] with_gauss_approx  True if we want to use the Gauss
+   * approximation for computing the Hessians
+   */
+  ActionModelAutoDiffTpl(std::shared_ptr<ADBase> admodel,
+                         std::shared_ptr<Base> model,
+                         const bool with_gauss_approx = false);
+  virtual ~ActionModelAutoDiffTpl();
+
+  /**
+   * @brief @copydoc Base::calc()
+   */
+  virtual void calc(const std::shared_ptr<ActionDataAbstract>& data,
+                    const Eigen::Ref<const VectorXs>& x,
+                    const Eigen::Ref<const VectorXs>& u);
+
+  /**
+   * @brief @copydoc Base::calc(const std::shared_ptr<ActionDataAbstract>&
+   * data, const Eigen::Ref<const VectorXs>& x)
+   */
+  virtual void calc(const std::shared_ptr<ActionDataAbstract>& data,
+                    const Eigen::Ref<const VectorXs>& x);
+
+  /**
+   * @brief @copydoc Base::calcDiff()
+   */
+  virtual void calcDiff(const std::shared_ptr<ActionDataAbstract>& data,
+                        const Eigen::Ref<const VectorXs>& x,
+                        const Eigen::Ref<const VectorXs>& u);
+
+  /**
+   * @brief @copydoc Base::calcDiff(const std::shared_ptr<ActionDataAbstract>&
+   * data, const Eigen::Ref<const VectorXs>& x)
+   */
+  virtual void calcDiff(const std::shared_ptr<ActionDataAbstract>& data,
+                        const Eigen::Ref<const VectorXs>& x);
+
+  /**
+   * @brief @copydoc Base::createData()
+   */
+  virtual std::shared_ptr<ActionDataAbstract> createData();
+
+  /**
+   * @brief @copydoc Base::quasiStatic()
+   */
+  virtual void quasiStatic(const std::shared_ptr<ActionDataAbstract>& data,
+                           Eigen::Ref<VectorXs> u,
+                           const Eigen::Ref<const VectorXs>& x,
+                           const std::size_t maxiter = 100,
+                           const Scalar tol = Scalar(1e-9));
+
+  /**
+   * @brief Return the action model used to compute `calc()`
+   */
+  const std::shared_ptr<Base>& get_model() const;
+
+  /**
+   * @brief Return the action model instantiated with `ADScalar`
+   */
+  const std::shared_ptr<ADBase>& get_admodel() const;
+
+  /**
+   * @brief Return the disturbance constant used to differentiate the gradients
+   */
+  const Scalar get_disturbance() const;
+
+  /**
+   * @brief Modify the disturbance constant used to differentiate the gradients
+   */
+  void set_disturbance(const Scalar disturbance);
+
+  /**
+   * @brief Identify if the Gauss approximation is going to be used or not.
+   */
+  bool get_with_gauss_approx();
+
+  /**
+   * @brief Print relevant information of the autodiff action model
+   *
+   * @param[out] os  Output stream object
+   */
+  virtual void print(std::ostream& os) const;
+
+ protected:
+  using Base::nu_;     //!< Control dimension
+  using Base::state_;  //!< Model of the state
+
+ private:
+  /**
+   * @brief Evaluate the dual-number model seeded with the state and control
+   * directions
+   */
+  void calcAD(Data* d, const Eigen::Ref<const VectorXs>& x,
+              const Eigen::Ref<const VectorXs>& u);
+
+  /**
+   * @brief Evaluate the terminal dual-number model seeded with the state
+   * directions
+   */
+  void calcAD(Data* d, const Eigen::Ref<const VectorXs>& x);
+
+  /**
+   * @brief Copy the derivatives of a dual-number vector into a Jacobian
+   */
+  static void getJacobian(const ADVectorXs& y, MatrixXs& J);
+
+  std::shared_ptr<ADBase> ad_model_;  //!< Action model instantiated with
+                                      //!< `ADScalar`
+  std::shared_ptr<Base> model_;       //!< Action model used to compute
+                                      //!< `calc()`
+  Scalar e_hess_;  //!< Constant used for computing disturbances in Hessian
+                   //!< calculation
+  bool with_gauss_approx_;  //!< True if we want to use the Gauss approximation
+                            //!< for computing the Hessians
+};
+
+template <typename _Scalar>
+struct ActionDataAutoDiffTpl : public ActionDataAbstractTpl<_Scalar> {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef _Scalar Scalar;
+  typedef MathBaseTpl<Scalar> MathBase;
+  typedef ActionDataAbstractTpl<Scalar> Base;
+  typedef typename MathBaseTpl<Scalar>::VectorXs VectorXs;
+  typedef typename MathBaseTpl<Scalar>::MatrixXs MatrixXs;
+  typedef Eigen::AutoDiffScalar<VectorXs> ADScalar;
+  typedef ActionDataAbstractTpl<ADScalar> ADActionDataAbstract;
+  typedef typename MathBaseTpl<ADScalar>::VectorXs ADVectorXs;
+
+  /**
+   * @brief Initialize the autodiff action data
+   *
+   * @tparam Model is the type of the `ActionModelAutoDiffTpl`.
+   * @param model is the object to compute the automatic differentiation from.
+   */
+  template <template <typename Scalar> class Model>
+  explicit ActionDataAutoDiffTpl(Model<Scalar>* const model)
+      : Base(model),
+        Rx(model->get_nr(), model->get_state()->get_ndx()),
+        Ru(model->get_nr(), model->get_nu()),
+        Jf(model->get_state()->get_ndx(),
+           model->get_state()->get_ndx() + model->get_nu()),
+        Jg(g.size(), model->get_state()->get_ndx() + model->get_nu()),
+        Jh(h.size(), model->get_state()->get_ndx() + model->get_nu()),
+        Jr(model->get_nr(), model->get_state()->get_ndx() + model->get_nu()),
+        grad(model->get_state()->get_ndx() + model->get_nu()),
+        dx(model->get_state()->get_ndx()),
+        xp(model->get_state()->get_nx()),
+        up(model->get_nu()),
+        ad_x0(model->get_state()->get_nx()),
+        ad_dx(model->get_state()->get_ndx()),
+        ad_x(model->get_state()->get_nx()),
+        ad_u(model->get_nu()),
+        ad_xnext(model->get_state()->get_nx()),
+        ad_dxnext(model->get_state()->get_ndx()) {
+    Rx.setZero();
+    Ru.setZero();
+    Jf.setZero();
+    Jg.setZero();
+    Jh.setZero();
+    Jr.setZero();
+    grad.setZero();
+    dx.setZero();
+    xp.setZero();
+    up.setZero();
+    data_0 = model->get_model()->createData();
+    ad_data = model->get_admodel()->createData();
+  }
+
+  using Base::cost;
+  using Base::Fu;
+  using Base::Fx;
+  using Base::g;
+  using Base::h;
+  using Base::Lu;
+  using Base::Luu;
+  using Base::Lx;
+  using Base::Lxu;
+  using Base::Lxx;
+  using Base::r;
+  using Base::xnext;
+
+  Scalar xh_hess;  //!< Disturbance value used for computing \f$
+                   //!< \ell_\mathbf{xx} \f$
+  Scalar uh_hess;  //!< Disturbance value used for computing \f$
+                   //!< \ell_\mathbf{uu} \f$
+  MatrixXs Rx;    //!< Cost residual jacobian: \f$ \frac{d r(x,u)}{dx} \f$
+  MatrixXs Ru;    //!< Cost residual jacobian: \f$ \frac{d r(x,u)}{du} \f$
+  MatrixXs Jf;    //!< Jacobian of the dynamics w.r.t. all the directions
+  MatrixXs Jg;    //!< Jacobian of the inequality constraints w.r.t. all the
+                  //!< directions
+  MatrixXs Jh;    //!< Jacobian of the equality constraints w.r.t. all the
+                  //!< directions
+  MatrixXs Jr;    //!< Jacobian of the cost residual w.r.t. all the directions
+  VectorXs grad;  //!< Gradient of the cost w.r.t. all the directions
+  VectorXs dx;    //!< State disturbance used for computing the Hessians
+  VectorXs xp;    //!< The integrated state from the disturbance
+  VectorXs up;    //!< The disturbed control
+  ADVectorXs ad_x0;      //!< State as a constant dual number
+  ADVectorXs ad_dx;      //!< Seeded state directions
+  ADVectorXs ad_x;       //!< Seeded state
+  ADVectorXs ad_u;       //!< Seeded control
+  ADVectorXs ad_xnext;   //!< Next state as a constant dual number
+  ADVectorXs ad_dxnext;  //!< Seeded next state in its tangent space
+  std::shared_ptr<Base> data_0;  //!< The data that contains the final results
+  std::shared_ptr<ADActionDataAbstract>
+      ad_data;  //!< The data of the dual-number action model
+};
+
+}  // namespace crocoddyl
+
+/* --- Details -------------------------------------------------------------- */
+/* --- Details -------------------------------------------------------------- */
+/* --- Details -------------------------------------------------------------- */
+#include "crocoddyl/core/autodiff/action.hxx"
+
+#endif  // CROCODDYL_CORE_AUTODIFF_ACTION_HPP_
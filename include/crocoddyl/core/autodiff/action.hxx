@@ -0,0 +1,300 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/autodiff/action.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
+
+namespace crocoddyl {
+
+template <typename Scalar>
+ActionModelAutoDiffTpl<Scalar>::ActionModelAutoDiffTpl(
+    std::shared_ptr<ADBase> admodel, std::shared_ptr<Base> model,
+    const bool with_gauss_approx)
+    : Base(model->get_state(), model->get_nu(), model->get_nr(),
+           model->get_ng(), model->get_nh(), model->get_ng_T(),
+           model->get_nh_T()),
+      ad_model_(admodel),
+      model_(model),
+      e_hess_(std::sqrt(2.0 * std::numeric_limits<Scalar>::epsilon())),
+      with_gauss_approx_(with_gauss_approx) {
+  if (admodel->get_state()->get_nx() != model->get_state()->get_nx() ||
+      admodel->get_state()->get_ndx() != model->get_state()->get_ndx() ||
+      admodel->get_nu() != model->get_nu() ||
+      admodel->get_nr() != model->get_nr() ||
+      admodel->get_ng() != model->get_ng() ||
+      admodel->get_nh() != model->get_nh() ||
+      admodel->get_ng_T() != model->get_ng_T() ||
+      admodel->get_nh_T() != model->get_nh_T()) {
+    throw_pretty("Invalid argument: "
+                 << "admodel and model should have the same dimensions");
+  }
+  this->set_u_lb(model_->get_u_lb());
+  this->set_u_ub(model_->get_u_ub());
+}
+
+template <typename Scalar>
+ActionModelAutoDiffTpl<Scalar>::~ActionModelAutoDiffTpl() {}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calc(
+    const std::shared_ptr<ActionDataAbstract>& data,
+    const Eigen::Ref<const VectorXs>& x, const Eigen::Ref<const VectorXs>& u) {
+  if (static_cast<std::size_t>(x.size()) != state_->get_nx()) {
+    throw_pretty(
+        "Invalid argument: " << "x has wrong dimension (it should be " +
+                                    std::to_string(state_->get_nx()) + ")");
+  }
+  if (static_cast<std::size_t>(u.size()) != nu_) {
+    throw_pretty(
+        "Invalid argument: " << "u has wrong dimension (it should be " +
+                                    std::to_string(nu_) + ")");
+  }
+  Data* d = static_cast<Data*>(data.get());
+  model_->calc(d->data_0, x, u);
+  data->xnext = d->data_0->xnext;
+  data->cost = d->data_0->cost;
+  d->r = d->data_0->r;
+  d->g = d->data_0->g;
+  d->h = d->data_0->h;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calc(
+    const std::shared_ptr<ActionDataAbstract>& data,
+    const Eigen::Ref<const VectorXs>& x) {
+  if (static_cast<std::size_t>(x.size()) != state_->get_nx()) {
+    throw_pretty(
+        "Invalid argument: " << "x has wrong dimension (it should be " +
+                                    std::to_string(state_->get_nx()) + ")");
+  }
+  Data* d = static_cast<Data*>(data.get());
+  model_->calc(d->data_0, x);
+  data->xnext = d->data_0->xnext;
+  data->cost = d->data_0->cost;
+  d->r = d->data_0->r;
+  d->g = d->data_0->g;
+  d->h = d->data_0->h;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calcDiff(
+    const std::shared_ptr<ActionDataAbstract>& data,
+    const Eigen::Ref<const VectorXs>& x, const Eigen::Ref<const VectorXs>& u) {
+  if (static_cast<std::size_t>(x.size()) != state_->get_nx()) {
+    throw_pretty(
+        "Invalid argument: " << "x has wrong dimension (it should be " +
+                                    std::to_string(state_->get_nx()) + ")");
+  }
+  if (static_cast<std::size_t>(u.size()) != nu_) {
+    throw_pretty(
+        "Invalid argument: " << "u has wrong dimension (it should be " +
+                                    std::to_string(nu_) + ")");
+  }
+  Data* d = static_cast<Data*>(data.get());
+  const std::size_t ndx = state_->get_ndx();
+
+  // Computing all the Jacobians in a single pass
+  calcAD(d, x, u);
+  data->Fx = d->Jf.leftCols(ndx);
+  data->Fu = d->Jf.rightCols(nu_);
+  data->Lx = d->grad.head(ndx);
+  data->Lu = d->grad.tail(nu_);
+  d->Rx = d->Jr.leftCols(ndx);
+  d->Ru = d->Jr.rightCols(nu_);
+  data->Gx = d->Jg.leftCols(ndx);
+  data->Gu = d->Jg.rightCols(nu_);
+  data->Hx = d->Jh.leftCols(ndx);
+  data->Hu = d->Jh.rightCols(nu_);
+
+  if (with_gauss_approx_) {
+    data->Lxx = d->Rx.transpose() * d->Rx;
+    data->Lxu = d->Rx.transpose() * d->Ru;
+    data->Luu = d->Ru.transpose() * d->Ru;
+    return;
+  }
+
+  // Computing the Hessians by differentiating the exact gradients
+  state_->diff(state_->zero(), x, d->dx);
+  d->xh_hess = e_hess_ * std::max(Scalar(1.), d->dx.norm());
+  d->dx.setZero();
+  for (std::size_t ix = 0; ix < ndx; ++ix) {
+    d->dx(ix) = d->xh_hess;
+    state_->integrate(x, d->dx, d->xp);
+    calcAD(d, d->xp, u);
+    data->Lxx.col(ix) = (d->grad.head(ndx) - data->Lx) / d->xh_hess;
+    data->Lxu.row(ix) = (d->grad.tail(nu_) - data->Lu).transpose() / d->xh_hess;
+    d->dx(ix) = 0.;
+  }
+  d->uh_hess = e_hess_ * std::max(Scalar(1.), u.norm());
+  for (std::size_t iu = 0; iu < nu_; ++iu) {
+    d->up = u;
+    d->up(iu) += d->uh_hess;
+    calcAD(d, x, d->up);
+    data->Luu.col(iu) = (d->grad.tail(nu_) - data->Lu) / d->uh_hess;
+  }
+  data->Lxx = Scalar(0.5) * (data->Lxx + data->Lxx.transpose()).eval();
+  data->Luu = Scalar(0.5) * (data->Luu + data->Luu.transpose()).eval();
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calcDiff(
+    const std::shared_ptr<ActionDataAbstract>& data,
+    const Eigen::Ref<const VectorXs>& x) {
+  if (static_cast<std::size_t>(x.size()) != state_->get_nx()) {
+    throw_pretty(
+        "Invalid argument: " << "x has wrong dimension (it should be " +
+                                    std::to_string(state_->get_nx()) + ")");
+  }
+  Data* d = static_cast<Data*>(data.get());
+  const std::size_t ndx = state_->get_ndx();
+
+  // Computing all the Jacobians in a single pass
+  calcAD(d, x);
+  data->Lx = d->grad.head(ndx);
+  d->Rx = d->Jr.leftCols(ndx);
+  data->Gx = d->Jg.leftCols(ndx);
+  data->Hx = d->Jh.leftCols(ndx);
+
+  if (with_gauss_approx_) {
+    data->Lxx = d->Rx.transpose() * d->Rx;
+    return;
+  }
+
+  // Computing the Hessian by differentiating the exact gradient
+  state_->diff(state_->zero(), x, d->dx);
+  d->xh_hess = e_hess_ * std::max(Scalar(1.), d->dx.norm());
+  d->dx.setZero();
+  for (std::size_t ix = 0; ix < ndx; ++ix) {
+    d->dx(ix) = d->xh_hess;
+    state_->integrate(x, d->dx, d->xp);
+    calcAD(d, d->xp);
+    data->Lxx.col(ix) = (d->grad.head(ndx) - data->Lx) / d->xh_hess;
+    d->dx(ix) = 0.;
+  }
+  data->Lxx = Scalar(0.5) * (data->Lxx + data->Lxx.transpose()).eval();
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calcAD(
+    Data* d, const Eigen::Ref<const VectorXs>& x,
+    const Eigen::Ref<const VectorXs>& u) {
+  const std::shared_ptr<StateAbstractTpl<ADScalar> >& ad_state =
+      ad_model_->get_state();
+  const Eigen::DenseIndex ndx =
+      static_cast<Eigen::DenseIndex>(state_->get_ndx());
+  const Eigen::DenseIndex nv = ndx + static_cast<Eigen::DenseIndex>(nu_);
+  // Seeding one direction per tangent state and control component
+  d->ad_x0 = x.template cast<ADScalar>();
+  for (Eigen::DenseIndex i = 0; i < ndx; ++i) {
+    d->ad_dx(i) = ADScalar(Scalar(0.), nv, i);
+  }
+  for (Eigen::DenseIndex i = 0; i < static_cast<Eigen::DenseIndex>(nu_); ++i) {
+    d->ad_u(i) = ADScalar(u(i), nv, ndx + i);
+  }
+  ad_state->integrate(d->ad_x0, d->ad_dx, d->ad_x);
+  ad_model_->calc(d->ad_data, d->ad_x, d->ad_u);
+  // Expressing the next state in its tangent space
+  for (Eigen::DenseIndex i = 0; i < d->ad_xnext.size(); ++i) {
+    d->ad_xnext(i) = ADScalar(d->ad_data->xnext(i).value());
+  }
+  ad_state->diff(d->ad_xnext, d->ad_data->xnext, d->ad_dxnext);
+  getJacobian(d->ad_dxnext, d->Jf);
+  getJacobian(d->ad_data->r, d->Jr);
+  getJacobian(d->ad_data->g, d->Jg);
+  getJacobian(d->ad_data->h, d->Jh);
+  const VectorXs& dcost = d->ad_data->cost.derivatives();
+  d->grad.setZero();
+  d->grad.head(dcost.size()) = dcost;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::calcAD(
+    Data* d, const Eigen::Ref<const VectorXs>& x) {
+  const Eigen::DenseIndex ndx =
+      static_cast<Eigen::DenseIndex>(state_->get_ndx());
+  const Eigen::DenseIndex nv = ndx + static_cast<Eigen::DenseIndex>(nu_);
+  // Seeding one direction per tangent state component. Note that we keep the
+  // control directions, since Eigen resizes the derivatives of the model
+  // constants to the ones of the seeded inputs
+  d->ad_x0 = x.template cast<ADScalar>();
+  for (Eigen::DenseIndex i = 0; i < ndx; ++i) {
+    d->ad_dx(i) = ADScalar(Scalar(0.), nv, i);
+  }
+  ad_model_->get_state()->integrate(d->ad_x0, d->ad_dx, d->ad_x);
+  ad_model_->calc(d->ad_data, d->ad_x);
+  getJacobian(d->ad_data->r, d->Jr);
+  getJacobian(d->ad_data->g, d->Jg);
+  getJacobian(d->ad_data->h, d->Jh);
+  const VectorXs& dcost = d->ad_data->cost.derivatives();
+  d->grad.setZero();
+  d->grad.head(dcost.size()) = dcost;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::getJacobian(const ADVectorXs& y,
+                                                 MatrixXs& J) {
+  // The outputs that do not depend on the inputs have no derivatives
+  J.setZero();
+  for (Eigen::DenseIndex i = 0; i < y.size(); ++i) {
+    const VectorXs& dy = y(i).derivatives();
+    J.row(i).head(dy.size()) = dy.transpose();
+  }
+}
+
+template <typename Scalar>
+std::shared_ptr<ActionDataAbstractTpl<Scalar> >
+ActionModelAutoDiffTpl<Scalar>::createData() {
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::quasiStatic(
+    const std::shared_ptr<ActionDataAbstract>& data, Eigen::Ref<VectorXs> u,
+    const Eigen::Ref<const VectorXs>& x, const std::size_t maxiter,
+    const Scalar tol) {
+  Data* d = static_cast<Data*>(data.get());
+  model_->quasiStatic(d->data_0, u, x, maxiter, tol);
+}
+
+template <typename Scalar>
+const std::shared_ptr<ActionModelAbstractTpl<Scalar> >&
+ActionModelAutoDiffTpl<Scalar>::get_model() const {
+  return model_;
+}
+
+template <typename Scalar>
+const std::shared_ptr<
+    ActionModelAbstractTpl<typename ActionModelAutoDiffTpl<Scalar>::ADScalar> >&
+ActionModelAutoDiffTpl<Scalar>::get_admodel() const {
+  return ad_model_;
+}
+
+template <typename Scalar>
+const Scalar ActionModelAutoDiffTpl<Scalar>::get_disturbance() const {
+  return e_hess_;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::set_disturbance(const Scalar disturbance) {
+  if (disturbance < 0.) {
+    throw_pretty("Invalid argument: " << "Disturbance constant is positive");
+  }
+  e_hess_ = disturbance;
+}
+
+template <typename Scalar>
+bool ActionModelAutoDiffTpl<Scalar>::get_with_gauss_approx() {
+  return with_gauss_approx_;
+}
+
+template <typename Scalar>
+void ActionModelAutoDiffTpl<Scalar>::print(std::ostream& os) const {
+  os << "ActionModelAutoDiffTpl {action=" << *model_ << "}";
+}
+
+}  // namespace crocoddyl
@@ -11,9 +11,16 @@
 #ifndef CROCODDYL_CORE_CODEGEN_ACTION_BASE_HPP_
 #define CROCODDYL_CORE_CODEGEN_ACTION_BASE_HPP_
 
+#include <cstdint>
 #include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
 
 #include "crocoddyl/core/action-base.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
 #include "pinocchio/codegen/cppadcg.hpp"
 
 namespace crocoddyl {
@@ -54,29 +61,51 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
                                            const Eigen::Ref<const ADVectorXs>&)>
                             fn_record_env = empty_record_env,
                         const std::string& function_name_calc = "calc",
-                        const std::string& function_name_calcDiff = "calcDiff")
-      : Base(model->get_state(), model->get_nu()),
+                        const std::string& function_name_calcDiff = "calcDiff",
+                        const std::string& cache_dir = "",
+                        const bool autoload = true)
+      : Base(model->get_state(), model->get_nu(), model->get_nr(),
+             model->get_ng(), model->get_nh()),
         model(model),
         ad_model(admodel),
         ad_data(ad_model->createData()),
         function_name_calc(function_name_calc),
         function_name_calcDiff(function_name_calcDiff),
         library_name(library_name),
+        cache_dir(cache_dir),
         n_env(n_env),
         fn_record_env(fn_record_env),
         ad_X(ad_model->get_state()->get_nx() + ad_model->get_nu() + n_env),
         ad_X2(ad_model->get_state()->get_nx() + ad_model->get_nu() + n_env),
-        ad_calcout(ad_model->get_state()->get_nx() + 1) {
-    const std::size_t ndx = ad_model->get_state()->get_ndx();
-    const std::size_t nu = ad_model->get_nu();
-    ad_calcDiffout.resize(2 * ndx * ndx + 2 * ndx * nu + nu * nu + ndx + nu);
+        ad_calcout(getCalcOutputDimension()),
+        ad_calcDiffout(getCalcDiffOutputDimension()) {
+    const std::size_t ng = model->get_ng();
+    g_lb_ = model->get_g_lb().head(ng);
+    g_ub_ = model->get_g_ub().head(ng);
+    if (model->get_ng_T() != 0 || model->get_nh_T() != 0) {
+      std::cerr << "Warning: the terminal constraints of " << library_name
+                << " are not code generated" << std::endl;
+    }
     initLib();
-    loadLib();
+    // The library can be compiled and loaded later, e.g., by CodeGenBuilder
+    if (autoload) {
+      loadLib();
+    }
   }
 
   static void empty_record_env(std::shared_ptr<ADBase>,
                                const Eigen::Ref<const ADVectorXs>&) {}
 
+  static void hashString(std::uint64_t& hash, const std::string& str) {
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      hash ^= static_cast<unsigned char>(str[i]);
+      hash *= 1099511628211ULL;
+    }
+    // Separate the consecutive strings
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+  }
+
   void recordCalc() {
     CppAD::Independent(ad_X);
     const std::size_t nx = ad_model->get_state()->get_nx();
@@ -93,8 +122,13 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
   }
 
   void collect_calcout() {
+    const std::size_t nx = ad_model->get_state()->get_nx();
+    const std::size_t ng = ad_model->get_ng();
+    const std::size_t nh = ad_model->get_nh();
     ad_calcout[0] = ad_data->cost;
-    ad_calcout.tail(ad_model->get_state()->get_nx()) = ad_data->xnext;
+    ad_calcout.segment(1, nx) = ad_data->xnext;
+    ad_calcout.segment(1 + nx, ng) = ad_data->g.head(ng);
+    ad_calcout.segment(1 + nx + ng, nh) = ad_data->h.head(nh);
   }
 
   void collect_calcDiffout() {
@@ -102,6 +136,8 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
 
     const std::size_t ndx = ad_model->get_state()->get_ndx();
     const std::size_t nu = ad_model->get_nu();
+    const std::size_t ng = ad_model->get_ng();
+    const std::size_t nh = ad_model->get_nh();
     Eigen::DenseIndex it_Y = 0;
     Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, ndx, ndx) = ad_data->Fx;
     it_Y += ndx * ndx;
@@ -116,6 +152,18 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
     Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, ndx, nu) = ad_data->Lxu;
     it_Y += ndx * nu;
     Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, nu, nu) = ad_data->Luu;
+    it_Y += nu * nu;
+    Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, ng, ndx) =
+        ad_data->Gx.topRows(ng);
+    it_Y += ng * ndx;
+    Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, ng, nu) =
+        ad_data->Gu.topRows(ng);
+    it_Y += ng * nu;
+    Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, nh, ndx) =
+        ad_data->Hx.topRows(nh);
+    it_Y += nh * ndx;
+    Eigen::Map<ADMatrixXs>(ad_Y.data() + it_Y, nh, nu) =
+        ad_data->Hu.topRows(nh);
   }
 
   void recordCalcDiff() {
@@ -129,7 +177,25 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
     ad_model->calcDiff(ad_data, ad_X2.head(nx), ad_X2.segment(nx, nu));
 
     collect_calcDiffout();
-    ad_calcDiff.Dependent(ad_X2, ad_calcDiffout);
+
+    // Only the outputs that depend on the inputs are generated, the constant
+    // ones (e.g., zero or identity blocks) are stored once in the datas
+    const Eigen::DenseIndex ny = ad_calcDiffout.size();
+    calcDiff_idx.clear();
+    calcDiff_constants = VectorXs::Zero(ny);
+    for (Eigen::DenseIndex i = 0; i < ny; ++i) {
+      const CGScalar y = CppAD::Value(CppAD::Var2Par(ad_calcDiffout[i]));
+      if (CppAD::Variable(ad_calcDiffout[i]) || !y.isParameter()) {
+        calcDiff_idx.push_back(i);
+      } else {
+        calcDiff_constants[i] = y.getValue();
+      }
+    }
+    ADVectorXs ad_calcDiffout_nz(calcDiff_idx.size());
+    for (std::size_t k = 0; k < calcDiff_idx.size(); ++k) {
+      ad_calcDiffout_nz[k] = ad_calcDiffout[calcDiff_idx[k]];
+    }
+    ad_calcDiff.Dependent(ad_X2, ad_calcDiffout_nz);
     ad_calcDiff.optimize("no_compare_op");
   }
 
@@ -154,24 +220,90 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
         new CppAD::cg::ModelLibraryCSourceGen<Scalar>(*calcgen_ptr,
                                                       *calcDiffgen_ptr));
 
+    // The cached libraries are named after the hash of their content, so a
+    // library is only compiled once and it is never stale. Note that the hash
+    // needs the generated sources, so a cache hit still pays the source
+    // generation; it only saves the compilation
+    std::string name = library_name;
+    if (!cache_dir.empty()) {
+      CppAD::cg::system::createFolder(cache_dir);
+      name = cache_dir + "/" + library_name + "_" + computeHash();
+    }
     dynamicLibManager_ptr =
         std::unique_ptr<CppAD::cg::DynamicModelLibraryProcessor<Scalar> >(
             new CppAD::cg::DynamicModelLibraryProcessor<Scalar>(*libcgen_ptr,
-                                                                library_name));
+                                                                name));
+  }
+
+  /// \brief Generate the sources of the library (they are generated once)
+  void generateSources() {
+    calcgen_ptr->getSources();
+    calcDiffgen_ptr->getSources();
   }
 
   void compileLib() {
+    CppAD::cg::GccCompiler<Scalar> compiler;
+    compiler.setCompileFlags(getCompileFlags());
+    // Each library uses its own folder, so they can be compiled concurrently
+    compiler.setTemporaryFolder(dynamicLibManager_ptr->getLibraryName() +
+                                "_tmp");
+    dynamicLibManager_ptr->createDynamicLibrary(compiler, false);
+  }
+
+  /// \brief Flags used for compiling the library
+  std::vector<std::string> getCompileFlags() const {
     CppAD::cg::GccCompiler<Scalar> compiler;
     std::vector<std::string> compile_options = compiler.getCompileFlags();
     compile_options[0] = "-O3";
-    compiler.setCompileFlags(compile_options);
-    dynamicLibManager_ptr->createDynamicLibrary(compiler, false);
+    return compile_options;
+  }
+
+  /**
+   * @brief Compute the hash of the library
+   *
+   * It hashes the generated sources (i.e., the recorded tapes), the dimensions
+   * of the model, the compiler and its flags with the 64-bit FNV-1a function.
+   * Note that the sources are generated for computing this hash, as CppAD does
+   * not expose the content of its tapes. In consequence, loading a cached
+   * library still pays the C source generation, and only the compilation is
+   * skipped.
+   */
+  std::string computeHash() {
+    std::uint64_t hash = 14695981039346656037ULL;
+    const std::map<std::string, std::string>& calc_sources =
+        calcgen_ptr->getSources();
+    const std::map<std::string, std::string>& calcDiff_sources =
+        calcDiffgen_ptr->getSources();
+    for (const auto& source : calc_sources) {
+      hashString(hash, source.first);
+      hashString(hash, source.second);
+    }
+    for (const auto& source : calcDiff_sources) {
+      hashString(hash, source.first);
+      hashString(hash, source.second);
+    }
+    std::ostringstream dims;
+    dims << ad_model->get_state()->get_nx() << " " << ad_model->get_nu() << " "
+         << n_env;
+    hashString(hash, dims.str());
+    CppAD::cg::GccCompiler<Scalar> compiler;
+    hashString(hash, compiler.getCompilerPath());
+    for (const std::string& flag : getCompileFlags()) {
+      hashString(hash, flag);
+    }
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+  }
+
+  /// \brief Path of the library
+  std::string getLibraryPath() const {
+    return dynamicLibManager_ptr->getLibraryName() +
+           CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
   }
 
   bool existLib() const {
-    const std::string filename =
-        dynamicLibManager_ptr->getLibraryName() +
-        CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION;
+    const std::string filename = getLibraryPath();
     std::ifstream file(filename.c_str());
     return file.good();
   }
@@ -230,13 +362,58 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
   }
 
   std::shared_ptr<ActionDataAbstract> createData() {
-    return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+    return std::allocate_shared<Data>(DataAllocator<Data>(), this);
+  }
+
+  /// \brief Create an instance of the generated calc function
+  ///
+  /// The instances have their own buffers, so each thread needs one of them.
+  std::unique_ptr<CppAD::cg::GenericModel<Scalar> > createCalcFunction() {
+    if (!dynamicLib_ptr) {
+      throw_pretty("Invalid argument: " << "the library is not loaded");
+    }
+    return dynamicLib_ptr->model(function_name_calc.c_str());
+  }
+
+  /// \brief Create an instance of the generated calcDiff function
+  std::unique_ptr<CppAD::cg::GenericModel<Scalar> > createCalcDiffFunction() {
+    if (!dynamicLib_ptr) {
+      throw_pretty("Invalid argument: " << "the library is not loaded");
+    }
+    return dynamicLib_ptr->model(function_name_calcDiff.c_str());
   }
 
   /// \brief Dimension of the input vector
   Eigen::DenseIndex getInputDimension() const { return ad_X.size(); }
 
+  /// \brief Indexes of the calcDiff outputs that depend on the inputs
+  const std::vector<Eigen::DenseIndex>& get_calcDiff_indexes() const {
+    return calcDiff_idx;
+  }
+
+  /// \brief Values of the calcDiff outputs that do not depend on the inputs
+  const VectorXs& get_calcDiff_constants() const { return calcDiff_constants; }
+
+  /// \brief Dimension of the output vector of calc (cost, next state and
+  /// constraints)
+  Eigen::DenseIndex getCalcOutputDimension() const {
+    return 1 + state_->get_nx() + this->get_ng() + this->get_nh();
+  }
+
+  /// \brief Dimension of the output vector of calcDiff (dynamics, cost and
+  /// constraint derivatives)
+  Eigen::DenseIndex getCalcDiffOutputDimension() const {
+    const std::size_t ndx = state_->get_ndx();
+    const std::size_t nu = nu_;
+    const std::size_t nc = this->get_ng() + this->get_nh();
+    return 2 * ndx * ndx + 2 * ndx * nu + nu * nu + ndx + nu + nc * (ndx + nu);
+  }
+
  protected:
+  using Base::g_lb_;                //!< Lower bound of the inequality
+                                    //!< constraints
+  using Base::g_ub_;                //!< Upper bound of the inequality
+                                    //!< constraints
   using Base::has_control_limits_;  //!< Indicates whether any of the control
                                     //!< limits
   using Base::nr_;                  //!< Dimension of the cost residual
@@ -255,6 +432,10 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
   /// \brief Name of the library
   const std::string library_name;
 
+  /// \brief Directory of the cached libraries (empty for no cache). A cache
+  /// hit skips the compilation, but not the source generation
+  const std::string cache_dir;
+
   /// \brief Size of the environment variables
   const std::size_t n_env;
 
@@ -273,6 +454,12 @@ class ActionModelCodeGenTpl : public ActionModelAbstractTpl<_Scalar> {
   ADVectorXs ad_calcout;
   ADVectorXs ad_calcDiffout;
 
+  /// \brief Indexes of the calcDiff outputs that depend on the inputs
+  std::vector<Eigen::DenseIndex> calcDiff_idx;
+
+  /// \brief Values of the calcDiff outputs that do not depend on the inputs
+  VectorXs calcDiff_constants;
+
   ADFun ad_calc, ad_calcDiff;
 
   std::unique_ptr<CppAD::cg::ModelCSourceGen<Scalar> > calcgen_ptr,
@@ -299,6 +486,12 @@ struct ActionDataCodeGenTpl : public ActionDataAbstractTpl<_Scalar> {
   using Base::cost;
   using Base::Fu;
   using Base::Fx;
+  using Base::g;
+  using Base::Gu;
+  using Base::Gx;
+  using Base::h;
+  using Base::Hu;
+  using Base::Hx;
   using Base::Lu;
   using Base::Luu;
   using Base::Lx;
@@ -310,44 +503,68 @@ struct ActionDataCodeGenTpl : public ActionDataAbstractTpl<_Scalar> {
   VectorXs xu, calcout;
 
   VectorXs calcDiffout;
+  std::vector<Eigen::DenseIndex>
+      calcDiff_idx;  //!< Indexes of the calcDiff outputs that depend on the
+                     //!< inputs
 
   void distribute_calcout() {
+    const Eigen::DenseIndex nx = xnext.size();
     cost = calcout[0];
-    xnext = calcout.tail(xnext.size());
+    xnext = calcout.segment(1, nx);
+    g = calcout.segment(1 + nx, g.size());
+    h = calcout.segment(1 + nx + g.size(), h.size());
   }
 
   void distribute_calcDiffout() {
-    VectorXs& Y = calcDiffout;
-    const std::size_t ndx = Fx.rows();
-    const std::size_t nu = Fu.cols();
+    scatter_calcDiffout(calcDiffout, calcDiff_idx);
+  }
 
-    Eigen::DenseIndex it_Y = 0;
-    Fx = Eigen::Map<MatrixXs>(Y.data() + it_Y, ndx, ndx);
-    it_Y += ndx * ndx;
-    Fu = Eigen::Map<MatrixXs>(Y.data() + it_Y, ndx, nu);
-    it_Y += ndx * nu;
-    Lx = Eigen::Map<VectorXs>(Y.data() + it_Y, ndx);
-    it_Y += ndx;
-    Lu = Eigen::Map<VectorXs>(Y.data() + it_Y, nu);
-    it_Y += nu;
-    Lxx = Eigen::Map<MatrixXs>(Y.data() + it_Y, ndx, ndx);
-    it_Y += ndx * ndx;
-    Lxu = Eigen::Map<MatrixXs>(Y.data() + it_Y, ndx, nu);
-    it_Y += ndx * nu;
-    Luu = Eigen::Map<MatrixXs>(Y.data() + it_Y, nu, nu);
+  /**
+   * @brief Scatter the calcDiff outputs into the derivatives
+   *
+   * The dense output vector stacks Fx, Fu, Lx, Lu, Lxx, Lxu, Luu, Gx, Gu, Hx
+   * and Hu (column-major). Only its entries listed in `indexes` are given in
+   * `Y`, and these indexes are sorted.
+   */
+  void scatter_calcDiffout(const VectorXs& Y,
+                           const std::vector<Eigen::DenseIndex>& indexes) {
+    Scalar* const blocks[] = {Fx.data(),  Fu.data(),  Lx.data(), Lu.data(),
+                              Lxx.data(), Lxu.data(), Luu.data(), Gx.data(),
+                              Gu.data(),  Hx.data(),  Hu.data()};
+    const Eigen::DenseIndex sizes[] = {Fx.size(),  Fu.size(),  Lx.size(),
+                                       Lu.size(),  Lxx.size(), Lxu.size(),
+                                       Luu.size(), Gx.size(),  Gu.size(),
+                                       Hx.size(),  Hu.size()};
+    const std::size_t nnz = indexes.size();
+    std::size_t k = 0;
+    Eigen::DenseIndex offset = 0;
+    for (std::size_t b = 0; b < 11; ++b) {
+      const Eigen::DenseIndex end = offset + sizes[b];
+      for (; k < nnz && indexes[k] < end; ++k) {
+        blocks[b][indexes[k] - offset] = Y[k];
+      }
+      offset = end;
+    }
   }
 
   template <template <typename Scalar> class Model>
-  explicit ActionDataCodeGenTpl(Model<Scalar>* const model)
-      : Base(model), calcout(model->get_state()->get_nx() + 1) {
+  explicit ActionDataCodeGenTpl(Model<Scalar>* const model) : Base(model) {
     ActionModelCodeGenTpl<Scalar>* m =
         static_cast<ActionModelCodeGenTpl<Scalar>*>(model);
     xu.resize(m->getInputDimension());
     xu.setZero();
+    calcout.resize(m->getCalcOutputDimension());
     calcout.setZero();
-    const std::size_t ndx = model->get_state()->get_ndx();
-    const std::size_t nu = model->get_nu();
-    calcDiffout.resize(2 * ndx * ndx + 2 * ndx * nu + nu * nu + ndx + nu);
+
+    // Set the constant derivatives once
+    const VectorXs& constants = m->get_calcDiff_constants();
+    std::vector<Eigen::DenseIndex> all(constants.size());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+      all[i] = static_cast<Eigen::DenseIndex>(i);
+    }
+    scatter_calcDiffout(constants, all);
+    calcDiff_idx = m->get_calcDiff_indexes();
+    calcDiffout.resize(calcDiff_idx.size());
     calcDiffout.setZero();
   }
 };
@@ -0,0 +1,138 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_CODEGEN_BUILDER_HPP_
+#define CROCODDYL_CORE_CODEGEN_BUILDER_HPP_
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "crocoddyl/core/codegen/action-base.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/executor.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Builder of code-generated action models
+ *
+ * It compiles the libraries of several code-generated action models in
+ * parallel, and then it loads them. This reduces the start-up time of problems
+ * with many node types, which otherwise compile each library sequentially in
+ * the constructor of `ActionModelCodeGen`. The models have to be created
+ * without loading their libraries, i.e., with `autoload` set to false.
+ *
+ * The sources are generated sequentially, as the recorded tapes are not
+ * thread-safe, and the compilations run with `njobs` threads. These threads
+ * belong to a work-stealing executor (see `ExecutorWorkStealing`), so they do
+ * not require to build Crocoddyl with the multithreading support.
+ *
+ * \sa `add()`, `build()`
+ */
+template <typename _Scalar>
+class CodeGenBuilderTpl {
+ public:
+  typedef _Scalar Scalar;
+  typedef ActionModelCodeGenTpl<Scalar> ActionModelCodeGen;
+
+  /**
+   * @brief Initialize the builder
+   *
+   * @param[in] njobs  Number of parallel compilations (default 1)
+   */
+  explicit CodeGenBuilderTpl(const std::size_t njobs = 1) : njobs_(njobs) {
+    if (njobs == 0) {
+      throw_pretty("Invalid argument: " << "njobs should be positive");
+    }
+  }
+
+  /**
+   * @brief Add a code-generated action model
+   *
+   * @param[in] model  Code-generated action model
+   */
+  void add(std::shared_ptr<ActionModelCodeGen> model) {
+    models_.push_back(model);
+  }
+
+  /**
+   * @brief Compile the missing libraries and load all of them
+   *
+   * The models that share a library path are compiled once.
+   */
+  void build() {
+    std::vector<std::shared_ptr<ActionModelCodeGen> > missing;
+    std::set<std::string> paths;
+    for (std::size_t i = 0; i < models_.size(); ++i) {
+      const std::shared_ptr<ActionModelCodeGen>& model = models_[i];
+      if (!model->existLib() && paths.insert(model->getLibraryPath()).second) {
+        model->generateSources();
+        missing.push_back(model);
+      }
+    }
+
+    const std::size_t nmissing = missing.size();
+    std::vector<std::string> errors(nmissing);
+    if (nmissing != 0) {
+      // Each library is a chunk, so the idle threads steal the remaining ones
+      const std::size_t nthreads = std::min(njobs_, nmissing);
+      ExecutorWorkStealing executor(static_cast<int>(nthreads), nmissing);
+      executor.parallelFor(nmissing, nthreads, [&](const std::size_t i) {
+        try {
+          missing[i]->compileLib();
+        } catch (const std::exception& e) {
+          errors[i] = e.what();
+        }
+      });
+    }
+    for (std::size_t i = 0; i < nmissing; ++i) {
+      if (!errors[i].empty()) {
+        throw_pretty("Failed to compile " << missing[i]->getLibraryPath()
+                                          << ": " << errors[i]);
+      }
+    }
+
+    for (std::size_t i = 0; i < models_.size(); ++i) {
+      models_[i]->loadLib(false);
+    }
+  }
+
+  /**
+   * @brief Return the code-generated action models
+   */
+  const std::vector<std::shared_ptr<ActionModelCodeGen> >& get_models() const {
+    return models_;
+  }
+
+  /**
+   * @brief Return the number of parallel compilations
+   */
+  std::size_t get_njobs() const { return njobs_; }
+
+  /**
+   * @brief Modify the number of parallel compilations
+   */
+  void set_njobs(const std::size_t njobs) {
+    if (njobs == 0) {
+      throw_pretty("Invalid argument: " << "njobs should be positive");
+    }
+    njobs_ = njobs;
+  }
+
+ private:
+  std::vector<std::shared_ptr<ActionModelCodeGen> >
+      models_;        //!< Code-generated action models
+  std::size_t njobs_;  //!< Number of parallel compilations
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_CODEGEN_BUILDER_HPP_
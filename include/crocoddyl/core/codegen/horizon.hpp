@@ -0,0 +1,316 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_CODEGEN_HORIZON_HPP_
+#define CROCODDYL_CORE_CODEGEN_HORIZON_HPP_
+
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif  // CROCODDYL_WITH_MULTITHREADING
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "crocoddyl/core/codegen/action-base.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Horizon-level evaluation of a code-generated action model
+ *
+ * It evaluates the generated functions of an `ActionModelCodeGen` over the
+ * `T` nodes of a horizon that share this model. The inputs and outputs of all
+ * the nodes are stored in contiguous column-major arrays, with one column per
+ * node. Thus, `calc()` and `calcDiff()` run the generated code directly on
+ * these arrays, and they avoid the action datas, the shared pointers and the
+ * copies of the inputs and outputs of a node-wise evaluation. Note that this
+ * is not a fused kernel: the generated functions are still called once per
+ * node (i.e., one virtual `ForwardZero()` call per node), and the nodes are
+ * not vectorized across each other.
+ *
+ * The `t`-th column of the inputs stacks \f$(\mathbf{x}_t,\mathbf{u}_t)\f$ and
+ * the environment variables. The `t`-th column of the calc outputs stacks the
+ * cost, the next state and the inequality and equality constraints, while the
+ * one of the calcDiff outputs stacks `Fx`, `Fu`, `Lx`, `Lu`, `Lxx`, `Lxu`,
+ * `Luu`, `Gx`, `Gu`, `Hx` and `Hu` (column-major). The nodes are distributed
+ * among `nthreads` threads, where each thread has its own instance of the
+ * generated functions. The threads are only used if Crocoddyl is built with
+ * the multithreading support.
+ *
+ * Note that this class is not called by `ShootingProblem` nor by the
+ * solvers. It is meant for callers that consume the column-major outputs
+ * directly (e.g., to evaluate many rollouts or to build a batched solver).
+ * Solvers that read the node datas need `distribute()`, which still touches
+ * each node but only copies its nonconstant derivatives.
+ *
+ * \sa `calc()`, `calcDiff()`, `distribute()`
+ */
+template <typename _Scalar>
+class HorizonCodeGenTpl {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef _Scalar Scalar;
+  typedef MathBaseTpl<Scalar> MathBase;
+  typedef ActionModelCodeGenTpl<Scalar> ActionModelCodeGen;
+  typedef ActionDataAbstractTpl<Scalar> ActionDataAbstract;
+  typedef ActionDataCodeGenTpl<Scalar> ActionDataCodeGen;
+  typedef CppAD::cg::GenericModel<Scalar> GenericModel;
+  typedef typename MathBase::VectorXs VectorXs;
+  typedef typename MathBase::MatrixXs MatrixXs;
+
+  /**
+   * @brief Initialize the horizon-level evaluation
+   *
+   * @param[in] model     Code-generated action model (with its library loaded)
+   * @param[in] T         Number of nodes
+   * @param[in] nthreads  Number of threads (default 1)
+   */
+  HorizonCodeGenTpl(std::shared_ptr<ActionModelCodeGen> model,
+                    const std::size_t T, const std::size_t nthreads = 1)
+      : model_(model),
+        T_(T),
+        nthreads_(nthreads),
+        XU_(MatrixXs::Zero(model->getInputDimension(), T)),
+        calcout_(MatrixXs::Zero(model->getCalcOutputDimension(), T)),
+        calcDiffout_(MatrixXs::Zero(model->getCalcDiffOutputDimension(), T)),
+        calcDiffnz_(MatrixXs::Zero(model->get_calcDiff_indexes().size(), T)) {
+    if (nthreads == 0) {
+      throw_pretty("Invalid argument: " << "nthreads should be positive");
+    }
+    // The constant derivatives are set once
+    calcDiffout_.colwise() = model->get_calcDiff_constants();
+    for (std::size_t i = 0; i < nthreads; ++i) {
+      calcFuns_.push_back(model->createCalcFunction());
+      calcDiffFuns_.push_back(model->createCalcDiffFunction());
+    }
+  }
+
+  /**
+   * @brief Compute the calc outputs of all the nodes from the stored inputs
+   */
+  void calc() {
+    const std::size_t nin = static_cast<std::size_t>(XU_.rows());
+    const std::size_t nout = static_cast<std::size_t>(calcout_.rows());
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_)
+#endif
+    for (std::size_t t = 0; t < T_; ++t) {
+      calcFuns_[getThreadId()]->ForwardZero(
+          CppAD::cg::ArrayView<const Scalar>(XU_.col(t).data(), nin),
+          CppAD::cg::ArrayView<Scalar>(calcout_.col(t).data(), nout));
+    }
+  }
+
+  /**
+   * @brief Compute the calc outputs of all the nodes
+   *
+   * @param[in] xs  States of the nodes \f$\mathbf{x}_t\f$
+   * @param[in] us  Controls of the nodes \f$\mathbf{u}_t\f$
+   */
+  void calc(const std::vector<VectorXs>& xs, const std::vector<VectorXs>& us) {
+    set_xus(xs, us);
+    calc();
+  }
+
+  /**
+   * @brief Compute the calcDiff outputs of all the nodes from the stored inputs
+   *
+   * Only the derivatives that depend on the inputs are computed, and they are
+   * written in the dense outputs afterwards.
+   */
+  void calcDiff() {
+    const std::vector<Eigen::DenseIndex>& idx = model_->get_calcDiff_indexes();
+    const std::size_t nin = static_cast<std::size_t>(XU_.rows());
+    const std::size_t nnz = idx.size();
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_)
+#endif
+    for (std::size_t t = 0; t < T_; ++t) {
+      calcDiffFuns_[getThreadId()]->ForwardZero(
+          CppAD::cg::ArrayView<const Scalar>(XU_.col(t).data(), nin),
+          CppAD::cg::ArrayView<Scalar>(calcDiffnz_.col(t).data(), nnz));
+      Scalar* const out = calcDiffout_.col(t).data();
+      const Scalar* const nz = calcDiffnz_.col(t).data();
+      for (std::size_t k = 0; k < nnz; ++k) {
+        out[idx[k]] = nz[k];
+      }
+    }
+  }
+
+  /**
+   * @brief Compute the calcDiff outputs of all the nodes
+   *
+   * @param[in] xs  States of the nodes \f$\mathbf{x}_t\f$
+   * @param[in] us  Controls of the nodes \f$\mathbf{u}_t\f$
+   */
+  void calcDiff(const std::vector<VectorXs>& xs,
+                const std::vector<VectorXs>& us) {
+    set_xus(xs, us);
+    calcDiff();
+  }
+
+  /**
+   * @brief Copy the outputs of a node into an action data
+   *
+   * This allows the solvers to use the outputs of the horizon. The calc
+   * outputs are distributed as in `ActionModelCodeGen::calc()`, and only the
+   * nonconstant derivatives are scattered with
+   * `ActionDataCodeGen::scatter_calcDiffout()`, as the constant ones are set
+   * when the data is created.
+   *
+   * @param[in] t     Node index
+   * @param[out] data Action data created by the code-generated model
+   */
+  void distribute(const std::size_t t,
+                  const std::shared_ptr<ActionDataAbstract>& data) const {
+    if (t >= T_) {
+      throw_pretty("Invalid argument: "
+                   << "t should be smaller than " + std::to_string(T_));
+    }
+    ActionDataCodeGen* const d = dynamic_cast<ActionDataCodeGen*>(data.get());
+    if (d == NULL) {
+      throw_pretty("Invalid argument: "
+                   << "data should be created by the code-generated model");
+    }
+    d->calcout = calcout_.col(t);
+    d->distribute_calcout();
+    d->calcDiffout = calcDiffnz_.col(t);
+    d->distribute_calcDiffout();
+  }
+
+  /**
+   * @brief Copy the outputs of all the nodes into their action datas
+   *
+   * For instance, it receives the running datas of a shooting problem whose
+   * running models are the code-generated model.
+   *
+   * @param[out] datas  Action datas created by the code-generated model
+   */
+  void distribute(
+      const std::vector<std::shared_ptr<ActionDataAbstract> >& datas) const {
+    if (datas.size() != T_) {
+      throw_pretty("Invalid argument: "
+                   << "datas has wrong dimension (it should be " +
+                          std::to_string(T_) + ")");
+    }
+    for (std::size_t t = 0; t < T_; ++t) {
+      distribute(t, datas[t]);
+    }
+  }
+
+  /**
+   * @brief Modify the states and controls of all the nodes
+   */
+  void set_xus(const std::vector<VectorXs>& xs,
+               const std::vector<VectorXs>& us) {
+    if (xs.size() != T_) {
+      throw_pretty("Invalid argument: "
+                   << "xs has wrong dimension (it should be " +
+                          std::to_string(T_) + ")");
+    }
+    if (us.size() != T_) {
+      throw_pretty("Invalid argument: "
+                   << "us has wrong dimension (it should be " +
+                          std::to_string(T_) + ")");
+    }
+    const Eigen::DenseIndex nx = model_->get_state()->get_nx();
+    const Eigen::DenseIndex nu = model_->get_nu();
+    for (std::size_t t = 0; t < T_; ++t) {
+      if (xs[t].size() != nx) {
+        throw_pretty("Invalid argument: "
+                     << "xs[" + std::to_string(t) +
+                            "] has wrong dimension (it should be " +
+                            std::to_string(nx) + ")");
+      }
+      if (us[t].size() != nu) {
+        throw_pretty("Invalid argument: "
+                     << "us[" + std::to_string(t) +
+                            "] has wrong dimension (it should be " +
+                            std::to_string(nu) + ")");
+      }
+    }
+    for (std::size_t t = 0; t < T_; ++t) {
+      XU_.col(t).head(nx) = xs[t];
+      XU_.col(t).segment(nx, nu) = us[t];
+    }
+  }
+
+  /**
+   * @brief Modify the environment variables of all the nodes
+   */
+  void set_env(const Eigen::Ref<const VectorXs>& env) {
+    const Eigen::DenseIndex nx = model_->get_state()->get_nx();
+    const Eigen::DenseIndex nu = model_->get_nu();
+    const Eigen::DenseIndex n_env = XU_.rows() - nx - nu;
+    if (env.size() != n_env) {
+      throw_pretty("Invalid argument: "
+                   << "env has wrong dimension (it should be " +
+                          std::to_string(n_env) + ")");
+    }
+    XU_.bottomRows(n_env).colwise() = env;
+  }
+
+  /**
+   * @brief Return the code-generated action model
+   */
+  const std::shared_ptr<ActionModelCodeGen>& get_model() const {
+    return model_;
+  }
+
+  /**
+   * @brief Return the number of nodes
+   */
+  std::size_t get_T() const { return T_; }
+
+  /**
+   * @brief Return the number of threads
+   */
+  std::size_t get_nthreads() const { return nthreads_; }
+
+  /**
+   * @brief Return the inputs of all the nodes (one column per node)
+   */
+  MatrixXs& get_XU() { return XU_; }
+
+  /**
+   * @brief Return the calc outputs of all the nodes (one column per node)
+   */
+  const MatrixXs& get_calcout() const { return calcout_; }
+
+  /**
+   * @brief Return the calcDiff outputs of all the nodes (one column per node)
+   */
+  const MatrixXs& get_calcDiffout() const { return calcDiffout_; }
+
+ private:
+  static std::size_t getThreadId() {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+    return static_cast<std::size_t>(omp_get_thread_num());
+#else
+    return 0;
+#endif
+  }
+
+  std::shared_ptr<ActionModelCodeGen> model_;  //!< Code-generated model
+  std::size_t T_;                              //!< Number of nodes
+  std::size_t nthreads_;                       //!< Number of threads
+  MatrixXs XU_;           //!< Inputs of the nodes
+  MatrixXs calcout_;      //!< calc outputs of the nodes
+  MatrixXs calcDiffout_;  //!< calcDiff outputs of the nodes
+  MatrixXs calcDiffnz_;   //!< Nonconstant calcDiff outputs of the nodes
+  std::vector<std::unique_ptr<GenericModel> >
+      calcFuns_;  //!< Generated calc functions (one per thread)
+  std::vector<std::unique_ptr<GenericModel> >
+      calcDiffFuns_;  //!< Generated calcDiff functions (one per thread)
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_CODEGEN_HORIZON_HPP_
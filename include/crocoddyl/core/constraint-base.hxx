@@ -106,7 +106,7 @@ std::shared_ptr<ConstraintDataAbstractTpl<Scalar> >
 ConstraintModelAbstractTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
   return std::allocate_shared<ConstraintDataAbstract>(
-      Eigen::aligned_allocator<ConstraintDataAbstract>(), this, data);
+      DataAllocator<ConstraintDataAbstract>(), this, data);
 }
 
 template <typename Scalar>
@@ -13,6 +13,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "crocoddyl/core/constraint-base.hpp"
 #include "crocoddyl/core/utils/exception.hpp"
@@ -84,6 +85,7 @@ class ConstraintModelManagerTpl {
       ConstraintModelContainer;
   typedef std::map<std::string, std::shared_ptr<ConstraintDataAbstract> >
       ConstraintDataContainer;
+  typedef std::vector<std::shared_ptr<ConstraintItem> > ConstraintItemVector;
 
   /**
    * @brief Initialize the constraint-manager model
@@ -205,6 +207,15 @@ class ConstraintModelManagerTpl {
    */
   const ConstraintModelContainer& get_constraints() const;
 
+  /**
+   * @brief Return the constraint items stored in a contiguous vector
+   *
+   * The items follow the order of the names in `get_constraints()`. This
+   * vector, and the vector of constraint datas in `ConstraintDataManagerTpl`,
+   * are used in `calc()` and `calcDiff()` to avoid traversing the maps.
+   */
+  const ConstraintItemVector& get_constraint_items() const;
+
   /**
    * @brief Return the dimension of the control input
    */
@@ -265,8 +276,12 @@ class ConstraintModelManagerTpl {
       std::ostream& os, const ConstraintModelManagerTpl<Scalar>& model);
 
  private:
+  void updateConstraintItems();
+
   std::shared_ptr<StateAbstract> state_;  //!< State description
   ConstraintModelContainer constraints_;  //!< Stack of constraint items
+  ConstraintItemVector
+      constraint_items_;  //!< Contiguous vector of constraint items
   VectorXs lb_;                           //!< Lower bound of the constraint
   VectorXs ub_;                           //!< Upper bound of the constraint
   std::size_t nu_;                        //!< Dimension of the control input
@@ -287,6 +302,7 @@ struct ConstraintDataManagerTpl {
   typedef MathBaseTpl<Scalar> MathBase;
   typedef DataCollectorAbstractTpl<Scalar> DataCollectorAbstract;
   typedef ConstraintItemTpl<Scalar> ConstraintItem;
+  typedef ConstraintDataAbstractTpl<Scalar> ConstraintDataAbstract;
   typedef typename MathBase::VectorXs VectorXs;
   typedef typename MathBase::MatrixXs MatrixXs;
 
@@ -312,13 +328,16 @@ struct ConstraintDataManagerTpl {
     h.setZero();
     Hx.setZero();
     Hu.setZero();
+    constraint_datas.reserve(model->get_constraints().size());
     for (typename ConstraintModelManagerTpl<
              Scalar>::ConstraintModelContainer::const_iterator it =
              model->get_constraints().begin();
          it != model->get_constraints().end(); ++it) {
       const std::shared_ptr<ConstraintItem>& item = it->second;
-      constraints.insert(
-          std::make_pair(item->name, item->constraint->createData(data)));
+      const std::shared_ptr<ConstraintDataAbstract> constraint_data =
+          item->constraint->createData(data);
+      constraints.insert(std::make_pair(item->name, constraint_data));
+      constraint_datas.push_back(constraint_data);
     }
   }
 
@@ -449,6 +468,9 @@ struct ConstraintDataManagerTpl {
 
   typename ConstraintModelManagerTpl<Scalar>::ConstraintDataContainer
       constraints;
+  std::vector<std::shared_ptr<ConstraintDataAbstract> >
+      constraint_datas;  //!< Constraint datas in the order of the model's
+                         //!< constraint items
   DataCollectorAbstract* shared;
   Eigen::Map<VectorXs> g;
   Eigen::Map<MatrixXs> Gx;
@@ -67,6 +67,7 @@ void ConstraintModelManagerTpl<Scalar>::addConstraint(
   } else if (!active) {
     inactive_set_.insert(name);
   }
+  updateConstraintItems();
 }
 
 template <typename Scalar>
@@ -84,6 +85,7 @@ void ConstraintModelManagerTpl<Scalar>::removeConstraint(
     inactive_set_.erase(name);
     lb_.resize(ng_);
     ub_.resize(ng_);
+    updateConstraintItems();
   } else {
     std::cout << "Warning: we couldn't remove the " << name
               << " constraint item, it doesn't exist." << std::endl;
@@ -140,7 +142,7 @@ void ConstraintModelManagerTpl<Scalar>::calc(
         "Invalid argument: " << "u has wrong dimension (it should be " +
                                     std::to_string(nu_) + ")");
   }
-  if (data->constraints.size() != constraints_.size()) {
+  if (data->constraint_datas.size() != constraint_items_.size()) {
     throw_pretty(
         "Invalid argument: "
         << "it doesn't match the number of constraint datas and models");
@@ -152,29 +154,27 @@ void ConstraintModelManagerTpl<Scalar>::calc(
   std::size_t ng_i = 0;
   std::size_t nh_i = 0;
 
-  typename ConstraintModelContainer::iterator it_m, end_m;
-  typename ConstraintDataContainer::iterator it_d, end_d;
-  for (it_m = constraints_.begin(), end_m = constraints_.end(),
-      it_d = data->constraints.begin(), end_d = data->constraints.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<ConstraintItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<ConstraintDataAbstract>& d_i = it_d->second;
-      assert_pretty(
-          it_m->first == it_d->first,
-          "it doesn't match the constraint name between model and data ("
-              << it_m->first << " != " << it_d->first << ")");
-
-      m_i->constraint->calc(d_i, x, u);
-      const std::size_t ng = m_i->constraint->get_ng();
-      const std::size_t nh = m_i->constraint->get_nh();
-      data->g.segment(ng_i, ng) = d_i->g;
-      data->h.segment(nh_i, nh) = d_i->h;
-      lb_.segment(ng_i, ng) = m_i->constraint->get_lb();
-      ub_.segment(ng_i, ng) = m_i->constraint->get_ub();
-      ng_i += ng;
-      nh_i += nh;
+  for (std::size_t i = 0; i < constraint_items_.size(); ++i) {
+    const std::shared_ptr<ConstraintItem>& m_i = constraint_items_[i];
+    if (!m_i->active) {
+      continue;
     }
+    const std::shared_ptr<ConstraintDataAbstract>& d_i =
+        data->constraint_datas[i];
+    assert_pretty(data->constraints.count(m_i->name) != 0 &&
+                      data->constraints.find(m_i->name)->second == d_i,
+                  "it doesn't match the constraint name between model and "
+                  "data ("
+                      << m_i->name << ")");
+    m_i->constraint->calc(d_i, x, u);
+    const std::size_t ng = m_i->constraint->get_ng();
+    const std::size_t nh = m_i->constraint->get_nh();
+    data->g.segment(ng_i, ng) = d_i->g;
+    data->h.segment(nh_i, nh) = d_i->h;
+    lb_.segment(ng_i, ng) = m_i->constraint->get_lb();
+    ub_.segment(ng_i, ng) = m_i->constraint->get_ub();
+    ng_i += ng;
+    nh_i += nh;
   }
 }
 
@@ -187,7 +187,7 @@ void ConstraintModelManagerTpl<Scalar>::calc(
         "Invalid argument: " << "x has wrong dimension (it should be " +
                                     std::to_string(state_->get_nx()) + ")");
   }
-  if (data->constraints.size() != constraints_.size()) {
+  if (data->constraint_datas.size() != constraint_items_.size()) {
     throw_pretty(
         "Invalid argument: "
         << "it doesn't match the number of constraint datas and models");
@@ -199,19 +199,19 @@ void ConstraintModelManagerTpl<Scalar>::calc(
   std::size_t ng_i = 0;
   std::size_t nh_i = 0;
 
-  typename ConstraintModelContainer::iterator it_m, end_m;
-  typename ConstraintDataContainer::iterator it_d, end_d;
-  for (it_m = constraints_.begin(), end_m = constraints_.end(),
-      it_d = data->constraints.begin(), end_d = data->constraints.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<ConstraintItem>& m_i = it_m->second;
-    if (m_i->active && m_i->constraint->get_T_constraint()) {
-      const std::shared_ptr<ConstraintDataAbstract>& d_i = it_d->second;
-      assert_pretty(
-          it_m->first == it_d->first,
-          "it doesn't match the constraint name between model and data ("
-              << it_m->first << " != " << it_d->first << ")");
-
+  for (std::size_t i = 0; i < constraint_items_.size(); ++i) {
+    const std::shared_ptr<ConstraintItem>& m_i = constraint_items_[i];
+    if (!m_i->active) {
+      continue;
+    }
+    if (m_i->constraint->get_T_constraint()) {
+      const std::shared_ptr<ConstraintDataAbstract>& d_i =
+          data->constraint_datas[i];
+      assert_pretty(data->constraints.count(m_i->name) != 0 &&
+                        data->constraints.find(m_i->name)->second == d_i,
+                    "it doesn't match the constraint name between model and "
+                    "data ("
+                        << m_i->name << ")");
       m_i->constraint->calc(d_i, x);
       const std::size_t ng = m_i->constraint->get_ng();
       const std::size_t nh = m_i->constraint->get_nh();
@@ -239,7 +239,7 @@ void ConstraintModelManagerTpl<Scalar>::calcDiff(
         "Invalid argument: " << "u has wrong dimension (it should be " +
                                     std::to_string(nu_) + ")");
   }
-  if (data->constraints.size() != constraints_.size()) {
+  if (data->constraint_datas.size() != constraint_items_.size()) {
     throw_pretty(
         "Invalid argument: "
         << "it doesn't match the number of constraint datas and models");
@@ -255,29 +255,27 @@ void ConstraintModelManagerTpl<Scalar>::calcDiff(
   std::size_t ng_i = 0;
   std::size_t nh_i = 0;
 
-  typename ConstraintModelContainer::iterator it_m, end_m;
-  typename ConstraintDataContainer::iterator it_d, end_d;
-  for (it_m = constraints_.begin(), end_m = constraints_.end(),
-      it_d = data->constraints.begin(), end_d = data->constraints.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<ConstraintItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<ConstraintDataAbstract>& d_i = it_d->second;
-      assert_pretty(
-          it_m->first == it_d->first,
-          "it doesn't match the constraint name between model and data ("
-              << it_m->first << " != " << it_d->first << ")");
-
-      m_i->constraint->calcDiff(d_i, x, u);
-      const std::size_t ng = m_i->constraint->get_ng();
-      const std::size_t nh = m_i->constraint->get_nh();
-      data->Gx.block(ng_i, 0, ng, ndx) = d_i->Gx;
-      data->Gu.block(ng_i, 0, ng, nu_) = d_i->Gu;
-      data->Hx.block(nh_i, 0, nh, ndx) = d_i->Hx;
-      data->Hu.block(nh_i, 0, nh, nu_) = d_i->Hu;
-      ng_i += ng;
-      nh_i += nh;
+  for (std::size_t i = 0; i < constraint_items_.size(); ++i) {
+    const std::shared_ptr<ConstraintItem>& m_i = constraint_items_[i];
+    if (!m_i->active) {
+      continue;
     }
+    const std::shared_ptr<ConstraintDataAbstract>& d_i =
+        data->constraint_datas[i];
+    assert_pretty(data->constraints.count(m_i->name) != 0 &&
+                      data->constraints.find(m_i->name)->second == d_i,
+                  "it doesn't match the constraint name between model and "
+                  "data ("
+                      << m_i->name << ")");
+    m_i->constraint->calcDiff(d_i, x, u);
+    const std::size_t ng = m_i->constraint->get_ng();
+    const std::size_t nh = m_i->constraint->get_nh();
+    data->Gx.block(ng_i, 0, ng, ndx) = d_i->Gx;
+    data->Gu.block(ng_i, 0, ng, nu_) = d_i->Gu;
+    data->Hx.block(nh_i, 0, nh, ndx) = d_i->Hx;
+    data->Hu.block(nh_i, 0, nh, nu_) = d_i->Hu;
+    ng_i += ng;
+    nh_i += nh;
   }
 }
 
@@ -290,7 +288,7 @@ void ConstraintModelManagerTpl<Scalar>::calcDiff(
         "Invalid argument: " << "x has wrong dimension (it should be " +
                                     std::to_string(state_->get_nx()) + ")");
   }
-  if (data->constraints.size() != constraints_.size()) {
+  if (data->constraint_datas.size() != constraint_items_.size()) {
     throw_pretty(
         "Invalid argument: "
         << "it doesn't match the number of constraint datas and models");
@@ -305,19 +303,19 @@ void ConstraintModelManagerTpl<Scalar>::calcDiff(
   std::size_t ng_i = 0;
   std::size_t nh_i = 0;
 
-  typename ConstraintModelContainer::iterator it_m, end_m;
-  typename ConstraintDataContainer::iterator it_d, end_d;
-  for (it_m = constraints_.begin(), end_m = constraints_.end(),
-      it_d = data->constraints.begin(), end_d = data->constraints.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<ConstraintItem>& m_i = it_m->second;
-    if (m_i->active && m_i->constraint->get_T_constraint()) {
-      const std::shared_ptr<ConstraintDataAbstract>& d_i = it_d->second;
-      assert_pretty(
-          it_m->first == it_d->first,
-          "it doesn't match the constraint name between model and data ("
-              << it_m->first << " != " << it_d->first << ")");
-
+  for (std::size_t i = 0; i < constraint_items_.size(); ++i) {
+    const std::shared_ptr<ConstraintItem>& m_i = constraint_items_[i];
+    if (!m_i->active) {
+      continue;
+    }
+    if (m_i->constraint->get_T_constraint()) {
+      const std::shared_ptr<ConstraintDataAbstract>& d_i =
+          data->constraint_datas[i];
+      assert_pretty(data->constraints.count(m_i->name) != 0 &&
+                        data->constraints.find(m_i->name)->second == d_i,
+                    "it doesn't match the constraint name between model and "
+                    "data ("
+                        << m_i->name << ")");
       m_i->constraint->calcDiff(d_i, x);
       const std::size_t ng = m_i->constraint->get_ng();
       const std::size_t nh = m_i->constraint->get_nh();
@@ -334,7 +332,7 @@ std::shared_ptr<ConstraintDataManagerTpl<Scalar> >
 ConstraintModelManagerTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
   return std::allocate_shared<ConstraintDataManager>(
-      Eigen::aligned_allocator<ConstraintDataManager>(), this, data);
+      DataAllocator<ConstraintDataManager>(), this, data);
 }
 
 template <typename Scalar>
@@ -349,6 +347,12 @@ ConstraintModelManagerTpl<Scalar>::get_constraints() const {
   return constraints_;
 }
 
+template <typename Scalar>
+const typename ConstraintModelManagerTpl<Scalar>::ConstraintItemVector&
+ConstraintModelManagerTpl<Scalar>::get_constraint_items() const {
+  return constraint_items_;
+}
+
 template <typename Scalar>
 std::size_t ConstraintModelManagerTpl<Scalar>::get_nu() const {
   return nu_;
@@ -412,6 +416,17 @@ bool ConstraintModelManagerTpl<Scalar>::getConstraintStatus(
   }
 }
 
+template <typename Scalar>
+void ConstraintModelManagerTpl<Scalar>::updateConstraintItems() {
+  constraint_items_.clear();
+  constraint_items_.reserve(constraints_.size());
+  for (typename ConstraintModelContainer::const_iterator it =
+           constraints_.begin();
+       it != constraints_.end(); ++it) {
+    constraint_items_.push_back(it->second);
+  }
+}
+
 template <typename Scalar>
 std::ostream& operator<<(std::ostream& os,
                          const ConstraintModelManagerTpl<Scalar>& model) {
@@ -107,8 +107,7 @@ template <typename Scalar>
 std::shared_ptr<ConstraintDataAbstractTpl<Scalar> >
 ConstraintModelResidualTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
@@ -24,7 +24,7 @@ template <typename Scalar>
 std::shared_ptr<ControlParametrizationDataAbstractTpl<Scalar> >
 ControlParametrizationModelAbstractTpl<Scalar>::createData() {
   return std::allocate_shared<ControlParametrizationDataAbstract>(
-      Eigen::aligned_allocator<ControlParametrizationDataAbstract>(), this);
+      DataAllocator<ControlParametrizationDataAbstract>(), this);
 }
 
 template <typename Scalar>
@@ -44,7 +44,7 @@ void ControlParametrizationModelPolyOneTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ControlParametrizationDataAbstractTpl<Scalar> >
 ControlParametrizationModelPolyOneTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
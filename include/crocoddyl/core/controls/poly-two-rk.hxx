@@ -70,7 +70,7 @@ void ControlParametrizationModelPolyTwoRKTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ControlParametrizationDataAbstractTpl<Scalar> >
 ControlParametrizationModelPolyTwoRKTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -48,7 +48,7 @@ template <typename Scalar>
 std::shared_ptr<ControlParametrizationDataAbstractTpl<Scalar> >
 ControlParametrizationModelPolyZeroTpl<Scalar>::createData() {
   std::shared_ptr<Data> data =
-      std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+      std::allocate_shared<Data>(DataAllocator<Data>(), this);
   data->dw_du.setIdentity();
   return data;
 }
@@ -98,7 +98,7 @@ template <typename Scalar>
 std::shared_ptr<CostDataAbstractTpl<Scalar> >
 CostModelAbstractTpl<Scalar>::createData(DataCollectorAbstract* const data) {
   return std::allocate_shared<CostDataAbstract>(
-      Eigen::aligned_allocator<CostDataAbstract>(), this, data);
+      DataAllocator<CostDataAbstract>(), this, data);
 }
 
 template <typename Scalar>
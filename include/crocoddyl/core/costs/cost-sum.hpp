@@ -14,6 +14,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "crocoddyl/core/cost-base.hpp"
 #include "crocoddyl/core/fwd.hpp"
@@ -82,10 +83,13 @@ class CostModelSumTpl {
   typedef CostDataAbstractTpl<Scalar> CostDataAbstract;
   typedef DataCollectorAbstractTpl<Scalar> DataCollectorAbstract;
   typedef CostItemTpl<Scalar> CostItem;
+  typedef ResidualModelAbstractTpl<Scalar> ResidualModelAbstract;
+  typedef typename ResidualModelAbstract::JacobianBlocks JacobianBlocks;
   typedef typename MathBase::VectorXs VectorXs;
   typedef typename MathBase::MatrixXs MatrixXs;
 
   typedef std::map<std::string, std::shared_ptr<CostItem> > CostModelContainer;
+  typedef std::vector<std::shared_ptr<CostItem> > CostItemVector;
   typedef std::map<std::string, std::shared_ptr<CostDataAbstract> >
       CostDataContainer;
 
@@ -206,6 +210,15 @@ class CostModelSumTpl {
    */
   const CostModelContainer& get_costs() const;
 
+  /**
+   * @brief Return the cost items stored in a contiguous vector
+   *
+   * The items follow the order of the names in `get_costs()`. This vector, and
+   * the vector of cost datas in `CostDataSumTpl`, are used in `calc()` and
+   * `calcDiff()` to avoid traversing the maps.
+   */
+  const CostItemVector& get_cost_items() const;
+
   /**
    * @brief Return the dimension of the control input
    */
@@ -269,8 +282,11 @@ class CostModelSumTpl {
                                   const CostModelSumTpl<Scalar>& model);
 
  private:
+  void updateCostItems();
+
   std::shared_ptr<StateAbstract> state_;  //!< State description
   CostModelContainer costs_;              //!< Stack of cost items
+  CostItemVector cost_items_;             //!< Contiguous vector of cost items
   std::size_t nu_;                        //!< Dimension of the control input
   std::size_t nr_;        //!< Dimension of the active residual vector
   std::size_t nr_total_;  //!< Dimension of the total residual vector
@@ -293,6 +309,7 @@ struct CostDataSumTpl {
   typedef MathBaseTpl<Scalar> MathBase;
   typedef DataCollectorAbstractTpl<Scalar> DataCollectorAbstract;
   typedef CostItemTpl<Scalar> CostItem;
+  typedef CostDataAbstractTpl<Scalar> CostDataAbstract;
   typedef typename MathBase::VectorXs VectorXs;
   typedef typename MathBase::MatrixXs MatrixXs;
 
@@ -318,11 +335,15 @@ struct CostDataSumTpl {
     Lxx.setZero();
     Lxu.setZero();
     Luu.setZero();
+    cost_datas.reserve(model->get_costs().size());
     for (typename CostModelSumTpl<Scalar>::CostModelContainer::const_iterator
              it = model->get_costs().begin();
          it != model->get_costs().end(); ++it) {
       const std::shared_ptr<CostItem>& item = it->second;
-      costs.insert(std::make_pair(item->name, item->cost->createData(data)));
+      const std::shared_ptr<CostDataAbstract> cost_data =
+          item->cost->createData(data);
+      costs.insert(std::make_pair(item->name, cost_data));
+      cost_datas.push_back(cost_data);
     }
   }
 
@@ -403,6 +424,8 @@ struct CostDataSumTpl {
   MatrixXs Luu_internal;
 
   typename CostModelSumTpl<Scalar>::CostDataContainer costs;
+  std::vector<std::shared_ptr<CostDataAbstract> >
+      cost_datas;  //!< Cost datas in the order of the model's cost items
   DataCollectorAbstract* shared;
   Scalar cost;
   Eigen::Map<VectorXs> Lx;
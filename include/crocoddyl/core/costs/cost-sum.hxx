@@ -49,6 +49,7 @@ void CostModelSumTpl<Scalar>::addCost(const std::string& name,
     nr_total_ += cost->get_activation()->get_nr();
     inactive_set_.insert(name);
   }
+  updateCostItems();
 }
 
 template <typename Scalar>
@@ -60,6 +61,7 @@ void CostModelSumTpl<Scalar>::removeCost(const std::string& name) {
     costs_.erase(it);
     active_set_.erase(name);
     inactive_set_.erase(name);
+    updateCostItems();
   } else {
     std::cerr << "Warning: we couldn't remove the " << name
               << " cost item, it doesn't exist." << std::endl;
@@ -102,27 +104,24 @@ void CostModelSumTpl<Scalar>::calc(const std::shared_ptr<CostDataSum>& data,
         "Invalid argument: " << "u has wrong dimension (it should be " +
                                     std::to_string(nu_) + ")");
   }
-  if (data->costs.size() != costs_.size()) {
+  if (data->cost_datas.size() != cost_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of cost datas and models");
   }
   data->cost = Scalar(0.);
 
-  typename CostModelContainer::iterator it_m, end_m;
-  typename CostDataContainer::iterator it_d, end_d;
-  for (it_m = costs_.begin(), end_m = costs_.end(), it_d = data->costs.begin(),
-      end_d = data->costs.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<CostItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<CostDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the cost name between model and data ("
-                        << it_m->first << " != " << it_d->first << ")");
-
-      m_i->cost->calc(d_i, x, u);
-      data->cost += m_i->weight * d_i->cost;
+  for (std::size_t i = 0; i < cost_items_.size(); ++i) {
+    const std::shared_ptr<CostItem>& m_i = cost_items_[i];
+    if (!m_i->active) {
+      continue;
     }
+    const std::shared_ptr<CostDataAbstract>& d_i = data->cost_datas[i];
+    assert_pretty(data->costs.count(m_i->name) != 0 &&
+                      data->costs.find(m_i->name)->second == d_i,
+                  "it doesn't match the cost name between model and data ("
+                      << m_i->name << ")");
+    m_i->cost->calc(d_i, x, u);
+    data->cost += m_i->weight * d_i->cost;
   }
 }
 
@@ -134,27 +133,24 @@ void CostModelSumTpl<Scalar>::calc(const std::shared_ptr<CostDataSum>& data,
         "Invalid argument: " << "x has wrong dimension (it should be " +
                                     std::to_string(state_->get_nx()) + ")");
   }
-  if (data->costs.size() != costs_.size()) {
+  if (data->cost_datas.size() != cost_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of cost datas and models");
   }
   data->cost = Scalar(0.);
 
-  typename CostModelContainer::iterator it_m, end_m;
-  typename CostDataContainer::iterator it_d, end_d;
-  for (it_m = costs_.begin(), end_m = costs_.end(), it_d = data->costs.begin(),
-      end_d = data->costs.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<CostItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<CostDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the cost name between model and data ("
-                        << it_m->first << " != " << it_d->first << ")");
-
-      m_i->cost->calc(d_i, x);
-      data->cost += m_i->weight * d_i->cost;
+  for (std::size_t i = 0; i < cost_items_.size(); ++i) {
+    const std::shared_ptr<CostItem>& m_i = cost_items_[i];
+    if (!m_i->active) {
+      continue;
     }
+    const std::shared_ptr<CostDataAbstract>& d_i = data->cost_datas[i];
+    assert_pretty(data->costs.count(m_i->name) != 0 &&
+                      data->costs.find(m_i->name)->second == d_i,
+                  "it doesn't match the cost name between model and data ("
+                      << m_i->name << ")");
+    m_i->cost->calc(d_i, x);
+    data->cost += m_i->weight * d_i->cost;
   }
 }
 
@@ -172,7 +168,7 @@ void CostModelSumTpl<Scalar>::calcDiff(const std::shared_ptr<CostDataSum>& data,
         "Invalid argument: " << "u has wrong dimension (it should be " +
                                     std::to_string(nu_) + ")");
   }
-  if (data->costs.size() != costs_.size()) {
+  if (data->cost_datas.size() != cost_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of cost datas and models");
   }
@@ -182,24 +178,38 @@ void CostModelSumTpl<Scalar>::calcDiff(const std::shared_ptr<CostDataSum>& data,
   data->Lxu.setZero();
   data->Luu.setZero();
 
-  typename CostModelContainer::iterator it_m, end_m;
-  typename CostDataContainer::iterator it_d, end_d;
-  for (it_m = costs_.begin(), end_m = costs_.end(), it_d = data->costs.begin(),
-      end_d = data->costs.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<CostItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<CostDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the cost name between model and data ("
-                        << it_m->first << " != " << it_d->first << ")");
-
-      m_i->cost->calcDiff(d_i, x, u);
-      data->Lx += m_i->weight * d_i->Lx;
-      data->Lu += m_i->weight * d_i->Lu;
-      data->Lxx += m_i->weight * d_i->Lxx;
-      data->Lxu += m_i->weight * d_i->Lxu;
-      data->Luu += m_i->weight * d_i->Luu;
+  for (std::size_t i = 0; i < cost_items_.size(); ++i) {
+    const std::shared_ptr<CostItem>& m_i = cost_items_[i];
+    if (!m_i->active) {
+      continue;
+    }
+    const std::shared_ptr<CostDataAbstract>& d_i = data->cost_datas[i];
+    assert_pretty(data->costs.count(m_i->name) != 0 &&
+                      data->costs.find(m_i->name)->second == d_i,
+                  "it doesn't match the cost name between model and data ("
+                      << m_i->name << ")");
+    m_i->cost->calcDiff(d_i, x, u);
+    // Accumulate only the blocks declared by the residual, as the others
+    // are structurally zero
+    const std::shared_ptr<ResidualModelAbstract>& r_i =
+        m_i->cost->get_residual();
+    const JacobianBlocks& blocks = r_i->get_Rx_blocks();
+    const bool is_ru = r_i->get_u_dependent() && nu_ != 0;
+    const Scalar w = m_i->weight;
+    for (std::size_t k = 0; k < blocks.size(); ++k) {
+      const std::size_t ik = blocks[k].first, nk = blocks[k].second;
+      data->Lx.segment(ik, nk) += w * d_i->Lx.segment(ik, nk);
+      for (std::size_t l = 0; l < blocks.size(); ++l) {
+        const std::size_t il = blocks[l].first, nl = blocks[l].second;
+        data->Lxx.block(ik, il, nk, nl) += w * d_i->Lxx.block(ik, il, nk, nl);
+      }
+      if (is_ru) {
+        data->Lxu.middleRows(ik, nk) += w * d_i->Lxu.middleRows(ik, nk);
+      }
+    }
+    if (is_ru) {
+      data->Lu += w * d_i->Lu;
+      data->Luu += w * d_i->Luu;
     }
   }
 }
@@ -212,28 +222,33 @@ void CostModelSumTpl<Scalar>::calcDiff(const std::shared_ptr<CostDataSum>& data,
         "Invalid argument: " << "x has wrong dimension (it should be " +
                                     std::to_string(state_->get_nx()) + ")");
   }
-  if (data->costs.size() != costs_.size()) {
+  if (data->cost_datas.size() != cost_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of cost datas and models");
   }
   data->Lx.setZero();
   data->Lxx.setZero();
 
-  typename CostModelContainer::iterator it_m, end_m;
-  typename CostDataContainer::iterator it_d, end_d;
-  for (it_m = costs_.begin(), end_m = costs_.end(), it_d = data->costs.begin(),
-      end_d = data->costs.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<CostItem>& m_i = it_m->second;
-    if (m_i->active) {
-      const std::shared_ptr<CostDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the cost name between model and data ("
-                        << it_m->first << " != " << it_d->first << ")");
-
-      m_i->cost->calcDiff(d_i, x);
-      data->Lx += m_i->weight * d_i->Lx;
-      data->Lxx += m_i->weight * d_i->Lxx;
+  for (std::size_t i = 0; i < cost_items_.size(); ++i) {
+    const std::shared_ptr<CostItem>& m_i = cost_items_[i];
+    if (!m_i->active) {
+      continue;
+    }
+    const std::shared_ptr<CostDataAbstract>& d_i = data->cost_datas[i];
+    assert_pretty(data->costs.count(m_i->name) != 0 &&
+                      data->costs.find(m_i->name)->second == d_i,
+                  "it doesn't match the cost name between model and data ("
+                      << m_i->name << ")");
+    m_i->cost->calcDiff(d_i, x);
+    const JacobianBlocks& blocks = m_i->cost->get_residual()->get_Rx_blocks();
+    const Scalar w = m_i->weight;
+    for (std::size_t k = 0; k < blocks.size(); ++k) {
+      const std::size_t ik = blocks[k].first, nk = blocks[k].second;
+      data->Lx.segment(ik, nk) += w * d_i->Lx.segment(ik, nk);
+      for (std::size_t l = 0; l < blocks.size(); ++l) {
+        const std::size_t il = blocks[l].first, nl = blocks[l].second;
+        data->Lxx.block(ik, il, nk, nl) += w * d_i->Lxx.block(ik, il, nk, nl);
+      }
     }
   }
 }
@@ -241,8 +256,8 @@ void CostModelSumTpl<Scalar>::calcDiff(const std::shared_ptr<CostDataSum>& data,
 template <typename Scalar>
 std::shared_ptr<CostDataSumTpl<Scalar> > CostModelSumTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
-  return std::allocate_shared<CostDataSum>(
-      Eigen::aligned_allocator<CostDataSum>(), this, data);
+  return std::allocate_shared<CostDataSum>(DataAllocator<CostDataSum>(), this,
+                                           data);
 }
 
 template <typename Scalar>
@@ -257,6 +272,12 @@ CostModelSumTpl<Scalar>::get_costs() const {
   return costs_;
 }
 
+template <typename Scalar>
+const typename CostModelSumTpl<Scalar>::CostItemVector&
+CostModelSumTpl<Scalar>::get_cost_items() const {
+  return cost_items_;
+}
+
 template <typename Scalar>
 std::size_t CostModelSumTpl<Scalar>::get_nu() const {
   return nu_;
@@ -294,6 +315,16 @@ bool CostModelSumTpl<Scalar>::getCostStatus(const std::string& name) const {
   }
 }
 
+template <typename Scalar>
+void CostModelSumTpl<Scalar>::updateCostItems() {
+  cost_items_.clear();
+  cost_items_.reserve(costs_.size());
+  for (typename CostModelContainer::const_iterator it = costs_.begin();
+       it != costs_.end(); ++it) {
+    cost_items_.push_back(it->second);
+  }
+}
+
 template <typename Scalar>
 std::ostream& operator<<(std::ostream& os,
                          const CostModelSumTpl<Scalar>& model) {
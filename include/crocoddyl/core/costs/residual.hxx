@@ -96,8 +96,7 @@ void CostModelResidualTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<CostDataAbstractTpl<Scalar> >
 CostModelResidualTpl<Scalar>::createData(DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
@@ -102,7 +102,7 @@ template <typename Scalar>
 std::shared_ptr<DifferentialActionDataAbstractTpl<Scalar> >
 DifferentialActionModelAbstractTpl<Scalar>::createData() {
   return std::allocate_shared<DifferentialActionDataAbstract>(
-      Eigen::aligned_allocator<DifferentialActionDataAbstract>(), this);
+      DataAllocator<DifferentialActionDataAbstract>(), this);
 }
 
 template <typename Scalar>
@@ -9,6 +9,7 @@
 #ifndef CROCODDYL_CORE_FWD_HPP_
 #define CROCODDYL_CORE_FWD_HPP_
 
+#include "crocoddyl/core/utils/arena.hpp"
 #include "crocoddyl/core/utils/deprecate.hpp"
 
 namespace crocoddyl {
@@ -286,12 +287,23 @@ class ActuationModelNumDiffTpl;
 template <typename Scalar>
 struct ActuationDataNumDiffTpl;
 
+template <typename Scalar>
+class ActionModelAutoDiffTpl;
+template <typename Scalar>
+struct ActionDataAutoDiffTpl;
+
 template <typename Scalar>
 class ActionModelCodeGenTpl;
 
 template <typename Scalar>
 struct ActionDataCodeGenTpl;
 
+template <typename Scalar>
+class CodeGenBuilderTpl;
+
+template <typename Scalar>
+class HorizonCodeGenTpl;
+
 /********************Template Instantiation*************/
 typedef ActionModelAbstractTpl<double> ActionModelAbstract;
 typedef ActionDataAbstractTpl<double> ActionDataAbstract;
@@ -428,9 +440,13 @@ typedef ConstraintDataNumDiffTpl<double> ConstraintDataNumDiff;
 typedef StateNumDiffTpl<double> StateNumDiff;
 typedef ActuationModelNumDiffTpl<double> ActuationModelNumDiff;
 typedef ActuationDataNumDiffTpl<double> ActuationDataNumDiff;
+typedef ActionModelAutoDiffTpl<double> ActionModelAutoDiff;
+typedef ActionDataAutoDiffTpl<double> ActionDataAutoDiff;
 
 typedef ActionModelCodeGenTpl<double> ActionModelCodeGen;
 typedef ActionDataCodeGenTpl<double> ActionDataCodeGen;
+typedef CodeGenBuilderTpl<double> CodeGenBuilder;
+typedef HorizonCodeGenTpl<double> HorizonCodeGen;
 
 }  // namespace crocoddyl
 
@@ -340,7 +340,7 @@ void IntegratedActionModelRKTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar> >
 IntegratedActionModelRKTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
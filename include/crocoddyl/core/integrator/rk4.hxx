@@ -314,7 +314,7 @@ void IntegratedActionModelRK4Tpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar> >
 IntegratedActionModelRK4Tpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -15,6 +15,7 @@
 
 #include "crocoddyl/core/action-base.hpp"
 #include "crocoddyl/core/fwd.hpp"
+#include "crocoddyl/core/utils/executor.hpp"
 
 namespace crocoddyl {
 
@@ -131,6 +132,42 @@ class ActionModelNumDiffTpl : public ActionModelAbstractTpl<_Scalar> {
    */
   bool get_with_gauss_approx();
 
+  /**
+   * @brief Return the number of threads used to compute the perturbations
+   */
+  std::size_t get_nthreads() const;
+
+  /**
+   * @brief Modify the number of threads used to compute the perturbations
+   *
+   * The perturbations of the states and controls are independent, and each
+   * of them has its own data. Thus, they are computed in parallel by the
+   * executor. By default, they are computed serially (i.e., one thread). The
+   * number of threads is resolved by the executor (see
+   * `ExecutorAbstract::getNumberOfThreads()`), so the executor needs to be
+   * set first. With the default OpenMP executor, values lower than one select
+   * `CROCODDYL_WITH_NTHREADS`; the work-stealing executor runs in parallel
+   * even without OpenMP support. Note that the wrapped model needs to support
+   * concurrent calls to `calc()` with different datas, as in the
+   * multithreaded shooting problem.
+   *
+   * @param[in] nthreads  number of threads
+   */
+  void set_nthreads(const int nthreads);
+
+  /**
+   * @brief Return the executor used to compute the perturbations in parallel
+   */
+  const std::shared_ptr<ExecutorAbstract>& get_executor() const;
+
+  /**
+   * @brief Modify the executor used to compute the perturbations in parallel
+   *
+   * The number of threads needs to be set after the executor (see
+   * `set_nthreads()`).
+   */
+  void set_executor(std::shared_ptr<ExecutorAbstract> executor);
+
   /**
    * @brief Print relevant information of the diff-action numdiff model
    *
@@ -169,6 +206,10 @@ class ActionModelNumDiffTpl : public ActionModelAbstractTpl<_Scalar> {
                    //!< calculation
   bool with_gauss_approx_;  //!< True if we want to use the Gauss approximation
                             //!< for computing the Hessians
+  std::size_t nthreads_;    //!< Number of threads used to compute the
+                            //!< perturbations
+  std::shared_ptr<ExecutorAbstract>
+      executor_;  //!< Executor used to compute the perturbations in parallel
 };
 
 template <typename _Scalar>
@@ -202,14 +243,20 @@ struct ActionDataNumDiffTpl : public ActionDataAbstractTpl<_Scalar> {
     du.setZero();
     xp.setZero();
 
+    const std::size_t nx = model->get_model()->get_state()->get_nx();
     const std::size_t ndx = model->get_model()->get_state()->get_ndx();
     const std::size_t nu = model->get_model()->get_nu();
     data_0 = model->get_model()->createData();
     for (std::size_t i = 0; i < ndx; ++i) {
       data_x.push_back(model->get_model()->createData());
+      dx_x.push_back(VectorXs::Zero(ndx));
+      xp_x.push_back(VectorXs::Zero(nx));
+      up_x.push_back(VectorXs::Zero(nu));
+      costs_x.push_back(static_cast<double>(ndx - i));
     }
     for (std::size_t i = 0; i < nu; ++i) {
       data_u.push_back(model->get_model()->createData());
+      up_u.push_back(VectorXs::Zero(nu));
     }
   }
 
@@ -247,6 +294,16 @@ struct ActionDataNumDiffTpl : public ActionDataAbstractTpl<_Scalar> {
       data_x;  //!< The temporary data associated with the state variation
   std::vector<std::shared_ptr<Base> >
       data_u;  //!< The temporary data associated with the control variation
+  std::vector<VectorXs>
+      dx_x;  //!< State disturbance associated with each state variation
+  std::vector<VectorXs>
+      xp_x;  //!< Integrated state associated with each state variation
+  std::vector<VectorXs>
+      up_x;  //!< Disturbed control associated with each state variation
+  std::vector<VectorXs>
+      up_u;  //!< Disturbed control associated with each control variation
+  std::vector<double> costs_x;  //!< Number of evaluations of the Hessian
+                                //!< associated with each state variation
 };
 
 }  // namespace crocoddyl
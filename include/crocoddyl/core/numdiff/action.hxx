@@ -21,7 +21,9 @@ ActionModelNumDiffTpl<Scalar>::ActionModelNumDiffTpl(
            model->get_nh_T()),
       model_(model),
       e_jac_(std::sqrt(2.0 * std::numeric_limits<Scalar>::epsilon())),
-      with_gauss_approx_(with_gauss_approx) {
+      with_gauss_approx_(with_gauss_approx),
+      nthreads_(1),
+      executor_(std::make_shared<ExecutorOpenMP>()) {
   e_hess_ = std::sqrt(2.0 * e_jac_);
   this->set_u_lb(model_->get_u_lb());
   this->set_u_ub(model_->get_u_ub());
@@ -103,132 +105,158 @@ void ActionModelNumDiffTpl<Scalar>::calcDiff(
 
   assertStableStateFD(x);
 
-  // Computing the d action(x,u) / dx
+  // Computing the d action(x,u) / dx. The perturbations are independent, and
+  // each of them has its own data and buffers, so they run in parallel
   model_->get_state()->diff(model_->get_state()->zero(), x, d->dx);
   d->x_norm = d->dx.norm();
   d->dx.setZero();
   d->xh_jac = e_jac_ * std::max(1., d->x_norm);
-  for (std::size_t ix = 0; ix < state_->get_ndx(); ++ix) {
-    d->dx(ix) = d->xh_jac;
-    model_->get_state()->integrate(x, d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp, u);
+  executor_->parallelFor(ndx, nthreads_, [&](const std::size_t ix) {
+    const std::shared_ptr<ActionDataAbstract>& data_x = d->data_x[ix];
+    VectorXs& dx = d->dx_x[ix];
+    VectorXs& xp = d->xp_x[ix];
+    dx(ix) = d->xh_jac;
+    model_->get_state()->integrate(x, dx, xp);
+    model_->calc(data_x, xp, u);
     // dynamics
-    model_->get_state()->diff(x0, d->data_x[ix]->xnext, d->Fx.col(ix));
+    model_->get_state()->diff(x0, data_x->xnext, d->Fx.col(ix));
     // cost
-    data->Lx(ix) = (d->data_x[ix]->cost - c0) / d->xh_jac;
-    if (get_with_gauss_approx()) {
-      d->Rx.col(ix) = (d->data_x[ix]->r - d->data_0->r) / d->xh_jac;
+    data->Lx(ix) = (data_x->cost - c0) / d->xh_jac;
+    if (with_gauss_approx_) {
+      d->Rx.col(ix) = (data_x->r - d->data_0->r) / d->xh_jac;
     }
     // constraint
-    data->Gx.col(ix) = (d->data_x[ix]->g - g0) / d->xh_jac;
-    data->Hx.col(ix) = (d->data_x[ix]->h - h0) / d->xh_jac;
-    d->dx(ix) = 0.;
-  }
+    data->Gx.col(ix) = (data_x->g - g0) / d->xh_jac;
+    data->Hx.col(ix) = (data_x->h - h0) / d->xh_jac;
+    dx(ix) = 0.;
+  });
   data->Fx /= d->xh_jac;
 
   // Computing the d action(x,u) / du
   d->uh_jac = e_jac_ * std::max(1., u.norm());
-  for (unsigned iu = 0; iu < model_->get_nu(); ++iu) {
-    d->du(iu) = d->uh_jac;
-    model_->calc(d->data_u[iu], x, u + d->du);
+  executor_->parallelFor(nu, nthreads_, [&](const std::size_t iu) {
+    const std::shared_ptr<ActionDataAbstract>& data_u = d->data_u[iu];
+    VectorXs& up = d->up_u[iu];
+    up = u;
+    up(iu) += d->uh_jac;
+    model_->calc(data_u, x, up);
     // dynamics
-    model_->get_state()->diff(x0, d->data_u[iu]->xnext, d->Fu.col(iu));
+    model_->get_state()->diff(x0, data_u->xnext, d->Fu.col(iu));
     // cost
-    data->Lu(iu) = (d->data_u[iu]->cost - c0) / d->uh_jac;
-    if (get_with_gauss_approx()) {
-      d->Ru.col(iu) = (d->data_u[iu]->r - d->data_0->r) / d->uh_jac;
+    data->Lu(iu) = (data_u->cost - c0) / d->uh_jac;
+    if (with_gauss_approx_) {
+      d->Ru.col(iu) = (data_u->r - d->data_0->r) / d->uh_jac;
     }
     // constraint
-    d->Gu.col(iu) = (d->data_u[iu]->g - g0) / d->uh_jac;
-    d->Hu.col(iu) = (d->data_u[iu]->h - h0) / d->uh_jac;
-    d->du(iu) = 0.0;
-  }
+    d->Gu.col(iu) = (data_u->g - g0) / d->uh_jac;
+    d->Hu.col(iu) = (data_u->h - h0) / d->uh_jac;
+  });
   data->Fu /= d->uh_jac;
 
 #ifdef NDEBUG
   // Computing the d^2 cost(x,u) / dx^2
   d->xh_hess = e_hess_ * std::max(1., d->x_norm);
   d->xh_hess_pow2 = d->xh_hess * d->xh_hess;
-  for (std::size_t ix = 0; ix < ndx; ++ix) {
-    d->dx(ix) = d->xh_hess;
-    model_->get_state()->integrate(x, d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp, u);
-    const Scalar cp = d->data_x[ix]->cost;
-    model_->get_state()->integrate(x, -d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp, u);
-    const Scalar cm = d->data_x[ix]->cost;
-    data->Lxx(ix, ix) = (cp - 2 * c0 + cm) / d->xh_hess_pow2;
-    for (std::size_t jx = ix + 1; jx < ndx; ++jx) {
-      d->dx(jx) = d->xh_hess;
-      model_->get_state()->integrate(x, d->dx, d->xp);
-      model_->calc(d->data_x[ix], d->xp, u);
-      const Scalar cpp =
-          d->data_x[ix]
-              ->cost;  // cost due to positive disturbance in both directions
-      d->dx(ix) = 0.;
-      model_->get_state()->integrate(x, d->dx, d->xp);
-      model_->calc(d->data_x[ix], d->xp, u);
-      const Scalar czp =
-          d->data_x[ix]->cost;  // cost due to zero disturance in 'i' and
-                                // positive disturbance in 'j' direction
-      data->Lxx(ix, jx) = (cpp - czp - cp + c0) / d->xh_hess_pow2;
-      data->Lxx(jx, ix) = data->Lxx(ix, jx);
-      d->dx(ix) = d->xh_hess;
-      d->dx(jx) = 0.;
-    }
-    d->dx(ix) = 0.;
-  }
+  // The perturbations of the first states need more evaluations
+  executor_->parallelFor(
+      ndx, nthreads_,
+      [&](const std::size_t ix) {
+        const std::shared_ptr<ActionDataAbstract>& data_x = d->data_x[ix];
+        VectorXs& dx = d->dx_x[ix];
+        VectorXs& xp = d->xp_x[ix];
+        dx(ix) = d->xh_hess;
+        model_->get_state()->integrate(x, dx, xp);
+        model_->calc(data_x, xp, u);
+        const Scalar cp = data_x->cost;
+        dx(ix) = -d->xh_hess;
+        model_->get_state()->integrate(x, dx, xp);
+        model_->calc(data_x, xp, u);
+        const Scalar cm = data_x->cost;
+        data->Lxx(ix, ix) = (cp - 2 * c0 + cm) / d->xh_hess_pow2;
+        dx(ix) = d->xh_hess;
+        for (std::size_t jx = ix + 1; jx < ndx; ++jx) {
+          dx(jx) = d->xh_hess;
+          model_->get_state()->integrate(x, dx, xp);
+          model_->calc(data_x, xp, u);
+          const Scalar cpp =
+              data_x->cost;  // cost due to positive disturbance in both
+                             // directions
+          dx(ix) = 0.;
+          model_->get_state()->integrate(x, dx, xp);
+          model_->calc(data_x, xp, u);
+          const Scalar czp =
+              data_x->cost;  // cost due to zero disturance in 'i' and
+                             // positive disturbance in 'j' direction
+          data->Lxx(ix, jx) = (cpp - czp - cp + c0) / d->xh_hess_pow2;
+          data->Lxx(jx, ix) = data->Lxx(ix, jx);
+          dx(ix) = d->xh_hess;
+          dx(jx) = 0.;
+        }
+        dx(ix) = 0.;
+      },
+      d->costs_x);
 
   // Computing the d^2 cost(x,u) / du^2
   d->uh_hess = e_hess_ * std::max(1., u.norm());
   d->uh_hess_pow2 = d->uh_hess * d->uh_hess;
-  for (std::size_t iu = 0; iu < nu; ++iu) {
-    d->du(iu) = d->uh_hess;
-    model_->calc(d->data_u[iu], x, u + d->du);
-    const Scalar cp = d->data_u[iu]->cost;
-    model_->calc(d->data_u[iu], x, u - d->du);
-    const Scalar cm = d->data_u[iu]->cost;
+  executor_->parallelFor(nu, nthreads_, [&](const std::size_t iu) {
+    const std::shared_ptr<ActionDataAbstract>& data_u = d->data_u[iu];
+    VectorXs& up = d->up_u[iu];
+    up = u;
+    up(iu) = u(iu) + d->uh_hess;
+    model_->calc(data_u, x, up);
+    const Scalar cp = data_u->cost;
+    up(iu) = u(iu) - d->uh_hess;
+    model_->calc(data_u, x, up);
+    const Scalar cm = data_u->cost;
     data->Luu(iu, iu) = (cp - 2 * c0 + cm) / d->uh_hess_pow2;
     for (std::size_t ju = iu + 1; ju < nu; ++ju) {
-      d->du(ju) = d->uh_hess;
-      model_->calc(d->data_u[iu], x, u + d->du);
+      up(iu) = u(iu) + d->uh_hess;
+      up(ju) = u(ju) + d->uh_hess;
+      model_->calc(data_u, x, up);
       const Scalar cpp =
-          d->data_u[iu]
-              ->cost;  // cost due to positive disturbance in both directions
-      d->du(iu) = 0.;
-      model_->calc(d->data_u[iu], x, u + d->du);
+          data_u->cost;  // cost due to positive disturbance in both directions
+      up(iu) = u(iu);
+      model_->calc(data_u, x, up);
       const Scalar czp =
-          d->data_u[iu]->cost;  // cost due to zero disturance in 'i' and
-                                // positive disturbance in 'j' direction
+          data_u->cost;  // cost due to zero disturance in 'i' and
+                         // positive disturbance in 'j' direction
       data->Luu(iu, ju) = (cpp - czp - cp + c0) / d->uh_hess_pow2;
       data->Luu(ju, iu) = data->Luu(iu, ju);
-      d->du(iu) = d->uh_hess;
-      d->du(ju) = 0.;
+      up(ju) = u(ju);
     }
-    d->du(iu) = 0.;
-  }
+  });
 
   // Computing the d^2 cost(x,u) / dxu
   d->xuh_hess_pow2 = 4. * d->xh_hess * d->uh_hess;
-  for (std::size_t ix = 0; ix < ndx; ++ix) {
+  executor_->parallelFor(ndx, nthreads_, [&](const std::size_t ix) {
+    const std::shared_ptr<ActionDataAbstract>& data_x = d->data_x[ix];
+    VectorXs& dx = d->dx_x[ix];
+    VectorXs& xp = d->xp_x[ix];
+    VectorXs& up = d->up_x[ix];
+    up = u;
     for (std::size_t ju = 0; ju < nu; ++ju) {
-      d->dx(ix) = d->xh_hess;
-      model_->get_state()->integrate(x, d->dx, d->xp);
-      d->du(ju) = d->uh_hess;
-      model_->calc(d->data_x[ix], d->xp, u + d->du);
-      const Scalar cpp = d->data_x[ix]->cost;
-      model_->calc(d->data_x[ix], d->xp, u - d->du);
-      const Scalar cpm = d->data_x[ix]->cost;
-      model_->get_state()->integrate(x, -d->dx, d->xp);
-      model_->calc(d->data_x[ix], d->xp, u + d->du);
-      const Scalar cmp = d->data_x[ix]->cost;
-      model_->calc(d->data_x[ix], d->xp, u - d->du);
-      const Scalar cmm = d->data_x[ix]->cost;
+      dx(ix) = d->xh_hess;
+      model_->get_state()->integrate(x, dx, xp);
+      up(ju) = u(ju) + d->uh_hess;
+      model_->calc(data_x, xp, up);
+      const Scalar cpp = data_x->cost;
+      up(ju) = u(ju) - d->uh_hess;
+      model_->calc(data_x, xp, up);
+      const Scalar cpm = data_x->cost;
+      dx(ix) = -d->xh_hess;
+      model_->get_state()->integrate(x, dx, xp);
+      up(ju) = u(ju) + d->uh_hess;
+      model_->calc(data_x, xp, up);
+      const Scalar cmp = data_x->cost;
+      up(ju) = u(ju) - d->uh_hess;
+      model_->calc(data_x, xp, up);
+      const Scalar cmm = data_x->cost;
       data->Lxu(ix, ju) = (cpp - cpm - cmp + cmm) / d->xuh_hess_pow2;
-      d->dx(ix) = 0.;
-      d->du(ju) = 0.;
+      dx(ix) = 0.;
+      up(ju) = u(ju);
     }
-  }
+  });
 #endif
 
   if (get_with_gauss_approx()) {
@@ -265,55 +293,66 @@ void ActionModelNumDiffTpl<Scalar>::calcDiff(
   d->x_norm = d->dx.norm();
   d->dx.setZero();
   d->xh_jac = e_jac_ * std::max(1., d->x_norm);
-  for (std::size_t ix = 0; ix < state_->get_ndx(); ++ix) {
-    d->dx(ix) = d->xh_jac;
-    model_->get_state()->integrate(x, d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp);
+  executor_->parallelFor(ndx, nthreads_, [&](const std::size_t ix) {
+    const std::shared_ptr<ActionDataAbstract>& data_x = d->data_x[ix];
+    VectorXs& dx = d->dx_x[ix];
+    VectorXs& xp = d->xp_x[ix];
+    dx(ix) = d->xh_jac;
+    model_->get_state()->integrate(x, dx, xp);
+    model_->calc(data_x, xp);
     // cost
-    data->Lx(ix) = (d->data_x[ix]->cost - c0) / d->xh_jac;
-    if (get_with_gauss_approx()) {
-      d->Rx.col(ix) = (d->data_x[ix]->r - d->data_0->r) / d->xh_jac;
+    data->Lx(ix) = (data_x->cost - c0) / d->xh_jac;
+    if (with_gauss_approx_) {
+      d->Rx.col(ix) = (data_x->r - d->data_0->r) / d->xh_jac;
     }
     // constraint
-    d->Gx.col(ix) = (d->data_x[ix]->g - g0) / d->xh_jac;
-    d->Hx.col(ix) = (d->data_x[ix]->h - h0) / d->xh_jac;
-    d->dx(ix) = 0.;
-  }
+    d->Gx.col(ix) = (data_x->g - g0) / d->xh_jac;
+    d->Hx.col(ix) = (data_x->h - h0) / d->xh_jac;
+    dx(ix) = 0.;
+  });
 
 #ifdef NDEBUG
   // Computing the d^2 cost(x,u) / dx^2
   d->xh_hess = e_hess_ * std::max(1., d->x_norm);
   d->xh_hess_pow2 = d->xh_hess * d->xh_hess;
-  for (std::size_t ix = 0; ix < ndx; ++ix) {
-    // We can apply the same formulas for finite difference as above
-    d->dx(ix) = d->xh_hess;
-    model_->get_state()->integrate(x, d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp);
-    const Scalar cp = d->data_x[ix]->cost;
-    model_->get_state()->integrate(x, -d->dx, d->xp);
-    model_->calc(d->data_x[ix], d->xp);
-    const Scalar cm = d->data_x[ix]->cost;
-    data->Lxx(ix, ix) = (cp - 2 * c0 + cm) / d->xh_hess_pow2;
-    for (std::size_t jx = ix + 1; jx < ndx; ++jx) {
-      d->dx(jx) = d->xh_hess;
-      model_->get_state()->integrate(x, d->dx, d->xp);
-      model_->calc(d->data_x[ix], d->xp);
-      const Scalar cpp =
-          d->data_x[ix]
-              ->cost;  // cost due to positive disturbance in both directions
-      d->dx(ix) = 0.;
-      model_->get_state()->integrate(x, d->dx, d->xp);
-      model_->calc(d->data_x[ix], d->xp);
-      const Scalar czp =
-          d->data_x[ix]->cost;  // cost due to zero disturance in 'i' and
-                                // positive disturbance in 'j' direction
-      data->Lxx(ix, jx) = (cpp - czp - cp + c0) / d->xh_hess_pow2;
-      data->Lxx(jx, ix) = data->Lxx(ix, jx);
-      d->dx(ix) = d->xh_hess;
-      d->dx(jx) = 0.;
-    }
-    d->dx(ix) = 0.;
-  }
+  // The perturbations of the first states need more evaluations
+  executor_->parallelFor(
+      ndx, nthreads_,
+      [&](const std::size_t ix) {
+        const std::shared_ptr<ActionDataAbstract>& data_x = d->data_x[ix];
+        VectorXs& dx = d->dx_x[ix];
+        VectorXs& xp = d->xp_x[ix];
+        dx(ix) = d->xh_hess;
+        model_->get_state()->integrate(x, dx, xp);
+        model_->calc(data_x, xp);
+        const Scalar cp = data_x->cost;
+        dx(ix) = -d->xh_hess;
+        model_->get_state()->integrate(x, dx, xp);
+        model_->calc(data_x, xp);
+        const Scalar cm = data_x->cost;
+        data->Lxx(ix, ix) = (cp - 2 * c0 + cm) / d->xh_hess_pow2;
+        dx(ix) = d->xh_hess;
+        for (std::size_t jx = ix + 1; jx < ndx; ++jx) {
+          dx(jx) = d->xh_hess;
+          model_->get_state()->integrate(x, dx, xp);
+          model_->calc(data_x, xp);
+          const Scalar cpp =
+              data_x->cost;  // cost due to positive disturbance in both
+                             // directions
+          dx(ix) = 0.;
+          model_->get_state()->integrate(x, dx, xp);
+          model_->calc(data_x, xp);
+          const Scalar czp =
+              data_x->cost;  // cost due to zero disturance in 'i' and
+                             // positive disturbance in 'j' direction
+          data->Lxx(ix, jx) = (cpp - czp - cp + c0) / d->xh_hess_pow2;
+          data->Lxx(jx, ix) = data->Lxx(ix, jx);
+          dx(ix) = d->xh_hess;
+          dx(jx) = 0.;
+        }
+        dx(ix) = 0.;
+      },
+      d->costs_x);
 #endif
 
   if (get_with_gauss_approx()) {
@@ -324,7 +363,7 @@ void ActionModelNumDiffTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActionDataAbstractTpl<Scalar> >
 ActionModelNumDiffTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -361,6 +400,32 @@ bool ActionModelNumDiffTpl<Scalar>::get_with_gauss_approx() {
   return with_gauss_approx_;
 }
 
+template <typename Scalar>
+std::size_t ActionModelNumDiffTpl<Scalar>::get_nthreads() const {
+  return nthreads_;
+}
+
+template <typename Scalar>
+void ActionModelNumDiffTpl<Scalar>::set_nthreads(const int nthreads) {
+  nthreads_ =
+      executor_->getNumberOfThreads(nthreads, "the numerical differentiation");
+}
+
+template <typename Scalar>
+const std::shared_ptr<ExecutorAbstract>&
+ActionModelNumDiffTpl<Scalar>::get_executor() const {
+  return executor_;
+}
+
+template <typename Scalar>
+void ActionModelNumDiffTpl<Scalar>::set_executor(
+    std::shared_ptr<ExecutorAbstract> executor) {
+  if (!executor) {
+    throw_pretty("Invalid argument: " << "executor is not defined");
+  }
+  executor_ = executor;
+}
+
 template <typename Scalar>
 void ActionModelNumDiffTpl<Scalar>::print(std::ostream& os) const {
   os << "ActionModelNumDiffTpl {action=" << *model_ << "}";
@@ -68,7 +68,7 @@ void ActivationModelNumDiffTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ActivationDataAbstractTpl<Scalar> >
 ActivationModelNumDiffTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
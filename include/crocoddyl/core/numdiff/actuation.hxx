@@ -164,7 +164,7 @@ void ActuationModelNumDiffTpl<Scalar>::torqueTransform(
 template <typename Scalar>
 std::shared_ptr<ActuationDataAbstractTpl<Scalar> >
 ActuationModelNumDiffTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -153,8 +153,7 @@ void CostModelNumDiffTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<CostDataAbstractTpl<Scalar> >
 CostModelNumDiffTpl<Scalar>::createData(DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
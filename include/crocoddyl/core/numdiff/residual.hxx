@@ -110,8 +110,7 @@ void ResidualModelNumDiffTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelNumDiffTpl<Scalar>::createData(DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
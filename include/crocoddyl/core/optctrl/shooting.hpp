@@ -16,6 +16,7 @@
 #include "crocoddyl/core/fwd.hpp"
 #include "crocoddyl/core/utils/deprecate.hpp"
 #include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/executor.hpp"
 
 namespace crocoddyl {
 
@@ -41,6 +42,7 @@ class ShootingProblemTpl {
   typedef ActionDataAbstractTpl<Scalar> ActionDataAbstract;
   typedef MathBaseTpl<Scalar> MathBase;
   typedef typename MathBase::VectorXs VectorXs;
+  typedef typename MathBase::MatrixXs MatrixXs;
 
   /**
    * @brief Initialize the shooting problem and allocate its data
@@ -109,6 +111,36 @@ class ShootingProblemTpl {
   Scalar calcDiff(const std::vector<VectorXs>& xs,
                   const std::vector<VectorXs>& us);
 
+  /**
+   * @brief Compute the derivatives of the cost and dynamics, and the
+   * second-order terms of the dynamics
+   *
+   * Along with the derivatives computed by `calcDiff(xs, us)`, it computes
+   * the contraction of the dynamics Hessian with the costate of the next node,
+   * i.e., \f$\nabla^2_{\mathbf{z}\mathbf{z}}(\boldsymbol{\lambda}_{k+1}^\top
+   * \mathbf{f}_k)\f$ with \f$\mathbf{z}=(\delta\mathbf{x},\mathbf{u})\f$, in
+   * each running node (see `get_dynamicsHessians()`). These terms are
+   * computed within the same parallel loop as the derivatives, by finite
+   * differences of the directional derivatives
+   * \f$(\mathbf{f}_{\mathbf{x}}^\top\boldsymbol{\lambda}_{k+1},
+   * \mathbf{f}_{\mathbf{u}}^\top\boldsymbol{\lambda}_{k+1})\f$. This requires
+   * \f$n_{dx}+n_u\f$ extra evaluations of `calc` and `calcDiff` per node.
+   * For states on Lie groups, the variation of the tangent space of the next
+   * state is neglected. The second-order mode has to be enabled (see
+   * `set_second_order()`).
+   *
+   * @param[in] xs       time-discrete state trajectory \f$\mathbf{x_{s}}\f$
+   * (size \f$T+1\f$)
+   * @param[in] us       time-discrete control sequence \f$\mathbf{u_{s}}\f$
+   * (size \f$T\f$)
+   * @param[in] lambdas  time-discrete costates
+   * \f$\boldsymbol{\lambda}_{s}\f$ (size \f$T+1\f$)
+   * @return The total cost value \f$l_{k}\f$
+   */
+  Scalar calcDiff(const std::vector<VectorXs>& xs,
+                  const std::vector<VectorXs>& us,
+                  const std::vector<VectorXs>& lambdas);
+
   /**
    * @brief Integrate the dynamics given a control sequence
    *
@@ -166,7 +198,7 @@ class ShootingProblemTpl {
    *
    * Once we update the end running node, the first running mode is removed as
    * in a circular buffer. Note that this method allocates new data for the end
-   * running node.
+   * running node, unless the data pool contains a data of this model.
    *
    * @param[in] model  action model
    */
@@ -186,12 +218,26 @@ class ShootingProblemTpl {
   /**
    * @brief Update a model and allocated new data for a specific node
    *
+   * The data is taken from the data pool if it contains a data of this model.
+   *
    * @param[in] i      node index \f$(0\leq i \lt T+1)\f$
    * @param[in] model  action model
    */
   void updateModel(const std::size_t i,
                    std::shared_ptr<ActionModelAbstract> model);
 
+  /**
+   * @brief Create datas of a model and store them in the data pool
+   *
+   * This allows to later update the nodes with this model (e.g., through
+   * `circularAppend`) without allocating new data.
+   *
+   * @param[in] model  action model
+   * @param[in] n      number of datas
+   */
+  void reserveDatas(std::shared_ptr<ActionModelAbstract> model,
+                    const std::size_t n);
+
   /**
    * @brief Return the number of running nodes
    */
@@ -243,11 +289,73 @@ class ShootingProblemTpl {
   /**
    * @brief Modify the number of threads using with multithreading support
    *
-   * For values lower than 1, the number of threads is chosen by
-   * CROCODDYL_WITH_NTHREADS macro
+   * The number of threads is resolved by the executor (see
+   * `ExecutorAbstract::getNumberOfThreads()`), so the executor needs to be
+   * set first. For the default executor, values lower than 1 select the
+   * CROCODDYL_WITH_NTHREADS macro, and one thread is used if multithreading
+   * support is not enabled. The work-stealing executor does not require
+   * multithreading support.
    */
   void set_nthreads(const int nthreads);
 
+  /**
+   * @brief Enable or disable the balancing of nodes across threads
+   *
+   * If enabled, the wall time of `calc` and `calcDiff` in each node is
+   * measured and exponentially smoothed. These timings are then passed as
+   * iteration costs to the executor, which partitions the nodes into
+   * contiguous ranges with similar computational costs in later calls. This
+   * is useful when the nodes have heterogeneous costs (e.g., contact phases
+   * with different number of contacts). It is disabled by default.
+   */
+  void set_balance_nodes(const bool balance);
+
+  /**
+   * @brief Modify the executor used to compute the nodes in parallel
+   *
+   * By default, the nodes are computed with `ExecutorOpenMP`. The number of
+   * threads needs to be set after the executor (see `set_nthreads()`).
+   */
+  void set_executor(std::shared_ptr<ExecutorAbstract> executor);
+
+  /**
+   * @brief Enable or disable the allocation of the node datas in arenas
+   *
+   * If enabled, the data tree of each node (i.e., the action data and the
+   * datas created by its `createData()`) is placed in its own `DataArena`.
+   * This improves the locality of the node computations. Each arena is sized
+   * with the largest data tree allocated so far, so the datas of a node
+   * usually require a single allocation. Changing this option recreates the
+   * datas of all the nodes. It is disabled by default.
+   */
+  void set_use_arena(const bool use_arena);
+
+  /**
+   * @brief Modify the maximum number of datas stored in the data pool
+   *
+   * The data pool recycles the datas of the nodes removed by
+   * `circularAppend`, `updateModel` and `updateNode`. These datas are later
+   * reused when a node is updated with the same model, which avoids any heap
+   * allocation when shifting the horizon of receding-horizon problems (e.g.,
+   * MPC with a periodic sequence of models). A data is only recycled if it is
+   * not referenced elsewhere, and the oldest data is discarded when the pool
+   * is full. The memory of the pool is reserved by this function. By
+   * default, the pool is disabled (i.e., its size is zero).
+   */
+  void set_data_pool_size(const std::size_t size);
+
+  /**
+   * @brief Enable or disable the second-order terms of the dynamics
+   *
+   * If enabled, the workspace needed by `calcDiff(xs, us, lambdas)` is
+   * allocated, and the DDP-based solvers include the second-order terms of
+   * the dynamics in the control Hamiltonian (i.e., they run the full DDP
+   * instead of iLQR). This reduces the number of iterations in problems with
+   * strongly nonlinear dynamics at the expense of more expensive iterations.
+   * It is disabled by default.
+   */
+  void set_second_order(const bool second_order);
+
   /**
    * @brief Return the dimension of the state tuple
    */
@@ -269,6 +377,79 @@ class ShootingProblemTpl {
    */
   std::size_t get_nthreads() const;
 
+  /**
+   * @brief Return true if the nodes are balanced with their measured timings
+   */
+  bool get_balance_nodes() const;
+
+  /**
+   * @brief Return true if the node datas are allocated in arenas
+   */
+  bool get_use_arena() const;
+
+  /**
+   * @brief Return the maximum number of datas stored in the data pool
+   */
+  std::size_t get_data_pool_size() const;
+
+  /**
+   * @brief Return the number of datas stored in the data pool
+   */
+  std::size_t get_data_pool_ndatas() const;
+
+  /**
+   * @brief Return true if the second-order terms of the dynamics are enabled
+   */
+  bool get_second_order() const;
+
+  /**
+   * @brief Return the second-order terms of the dynamics in each running node
+   *
+   * Each term is the Hessian \f$\nabla^2_{\mathbf{z}\mathbf{z}}
+   * (\boldsymbol{\lambda}_{k+1}^\top\mathbf{f}_k)\f$ of dimension
+   * \f$(n_{dx}+n_u)\times(n_{dx}+n_u)\f$ computed by the last call of
+   * `calcDiff(xs, us, lambdas)`.
+   */
+  const std::vector<MatrixXs>& get_dynamicsHessians() const;
+
+  /**
+   * @brief Return the smoothed wall time of `calc` in each node (in
+   * microseconds)
+   *
+   * The last element corresponds to the terminal node. The timings are only
+   * measured if the balancing of nodes is enabled.
+   */
+  const std::vector<double>& get_calc_times() const;
+
+  /**
+   * @brief Return the smoothed wall time of `calcDiff` in each node (in
+   * microseconds)
+   *
+   * The last element corresponds to the terminal node. The timings are only
+   * measured if the balancing of nodes is enabled.
+   */
+  const std::vector<double>& get_calcDiff_times() const;
+
+  /**
+   * @brief Return the executor used to compute the nodes in parallel
+   */
+  const std::shared_ptr<ExecutorAbstract>& get_executor() const;
+
+  /**
+   * @brief Run a loop over `n` nodes with the executor of the problem
+   *
+   * The iterations are computed with the number of threads defined in the
+   * problem. This function is also used by the solvers to parallelize their
+   * node-wise computations.
+   *
+   * @param[in] n     number of iterations
+   * @param[in] body  loop body with signature `void(std::size_t)`
+   */
+  template <typename Body>
+  void parallelFor(const std::size_t n, const Body& body) {
+    executor_->parallelFor(n, nthreads_, body);
+  }
+
   /**
    * @brief Return only once true is the shooting problem has been changed,
    * otherwise false
@@ -298,10 +479,95 @@ class ShootingProblemTpl {
   std::size_t nu_max_;    //!< Maximum control dimension
   std::size_t nthreads_;  //!< Number of threads launch by the multi-threading
                           //!< application
+  std::shared_ptr<ExecutorAbstract>
+      executor_;  //!< Executor used to compute the nodes in parallel
+  bool balance_nodes_;  //!< True if the nodes are balanced with their timings
+  std::vector<double> calc_times_;      //!< Smoothed wall time of `calc`
+  std::vector<double> calcDiff_times_;  //!< Smoothed wall time of `calcDiff`
+  std::vector<double> node_times_;  //!< Last wall time measured in each node
+  bool use_arena_;  //!< True if the node datas are placed in arenas
+  std::size_t arena_size_;  //!< Largest data tree allocated in an arena
+  std::size_t data_pool_size_;  //!< Maximum number of datas in the pool
+  std::vector<std::shared_ptr<ActionModelAbstract> >
+      pool_models_;  //!< Models of the recycled datas
+  std::vector<std::shared_ptr<ActionDataAbstract> >
+      pool_datas_;  //!< Recycled datas (from the oldest to the newest)
+  bool second_order_;  //!< True if the second-order terms are enabled
+  std::vector<std::shared_ptr<ActionModelAbstract> >
+      so_models_;  //!< Models used to create the second-order datas
+  std::vector<std::shared_ptr<ActionDataAbstract> >
+      so_datas_;  //!< Datas used to evaluate the disturbed nodes
+  std::vector<VectorXs> so_xs_;    //!< Disturbed state of each node
+  std::vector<VectorXs> so_us_;    //!< Disturbed control of each node
+  std::vector<VectorXs> so_dx_;    //!< State disturbance of each node
+  std::vector<VectorXs> so_grad_;  //!< Nominal directional derivatives
+  std::vector<MatrixXs>
+      dynamics_hessians_;  //!< Second-order terms of the dynamics
   bool is_updated_;
 
  private:
   void allocateData();
+
+  /**
+   * @brief Create the data of a node (in its own arena if enabled)
+   */
+  std::shared_ptr<ActionDataAbstract> createData(
+      const std::shared_ptr<ActionModelAbstract>& model);
+
+  /**
+   * @brief Take a data of the model from the pool (or create a new one)
+   */
+  std::shared_ptr<ActionDataAbstract> acquireData(
+      const std::shared_ptr<ActionModelAbstract>& model);
+
+  /**
+   * @brief Move the data of a removed node to the pool (if possible)
+   */
+  void releaseData(const std::shared_ptr<ActionModelAbstract>& model,
+                   std::shared_ptr<ActionDataAbstract>& data);
+
+  /**
+   * @brief Run a loop over all the nodes (including the terminal one)
+   *
+   * If the balancing of nodes is enabled, it uses `times` as costs of the
+   * nodes, and updates them with the wall time measured in this call.
+   */
+  template <typename Body>
+  void computeNodes(std::vector<double>& times, const Body& body);
+
+  /**
+   * @brief Allocate the second-order workspace of the running nodes
+   *
+   * The workspace is only allocated for the nodes whose model has changed.
+   */
+  void resizeSecondOrderData();
+
+  /**
+   * @brief Allocate the second-order workspace of a running node if its model
+   * has changed
+   *
+   * @param[in] i  Node index
+   */
+  void resizeSecondOrderNode(const std::size_t i);
+
+  /**
+   * @brief Shift the second-order workspace along with the running nodes
+   *
+   * The workspace of the first node is moved to the last one, and it is only
+   * allocated again if the appended model is different.
+   */
+  void shiftSecondOrderData();
+
+  /**
+   * @brief Compute the second-order terms of the dynamics of a running node
+   *
+   * @param[in] i       node index \f$(0\leq i \lt T)\f$
+   * @param[in] x       state point
+   * @param[in] u       control input
+   * @param[in] lambda  costate of the next node
+   */
+  void computeSecondOrderTerms(const std::size_t i, const VectorXs& x,
+                               const VectorXs& u, const VectorXs& lambda);
 };
 
 }  // namespace crocoddyl
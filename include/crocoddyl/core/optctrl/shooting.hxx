@@ -7,11 +7,14 @@
 // All rights reserved.
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #ifdef CROCODDYL_WITH_MULTITHREADING
 #include <omp.h>
 #endif  // CROCODDYL_WITH_MULTITHREADING
 #include "crocoddyl/core/utils/stop-watch.hpp"
+#include "crocoddyl/core/utils/timer.hpp"
 
 namespace crocoddyl {
 
@@ -29,6 +32,15 @@ ShootingProblemTpl<Scalar>::ShootingProblemTpl(
       ndx_(running_models[0]->get_state()->get_ndx()),
       nu_max_(running_models[0]->get_nu()),
       nthreads_(1),
+      executor_(std::make_shared<ExecutorOpenMP>()),
+      balance_nodes_(false),
+      calc_times_(T_ + 1, 0.),
+      calcDiff_times_(T_ + 1, 0.),
+      node_times_(T_ + 1, 0.),
+      use_arena_(false),
+      arena_size_(0),
+      data_pool_size_(0),
+      second_order_(false),
       is_updated_(false) {
   for (std::size_t i = 1; i < T_; ++i) {
     const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
@@ -91,7 +103,16 @@ ShootingProblemTpl<Scalar>::ShootingProblemTpl(
       nx_(running_models[0]->get_state()->get_nx()),
       ndx_(running_models[0]->get_state()->get_ndx()),
       nu_max_(running_models[0]->get_nu()),
-      nthreads_(1) {
+      nthreads_(1),
+      executor_(std::make_shared<ExecutorOpenMP>()),
+      balance_nodes_(false),
+      calc_times_(T_ + 1, 0.),
+      calcDiff_times_(T_ + 1, 0.),
+      node_times_(T_ + 1, 0.),
+      use_arena_(false),
+      arena_size_(0),
+      data_pool_size_(0),
+      second_order_(false) {
   for (std::size_t i = 1; i < T_; ++i) {
     const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
     const std::size_t nu = model->get_nu();
@@ -155,7 +176,21 @@ ShootingProblemTpl<Scalar>::ShootingProblemTpl(
       running_datas_(problem.get_runningDatas()),
       nx_(problem.get_nx()),
       ndx_(problem.get_ndx()),
-      nu_max_(problem.get_nu_max()) {}
+      nu_max_(problem.get_nu_max()),
+      nthreads_(problem.nthreads_),
+      executor_(problem.get_executor()),
+      balance_nodes_(problem.get_balance_nodes()),
+      calc_times_(problem.get_calc_times()),
+      calcDiff_times_(problem.get_calcDiff_times()),
+      node_times_(T_ + 1, 0.),
+      use_arena_(problem.get_use_arena()),
+      arena_size_(problem.arena_size_),
+      data_pool_size_(0),
+      second_order_(false),
+      is_updated_(false) {
+  set_data_pool_size(problem.get_data_pool_size());
+  set_second_order(problem.get_second_order());
+}
 
 template <typename Scalar>
 ShootingProblemTpl<Scalar>::~ShootingProblemTpl() {}
@@ -175,13 +210,14 @@ Scalar ShootingProblemTpl<Scalar>::calc(const std::vector<VectorXs>& xs,
   }
   START_PROFILER("ShootingProblem::calc");
 
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(nthreads_)
-#endif
-  for (std::size_t i = 0; i < T_; ++i) {
-    running_models_[i]->calc(running_datas_[i], xs[i], us[i]);
-  }
-  terminal_model_->calc(terminal_data_, xs.back());
+  // The terminal node is computed within the loop as the last iteration
+  computeNodes(calc_times_, [&](const std::size_t i) {
+    if (i < T_) {
+      running_models_[i]->calc(running_datas_[i], xs[i], us[i]);
+    } else {
+      terminal_model_->calc(terminal_data_, xs.back());
+    }
+  });
 
   cost_ = Scalar(0.);
 #ifdef CROCODDYL_WITH_MULTITHREADING
@@ -210,13 +246,71 @@ Scalar ShootingProblemTpl<Scalar>::calcDiff(const std::vector<VectorXs>& xs,
   }
   START_PROFILER("ShootingProblem::calcDiff");
 
+  // The terminal node is computed within the loop as the last iteration
+  computeNodes(calcDiff_times_, [&](const std::size_t i) {
+    if (i < T_) {
+      running_models_[i]->calcDiff(running_datas_[i], xs[i], us[i]);
+    } else {
+      terminal_model_->calcDiff(terminal_data_, xs.back());
+    }
+  });
+
+  cost_ = Scalar(0.);
 #ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(nthreads_)
+#pragma omp simd reduction(+ : cost_)
 #endif
   for (std::size_t i = 0; i < T_; ++i) {
-    running_models_[i]->calcDiff(running_datas_[i], xs[i], us[i]);
+    cost_ += running_datas_[i]->cost;
   }
-  terminal_model_->calcDiff(terminal_data_, xs.back());
+  cost_ += terminal_data_->cost;
+
+  STOP_PROFILER("ShootingProblem::calcDiff");
+  return cost_;
+}
+
+template <typename Scalar>
+Scalar ShootingProblemTpl<Scalar>::calcDiff(
+    const std::vector<VectorXs>& xs, const std::vector<VectorXs>& us,
+    const std::vector<VectorXs>& lambdas) {
+  if (!second_order_) {
+    throw_pretty("Invalid argument: "
+                 << "the second-order terms are not enabled");
+  }
+  if (xs.size() != T_ + 1) {
+    throw_pretty(
+        "Invalid argument: " << "xs has wrong dimension (it should be " +
+                                    std::to_string(T_ + 1) + ")");
+  }
+  if (us.size() != T_) {
+    throw_pretty(
+        "Invalid argument: " << "us has wrong dimension (it should be " +
+                                    std::to_string(T_) + ")");
+  }
+  if (lambdas.size() != T_ + 1) {
+    throw_pretty(
+        "Invalid argument: " << "lambdas has wrong dimension (it should be " +
+                                    std::to_string(T_ + 1) + ")");
+  }
+  for (std::size_t i = 0; i < T_ + 1; ++i) {
+    if (static_cast<std::size_t>(lambdas[i].size()) != ndx_) {
+      throw_pretty("Invalid argument: "
+                   << "lambdas[" + std::to_string(i) +
+                          "] has wrong dimension (it should be " +
+                          std::to_string(ndx_) + ")");
+    }
+  }
+  START_PROFILER("ShootingProblem::calcDiff");
+
+  // The second-order terms of each node are computed by the same thread, right
+  // after its derivatives
+  computeNodes(calcDiff_times_, [&](const std::size_t i) {
+    if (i < T_) {
+      running_models_[i]->calcDiff(running_datas_[i], xs[i], us[i]);
+      computeSecondOrderTerms(i, xs[i], us[i], lambdas[i + 1]);
+    } else {
+      terminal_model_->calcDiff(terminal_data_, xs.back());
+    }
+  });
 
   cost_ = Scalar(0.);
 #ifdef CROCODDYL_WITH_MULTITHREADING
@@ -279,12 +373,9 @@ void ShootingProblemTpl<Scalar>::quasiStatic(std::vector<VectorXs>& us,
                                     std::to_string(T_) + ")");
   }
 
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(nthreads_)
-#endif
-  for (std::size_t i = 0; i < T_; ++i) {
+  executor_->parallelFor(T_, nthreads_, [&](const std::size_t i) {
     running_models_[i]->quasiStatic(running_datas_[i], us[i], xs[i]);
-  }
+  });
 }
 
 template <typename Scalar>
@@ -316,12 +407,20 @@ void ShootingProblemTpl<Scalar>::circularAppend(
                  << "ndx node is not consistent with the other nodes")
   }
   is_updated_ = true;
+  releaseData(running_models_[0], running_datas_[0]);
   for (std::size_t i = 0; i < T_ - 1; ++i) {
-    running_models_[i] = running_models_[i + 1];
-    running_datas_[i] = running_datas_[i + 1];
+    running_models_[i] = std::move(running_models_[i + 1]);
+    running_datas_[i] = std::move(running_datas_[i + 1]);
+    calc_times_[i] = calc_times_[i + 1];
+    calcDiff_times_[i] = calcDiff_times_[i + 1];
   }
+  calc_times_[T_ - 1] = 0.;
+  calcDiff_times_[T_ - 1] = 0.;
   running_models_.back() = model;
   running_datas_.back() = data;
+  if (second_order_) {
+    shiftSecondOrderData();
+  }
 }
 
 template <typename Scalar>
@@ -336,12 +435,22 @@ void ShootingProblemTpl<Scalar>::circularAppend(
                  << "ndx node is not consistent with the other nodes")
   }
   is_updated_ = true;
+  // The data of the first node is recycled before appending the new node, so
+  // a periodic sequence of models does not allocate new datas
+  releaseData(running_models_[0], running_datas_[0]);
   for (std::size_t i = 0; i < T_ - 1; ++i) {
-    running_models_[i] = running_models_[i + 1];
-    running_datas_[i] = running_datas_[i + 1];
+    running_models_[i] = std::move(running_models_[i + 1]);
+    running_datas_[i] = std::move(running_datas_[i + 1]);
+    calc_times_[i] = calc_times_[i + 1];
+    calcDiff_times_[i] = calcDiff_times_[i + 1];
   }
+  calc_times_[T_ - 1] = 0.;
+  calcDiff_times_[T_ - 1] = 0.;
   running_models_.back() = model;
-  running_datas_.back() = model->createData();
+  running_datas_.back() = acquireData(model);
+  if (second_order_) {
+    shiftSecondOrderData();
+  }
 }
 
 template <typename Scalar>
@@ -367,12 +476,19 @@ void ShootingProblemTpl<Scalar>::updateNode(
                  << "ndx node is not consistent with the other nodes")
   }
   is_updated_ = true;
+  calc_times_[i] = 0.;
+  calcDiff_times_[i] = 0.;
   if (i == T_) {
+    releaseData(terminal_model_, terminal_data_);
     terminal_model_ = model;
     terminal_data_ = data;
   } else {
+    releaseData(running_models_[i], running_datas_[i]);
     running_models_[i] = model;
     running_datas_[i] = data;
+    if (second_order_) {
+      resizeSecondOrderNode(i);
+    }
   }
 }
 
@@ -394,12 +510,43 @@ void ShootingProblemTpl<Scalar>::updateModel(
         "Invalid argument: " << "ndx is not consistent with the other nodes")
   }
   is_updated_ = true;
+  calc_times_[i] = 0.;
+  calcDiff_times_[i] = 0.;
   if (i == T_) {
+    releaseData(terminal_model_, terminal_data_);
     terminal_model_ = model;
-    terminal_data_ = terminal_model_->createData();
+    terminal_data_ = acquireData(terminal_model_);
   } else {
+    releaseData(running_models_[i], running_datas_[i]);
     running_models_[i] = model;
-    running_datas_[i] = model->createData();
+    running_datas_[i] = acquireData(model);
+    if (second_order_) {
+      resizeSecondOrderNode(i);
+    }
+  }
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::reserveDatas(
+    std::shared_ptr<ActionModelAbstract> model, const std::size_t n) {
+  if (pool_datas_.size() + n > data_pool_size_) {
+    throw_pretty(
+        "Invalid argument: "
+        << "n exceeds the free space of the data pool (it should be lower "
+           "than or equal to " +
+               std::to_string(data_pool_size_ - pool_datas_.size()) + ")");
+  }
+  if (model->get_state()->get_nx() != nx_) {
+    throw_pretty(
+        "Invalid argument: " << "nx is not consistent with the other nodes")
+  }
+  if (model->get_state()->get_ndx() != ndx_) {
+    throw_pretty(
+        "Invalid argument: " << "ndx is not consistent with the other nodes")
+  }
+  for (std::size_t k = 0; k < n; ++k) {
+    pool_models_.push_back(model);
+    pool_datas_.push_back(createData(model));
   }
 }
 
@@ -418,10 +565,58 @@ template <typename Scalar>
 void ShootingProblemTpl<Scalar>::allocateData() {
   running_datas_.resize(T_);
   for (std::size_t i = 0; i < T_; ++i) {
-    const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
-    running_datas_[i] = model->createData();
+    running_datas_[i] = createData(running_models_[i]);
+  }
+  terminal_data_ = createData(terminal_model_);
+}
+
+template <typename Scalar>
+std::shared_ptr<ActionDataAbstractTpl<Scalar> >
+ShootingProblemTpl<Scalar>::createData(
+    const std::shared_ptr<ActionModelAbstract>& model) {
+  if (!use_arena_) {
+    return model->createData();
+  }
+  const std::shared_ptr<DataArena> arena =
+      arena_size_ > 0 ? std::make_shared<DataArena>(arena_size_)
+                      : std::make_shared<DataArena>();
+  DataArenaScope scope(arena);
+  std::shared_ptr<ActionDataAbstract> data = model->createData();
+  if (arena_size_ < arena->get_size()) {
+    arena_size_ = arena->get_size();
+  }
+  return data;
+}
+
+template <typename Scalar>
+std::shared_ptr<ActionDataAbstractTpl<Scalar> >
+ShootingProblemTpl<Scalar>::acquireData(
+    const std::shared_ptr<ActionModelAbstract>& model) {
+  // Take the newest data of this model, which is likely to be in cache
+  for (std::size_t k = pool_models_.size(); k-- > 0;) {
+    if (pool_models_[k] == model) {
+      std::shared_ptr<ActionDataAbstract> data = std::move(pool_datas_[k]);
+      pool_models_.erase(pool_models_.begin() + k);
+      pool_datas_.erase(pool_datas_.begin() + k);
+      return data;
+    }
   }
-  terminal_data_ = terminal_model_->createData();
+  return createData(model);
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::releaseData(
+    const std::shared_ptr<ActionModelAbstract>& model,
+    std::shared_ptr<ActionDataAbstract>& data) {
+  if (data_pool_size_ == 0 || !model || !data || data.use_count() != 1) {
+    return;
+  }
+  if (pool_datas_.size() == data_pool_size_) {
+    pool_models_.erase(pool_models_.begin());
+    pool_datas_.erase(pool_datas_.begin());
+  }
+  pool_models_.push_back(model);
+  pool_datas_.push_back(std::move(data));
 }
 
 template <typename Scalar>
@@ -476,11 +671,17 @@ void ShootingProblemTpl<Scalar>::set_runningModels(
   }
   is_updated_ = true;
   T_ = models.size();
+  calc_times_.assign(T_ + 1, 0.);
+  calcDiff_times_.assign(T_ + 1, 0.);
+  node_times_.assign(T_ + 1, 0.);
   running_models_.clear();
   running_datas_.clear();
   for (std::size_t i = 0; i < T_; ++i) {
     const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
-    running_datas_.push_back(model->createData());
+    running_datas_.push_back(createData(model));
+  }
+  if (second_order_) {
+    resizeSecondOrderData();
   }
 }
 
@@ -497,31 +698,63 @@ void ShootingProblemTpl<Scalar>::set_terminalModel(
   }
   is_updated_ = true;
   terminal_model_ = model;
-  terminal_data_ = terminal_model_->createData();
+  terminal_data_ = createData(terminal_model_);
 }
 
 template <typename Scalar>
 void ShootingProblemTpl<Scalar>::set_nthreads(const int nthreads) {
-#ifndef CROCODDYL_WITH_MULTITHREADING
-  (void)nthreads;
-  std::cerr << "Warning: the number of threads won't affect the computational "
-               "performance as multithreading "
-               "support is not enabled."
-            << std::endl;
-#else
-  if (nthreads < 1) {
-    nthreads_ = CROCODDYL_WITH_NTHREADS;
-  } else {
-    nthreads_ = static_cast<std::size_t>(nthreads);
+  nthreads_ = executor_->getNumberOfThreads(nthreads, "the shooting problem");
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::set_executor(
+    std::shared_ptr<ExecutorAbstract> executor) {
+  if (!executor) {
+    throw_pretty("Invalid argument: " << "executor is not defined");
   }
-  if (!enableMultithreading()) {
-    std::cerr << "Warning: the number of threads won't affect the "
-                 "computational performance as multithreading "
-                 "support is not enabled."
-              << std::endl;
-    nthreads_ = 1;
+  executor_ = executor;
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::set_balance_nodes(const bool balance) {
+  balance_nodes_ = balance;
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::set_use_arena(const bool use_arena) {
+  if (use_arena_ != use_arena) {
+    use_arena_ = use_arena;
+    is_updated_ = true;
+    allocateData();
+  }
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::set_data_pool_size(const std::size_t size) {
+  if (pool_datas_.size() > size) {
+    const std::size_t n = pool_datas_.size() - size;
+    pool_models_.erase(pool_models_.begin(), pool_models_.begin() + n);
+    pool_datas_.erase(pool_datas_.begin(), pool_datas_.begin() + n);
+  }
+  data_pool_size_ = size;
+  pool_models_.reserve(size);
+  pool_datas_.reserve(size);
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::set_second_order(const bool second_order) {
+  second_order_ = second_order;
+  if (second_order_) {
+    resizeSecondOrderData();
+  } else {
+    so_models_.clear();
+    so_datas_.clear();
+    so_xs_.clear();
+    so_us_.clear();
+    so_dx_.clear();
+    so_grad_.clear();
+    dynamics_hessians_.clear();
   }
-#endif
 }
 
 template <typename Scalar>
@@ -541,15 +774,57 @@ std::size_t ShootingProblemTpl<Scalar>::get_nu_max() const {
 
 template <typename Scalar>
 std::size_t ShootingProblemTpl<Scalar>::get_nthreads() const {
-#ifndef CROCODDYL_WITH_MULTITHREADING
-  std::cerr << "Warning: the number of threads won't affect the computational "
-               "performance as multithreading "
-               "support is not enabled."
-            << std::endl;
-#endif
   return nthreads_;
 }
 
+template <typename Scalar>
+const std::shared_ptr<ExecutorAbstract>&
+ShootingProblemTpl<Scalar>::get_executor() const {
+  return executor_;
+}
+
+template <typename Scalar>
+bool ShootingProblemTpl<Scalar>::get_balance_nodes() const {
+  return balance_nodes_;
+}
+
+template <typename Scalar>
+bool ShootingProblemTpl<Scalar>::get_use_arena() const {
+  return use_arena_;
+}
+
+template <typename Scalar>
+std::size_t ShootingProblemTpl<Scalar>::get_data_pool_size() const {
+  return data_pool_size_;
+}
+
+template <typename Scalar>
+std::size_t ShootingProblemTpl<Scalar>::get_data_pool_ndatas() const {
+  return pool_datas_.size();
+}
+
+template <typename Scalar>
+bool ShootingProblemTpl<Scalar>::get_second_order() const {
+  return second_order_;
+}
+
+template <typename Scalar>
+const std::vector<typename MathBaseTpl<Scalar>::MatrixXs>&
+ShootingProblemTpl<Scalar>::get_dynamicsHessians() const {
+  return dynamics_hessians_;
+}
+
+template <typename Scalar>
+const std::vector<double>& ShootingProblemTpl<Scalar>::get_calc_times() const {
+  return calc_times_;
+}
+
+template <typename Scalar>
+const std::vector<double>& ShootingProblemTpl<Scalar>::get_calcDiff_times()
+    const {
+  return calcDiff_times_;
+}
+
 template <typename Scalar>
 bool ShootingProblemTpl<Scalar>::is_updated() {
   const bool status = is_updated_;
@@ -557,6 +832,131 @@ bool ShootingProblemTpl<Scalar>::is_updated() {
   return status;
 }
 
+template <typename Scalar>
+template <typename Body>
+void ShootingProblemTpl<Scalar>::computeNodes(std::vector<double>& times,
+                                              const Body& body) {
+  if (!balance_nodes_) {
+    executor_->parallelFor(T_ + 1, nthreads_, body);
+    return;
+  }
+  // The smoothed timings are only read by the executor, while the timings of
+  // this call are stored in a separate buffer
+  executor_->parallelFor(
+      T_ + 1, nthreads_,
+      [&](const std::size_t i) {
+        Timer timer;
+        body(i);
+        node_times_[i] = timer.get_us_duration();
+      },
+      times);
+  const double alpha = 0.5;  // smoothing factor of the timings
+  for (std::size_t i = 0; i < T_ + 1; ++i) {
+    times[i] = times[i] > 0. ? (1. - alpha) * times[i] + alpha * node_times_[i]
+                             : node_times_[i];
+  }
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::resizeSecondOrderData() {
+  so_models_.resize(T_);
+  so_datas_.resize(T_);
+  so_xs_.resize(T_);
+  so_us_.resize(T_);
+  so_dx_.resize(T_);
+  so_grad_.resize(T_);
+  dynamics_hessians_.resize(T_);
+  for (std::size_t i = 0; i < T_; ++i) {
+    resizeSecondOrderNode(i);
+  }
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::resizeSecondOrderNode(const std::size_t i) {
+  const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
+  if (so_models_[i] == model && so_datas_[i]) {
+    return;
+  }
+  const std::size_t nu = model->get_nu();
+  so_models_[i] = model;
+  so_datas_[i] = model->createData();
+  so_xs_[i].resize(nx_);
+  so_us_[i].resize(nu);
+  so_dx_[i] = VectorXs::Zero(ndx_);
+  so_grad_[i].resize(ndx_ + nu);
+  dynamics_hessians_[i] = MatrixXs::Zero(ndx_ + nu, ndx_ + nu);
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::shiftSecondOrderData() {
+  // The workspace moves along with the nodes, so the first one is recycled for
+  // the appended node
+  std::rotate(so_models_.begin(), so_models_.begin() + 1, so_models_.end());
+  std::rotate(so_datas_.begin(), so_datas_.begin() + 1, so_datas_.end());
+  std::rotate(so_xs_.begin(), so_xs_.begin() + 1, so_xs_.end());
+  std::rotate(so_us_.begin(), so_us_.begin() + 1, so_us_.end());
+  std::rotate(so_dx_.begin(), so_dx_.begin() + 1, so_dx_.end());
+  std::rotate(so_grad_.begin(), so_grad_.begin() + 1, so_grad_.end());
+  std::rotate(dynamics_hessians_.begin(), dynamics_hessians_.begin() + 1,
+              dynamics_hessians_.end());
+  resizeSecondOrderNode(T_ - 1);
+}
+
+template <typename Scalar>
+void ShootingProblemTpl<Scalar>::computeSecondOrderTerms(
+    const std::size_t i, const VectorXs& x, const VectorXs& u,
+    const VectorXs& lambda) {
+  const std::shared_ptr<ActionModelAbstract>& model = running_models_[i];
+  const std::shared_ptr<ActionDataAbstract>& data = running_datas_[i];
+  const std::shared_ptr<ActionDataAbstract>& data_h = so_datas_[i];
+  const std::size_t nu = model->get_nu();
+  VectorXs& xh = so_xs_[i];
+  VectorXs& uh = so_us_[i];
+  VectorXs& dx = so_dx_[i];
+  VectorXs& grad = so_grad_[i];
+  MatrixXs& H = dynamics_hessians_[i];
+  const Scalar eps =
+      std::sqrt(Scalar(2.) * std::numeric_limits<Scalar>::epsilon());
+
+  // Each column is the finite difference of the directional derivatives of
+  // the dynamics along the costate
+  grad.head(ndx_).noalias() = data->Fx.transpose() * lambda;
+  grad.tail(nu).noalias() = data->Fu.transpose() * lambda;
+  const Scalar hx = eps * std::max(Scalar(1.), x.norm());
+  for (std::size_t j = 0; j < ndx_; ++j) {
+    dx(j) = hx;
+    model->get_state()->integrate(x, dx, xh);
+    dx(j) = Scalar(0.);
+    model->calc(data_h, xh, u);
+    model->calcDiff(data_h, xh, u);
+    H.col(j).head(ndx_).noalias() = data_h->Fx.transpose() * lambda;
+    H.col(j).tail(nu).noalias() = data_h->Fu.transpose() * lambda;
+    H.col(j) -= grad;
+    H.col(j) /= hx;
+  }
+  const Scalar hu = eps * std::max(Scalar(1.), u.norm());
+  for (std::size_t j = 0; j < nu; ++j) {
+    uh = u;
+    uh(j) += hu;
+    model->calc(data_h, x, uh);
+    model->calcDiff(data_h, x, uh);
+    H.col(ndx_ + j).head(ndx_).noalias() = data_h->Fx.transpose() * lambda;
+    H.col(ndx_ + j).tail(nu).noalias() = data_h->Fu.transpose() * lambda;
+    H.col(ndx_ + j) -= grad;
+    H.col(ndx_ + j) /= hu;
+  }
+
+  // The finite differences are only symmetric up to the truncation error
+  const std::size_t nz = ndx_ + nu;
+  for (std::size_t c = 1; c < nz; ++c) {
+    for (std::size_t r = 0; r < c; ++r) {
+      const Scalar value = Scalar(0.5) * (H(r, c) + H(c, r));
+      H(r, c) = value;
+      H(c, r) = value;
+    }
+  }
+}
+
 template <typename Scalar>
 std::ostream& operator<<(std::ostream& os,
                          const ShootingProblemTpl<Scalar>& problem) {
@@ -11,12 +11,15 @@
 
 #include <boost/make_shared.hpp>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "crocoddyl/core/activation-base.hpp"
 #include "crocoddyl/core/cost-base.hpp"
 #include "crocoddyl/core/data-collector-base.hpp"
 #include "crocoddyl/core/fwd.hpp"
 #include "crocoddyl/core/state-base.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
 
 namespace crocoddyl {
 
@@ -55,6 +58,7 @@ class ResidualModelAbstractTpl {
   typedef typename MathBase::VectorXs VectorXs;
   typedef typename MathBase::MatrixXs MatrixXs;
   typedef typename MathBase::DiagonalMatrixXs DiagonalMatrixXs;
+  typedef std::vector<std::pair<std::size_t, std::size_t> > JacobianBlocks;
 
   /**
    * @brief Initialize the residual model
@@ -207,6 +211,29 @@ class ResidualModelAbstractTpl {
    */
   bool get_u_dependent() const;
 
+  /**
+   * @brief Return the column blocks of the state Jacobian that might be nonzero
+   *
+   * Each block is described by its first column and its number of columns in
+   * the tangent space of the state. The blocks are sorted and do not overlap.
+   * By default, they are defined by the q and v dependency of the residual
+   * function. The cost sum uses them to skip the structurally-zero terms of
+   * the cost derivatives.
+   */
+  const JacobianBlocks& get_Rx_blocks() const;
+
+  /**
+   * @brief Modify the column blocks of the state Jacobian that might be nonzero
+   *
+   * It allows residuals to declare a sparser Jacobian than the one defined by
+   * their q and v dependency (e.g., a frame placement only depends on the
+   * joints that support the frame). The columns outside these blocks must be
+   * zero in the residual and cost derivatives. Adjacent blocks are merged.
+   *
+   * @param[in] blocks  First column and number of columns of each block
+   */
+  void set_Rx_blocks(const JacobianBlocks& blocks);
+
   /**
    * @brief Print information on the residual model
    */
@@ -232,6 +259,11 @@ class ResidualModelAbstractTpl {
                       //!< on v
   bool u_dependent_;  //!< Label that indicates if the residual function depends
                       //!< on u
+  JacobianBlocks Rx_blocks_;  //!< Column blocks of the state Jacobian that
+                              //!< might be nonzero
+
+ private:
+  void initRxBlocks();
 };
 
 template <typename _Scalar>
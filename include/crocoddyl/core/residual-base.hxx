@@ -21,7 +21,9 @@ ResidualModelAbstractTpl<Scalar>::ResidualModelAbstractTpl(
       unone_(VectorXs::Zero(nu)),
       q_dependent_(q_dependent),
       v_dependent_(v_dependent),
-      u_dependent_(u_dependent) {}
+      u_dependent_(u_dependent) {
+  initRxBlocks();
+}
 
 template <typename Scalar>
 ResidualModelAbstractTpl<Scalar>::ResidualModelAbstractTpl(
@@ -33,7 +35,9 @@ ResidualModelAbstractTpl<Scalar>::ResidualModelAbstractTpl(
       unone_(VectorXs::Zero(state->get_nv())),
       q_dependent_(q_dependent),
       v_dependent_(v_dependent),
-      u_dependent_(u_dependent) {}
+      u_dependent_(u_dependent) {
+  initRxBlocks();
+}
 
 template <typename Scalar>
 ResidualModelAbstractTpl<Scalar>::~ResidualModelAbstractTpl() {}
@@ -67,7 +71,7 @@ std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelAbstractTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
   return std::allocate_shared<ResidualDataAbstract>(
-      Eigen::aligned_allocator<ResidualDataAbstract>(), this, data);
+      DataAllocator<ResidualDataAbstract>(), this, data);
 }
 
 template <typename Scalar>
@@ -116,6 +120,20 @@ void ResidualModelAbstractTpl<Scalar>::calcCostDiff(
   }
 }
 
+template <typename Scalar>
+void ResidualModelAbstractTpl<Scalar>::initRxBlocks() {
+  const std::size_t nv = state_->get_nv();
+  const std::size_t ndx = state_->get_ndx();
+  Rx_blocks_.clear();
+  if (q_dependent_ && v_dependent_) {
+    Rx_blocks_.push_back(std::make_pair(std::size_t(0), ndx));
+  } else if (q_dependent_) {
+    Rx_blocks_.push_back(std::make_pair(std::size_t(0), nv));
+  } else if (v_dependent_) {
+    Rx_blocks_.push_back(std::make_pair(ndx - nv, nv));
+  }
+}
+
 template <typename Scalar>
 void ResidualModelAbstractTpl<Scalar>::print(std::ostream& os) const {
   os << boost::core::demangle(typeid(*this).name());
@@ -152,6 +170,43 @@ bool ResidualModelAbstractTpl<Scalar>::get_u_dependent() const {
   return u_dependent_;
 }
 
+template <typename Scalar>
+const typename ResidualModelAbstractTpl<Scalar>::JacobianBlocks&
+ResidualModelAbstractTpl<Scalar>::get_Rx_blocks() const {
+  return Rx_blocks_;
+}
+
+template <typename Scalar>
+void ResidualModelAbstractTpl<Scalar>::set_Rx_blocks(
+    const JacobianBlocks& blocks) {
+  const std::size_t ndx = state_->get_ndx();
+  Rx_blocks_.clear();
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    const std::size_t start = blocks[i].first;
+    const std::size_t size = blocks[i].second;
+    if (start + size > ndx) {
+      throw_pretty("Invalid argument: "
+                   << "the block " + std::to_string(i) +
+                          " exceeds the state dimension (ndx=" +
+                          std::to_string(ndx) + ")");
+    }
+    if (size == 0) {
+      continue;
+    }
+    if (!Rx_blocks_.empty()) {
+      std::pair<std::size_t, std::size_t>& last = Rx_blocks_.back();
+      if (start < last.first + last.second) {
+        throw_pretty("Invalid argument: "
+                     << "the blocks have to be sorted and not overlapped");
+      } else if (start == last.first + last.second) {
+        last.second += size;
+        continue;
+      }
+    }
+    Rx_blocks_.push_back(std::make_pair(start, size));
+  }
+}
+
 template <typename Scalar>
 std::ostream& operator<<(std::ostream& os,
                          const ResidualModelAbstractTpl<Scalar>& model) {
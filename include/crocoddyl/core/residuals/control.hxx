@@ -86,7 +86,7 @@ ResidualModelControlTpl<Scalar>::createData(
     DataCollectorAbstract* const _data) {
   std::shared_ptr<ResidualDataAbstract> data =
       std::allocate_shared<ResidualDataAbstract>(
-          Eigen::aligned_allocator<ResidualDataAbstract>(), this, _data);
+          DataAllocator<ResidualDataAbstract>(), this, _data);
   data->Ru.diagonal().fill((Scalar)1.);
   return data;
 }
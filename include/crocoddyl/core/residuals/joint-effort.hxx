@@ -108,7 +108,7 @@ std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelJointEffortTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
   std::shared_ptr<ResidualDataAbstract> d =
-      std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this, data);
+      std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
   return d;
 }
 
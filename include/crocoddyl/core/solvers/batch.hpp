@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+#define CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+
+#include <string>
+#include <vector>
+
+#include "crocoddyl/core/solver-base.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Result of a problem solved within a batch
+ *
+ * It contains the convergence information of each solver after running
+ * `SolverBatch::solve()`. The optimal trajectories are stored in the solver
+ * itself (see `SolverAbstract::get_xs()` and `SolverAbstract::get_us()`).
+ */
+struct SolverBatchResult {
+  /**
+   * @brief Initialize the batch result structure
+   */
+  SolverBatchResult()
+      : is_converged(false),
+        iter(0),
+        cost(NAN),
+        stop(NAN),
+        ffeas(NAN),
+        preg(NAN) {}
+
+  bool is_converged;  //!< True if the solver has reached convergence
+  std::size_t iter;   //!< Number of iterations performed by the solver
+  double cost;        //!< Total cost of the optimal trajectory
+  double stop;        //!< Value computed by the stopping criteria
+  double ffeas;       //!< Feasibility of the dynamic constraints
+  double preg;        //!< Primal regularization value
+  std::string error;  //!< Message of the exception thrown by the solver (empty
+                      //!< if it has not failed)
+};
+
+/**
+ * @brief Batch solver for independent optimal control problems
+ *
+ * This class solves a set of independent shooting problems (e.g., different
+ * contact sequences, warm starts or initial states) with their own solvers.
+ * The parallelism is across problems instead of across nodes, i.e., each
+ * problem is solved by a single thread and the problems are dynamically
+ * scheduled on a pool of `nthreads` threads. To avoid nested parallel
+ * regions, the number of threads of each shooting problem, and the number of
+ * line-search and backward-pass threads of each DDP-family solver, are set to
+ * one while solving the batch, and they are restored afterwards. Restoring
+ * more than one line-search or backward-pass thread reallocates the
+ * solver's workspace, so it is cheaper to configure these solvers serially.
+ *
+ * Note that the solvers must not share their shooting problems. Additionally,
+ * the callbacks and the profiler are not thread-safe, so they should be
+ * disabled when solving the batch with more than one thread.
+ *
+ * \sa `solve()` and `get_results()`
+ */
+class SolverBatch {
+ public:
+  /**
+   * @brief Initialize the batch solver
+   *
+   * By default, it uses `CROCODDYL_WITH_NTHREADS` threads if multithreading
+   * support is enabled.
+   *
+   * @param[in] solvers  solvers of each problem
+   */
+  explicit SolverBatch(
+      const std::vector<std::shared_ptr<SolverAbstract> >& solvers);
+  virtual ~SolverBatch();
+
+  /**
+   * @brief Solve all the problems of the batch
+   *
+   * Each solver computes its optimal trajectory as described in
+   * `SolverAbstract::solve()`. The exceptions thrown by a solver do not stop
+   * the batch; instead, they are reported in its result.
+   *
+   * @param[in] init_xs      initial guess for the state trajectory of each
+   * problem (empty if not warm started)
+   * @param[in] init_us      initial guess for the control trajectory of each
+   * problem (empty if not warm started)
+   * @param[in] maxiter      maximum allowed number of iterations (default 100)
+   * @param[in] is_feasible  true if the init_xs are obtained from integrating
+   * the init_us (rollout) (default false)
+   * @param[in] init_reg     initial guess for the regularization value
+   * @return true if all the problems have reached convergence
+   */
+  bool solve(const std::vector<std::vector<Eigen::VectorXd> >& init_xs =
+                 std::vector<std::vector<Eigen::VectorXd> >(),
+             const std::vector<std::vector<Eigen::VectorXd> >& init_us =
+                 std::vector<std::vector<Eigen::VectorXd> >(),
+             const std::size_t maxiter = 100, const bool is_feasible = false,
+             const double init_reg = NAN);
+
+  /**
+   * @brief Return the solvers of each problem
+   */
+  const std::vector<std::shared_ptr<SolverAbstract> >& get_solvers() const;
+
+  /**
+   * @brief Return the result of each problem
+   */
+  const std::vector<SolverBatchResult>& get_results() const;
+
+  /**
+   * @brief Return the number of threads used to solve the batch
+   */
+  std::size_t get_nthreads() const;
+
+  /**
+   * @brief Modify the solvers of each problem
+   */
+  void set_solvers(
+      const std::vector<std::shared_ptr<SolverAbstract> >& solvers);
+
+  /**
+   * @brief Modify the number of threads used to solve the batch
+   *
+   * If `nthreads` is lower than one, then it uses `CROCODDYL_WITH_NTHREADS`.
+   *
+   * @param[in] nthreads  number of threads
+   */
+  void set_nthreads(const int nthreads);
+
+ protected:
+  std::vector<std::shared_ptr<SolverAbstract> >
+      solvers_;  //!< Solvers of each problem
+  std::vector<SolverBatchResult> results_;  //!< Result of each problem
+  std::vector<std::size_t>
+      problem_nthreads_;  //!< Number of threads of each shooting problem
+  std::vector<std::size_t>
+      ls_nthreads_;  //!< Number of line-search threads of each solver
+  std::vector<std::size_t>
+      bp_nthreads_;  //!< Number of backward-pass threads of each solver
+  std::size_t nthreads_;  //!< Number of threads used to solve the batch
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_SOLVERS_BATCH_HPP_
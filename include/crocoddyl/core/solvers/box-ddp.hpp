@@ -26,7 +26,12 @@ class SolverBoxDDP : public SolverDDP {
 
   virtual void allocateData();
   virtual void computeGains(const std::size_t t);
-  virtual void forwardPass(const double steplength);
+  virtual bool isRiccatiStepParallelizable(const std::size_t t) const;
+  virtual double computeRollout(
+      const double steplength, std::vector<Eigen::VectorXd>& xs_try,
+      std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+      const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+      const std::shared_ptr<ActionDataAbstract>& data_T);
   virtual void resizeData();
 
   const std::vector<Eigen::MatrixXd>& get_Quu_inv() const;
@@ -36,6 +41,9 @@ class SolverBoxDDP : public SolverDDP {
   std::vector<Eigen::MatrixXd> Quu_inv_;
   std::vector<Eigen::VectorXd> du_lb_;
   std::vector<Eigen::VectorXd> du_ub_;
+  std::vector<std::vector<std::size_t> >
+      clamped_idx_;  //!< Clamped indexes of the box QP at each node, used
+                     //!< to warm-start the next iteration
 };
 
 }  // namespace crocoddyl
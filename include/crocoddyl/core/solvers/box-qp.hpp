@@ -25,6 +25,11 @@ namespace crocoddyl {
  *  - the optimal decision vector
  *  - the indexes for the free space
  *  - the indexes for the clamped (constrained) space
+ *
+ * The inverse of the free space Hessian is stored in the top-left block of a
+ * matrix with the dimension of the decision vector. The dimension of this
+ * block is the number of free indexes. This avoids reallocating the matrix
+ * when the free space changes.
  */
 struct BoxQPSolution {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -47,7 +52,14 @@ struct BoxQPSolution {
                 const std::vector<size_t>& clamped_idx)
       : Hff_inv(Hff_inv), x(x), free_idx(free_idx), clamped_idx(clamped_idx) {}
 
-  Eigen::MatrixXd Hff_inv;          //!< Inverse of the free space Hessian
+  /**
+   * @brief Inverse of the free space Hessian
+   *
+   * Note that this matrix has the dimension of the decision vector, and the
+   * inverse is stored in its top-left block of dimension `free_idx.size()`.
+   * Callers that read the whole matrix have to use this block instead.
+   */
+  Eigen::MatrixXd Hff_inv;
   Eigen::VectorXd x;                //!< Decision vector
   std::vector<size_t> free_idx;     //!< Free space indexes
   std::vector<size_t> clamped_idx;  //!< Clamped space indexes
@@ -70,7 +82,11 @@ struct BoxQPSolution {
  * The algorithm procees by iteratively identifying the active bounds, and then
  * performing a projected Newton step in the free sub-space.
  * The projection uses the Hessian of the free sub-space and is computed
- * efficiently using a Cholesky decomposition.
+ * efficiently using a Cholesky decomposition. This decomposition is kept
+ * across the iterations, and it is updated through rank-1 up/downdates when a
+ * single index enters or leaves the free sub-space.
+ * The solver can be warm-started from the active set of a previous solution,
+ * and the inverse of the free space Hessian is only formed when requested.
  * It uses a line search procedure with polynomial step length values in a
  * backtracking fashion.
  * The steps are checked using an Armijo condition together L2-norm gradient.
@@ -117,6 +133,41 @@ class BoxQP {
                              const Eigen::VectorXd& ub,
                              const Eigen::VectorXd& xinit);
 
+  /**
+   * @brief Compute the solution of bound-constrained QP based on Newton
+   * projection warm-started from a previous active set
+   *
+   * The indexes of `clamped_init` are moved to the bound defined by the sign
+   * of the gradient at `xinit`, which usually recovers the active set of a
+   * previous solution of a similar problem (e.g., the same node in the
+   * previous iteration).
+   *
+   * @param[in] H             Hessian (dimension nx * nx)
+   * @param[in] q             Gradient (dimension nx)
+   * @param[in] lb            Lower bound (dimension nx)
+   * @param[in] ub            Upper bound (dimension nx)
+   * @param[in] xinit         Initial guess (dimension nx)
+   * @param[in] clamped_init  Initial clamped (constrained) indexes
+   * @return The solution of the problem
+   */
+  const BoxQPSolution& solve(const Eigen::MatrixXd& H, const Eigen::VectorXd& q,
+                             const Eigen::VectorXd& lb,
+                             const Eigen::VectorXd& ub,
+                             const Eigen::VectorXd& xinit,
+                             const std::vector<std::size_t>& clamped_init);
+
+  /**
+   * @brief Solve the system defined by the free space Hessian
+   *
+   * It uses the Cholesky decomposition of the last solution to compute
+   * \f$\mathbf{H}_{ff}^{-1}\mathbf{B}\f$ in place, where the number of rows
+   * of \f$\mathbf{B}\f$ is the number of free indexes. This avoids forming the
+   * inverse of the free space Hessian.
+   *
+   * @param[in,out] B  Right-hand side, and then solution, of the system
+   */
+  void solveFreeInPlace(Eigen::Ref<Eigen::MatrixXd> B) const;
+
   /**
    * @brief Return the stored solution
    */
@@ -152,6 +203,11 @@ class BoxQP {
    */
   const std::vector<double>& get_alphas() const;
 
+  /**
+   * @brief Return true if the inverse of the free space Hessian is computed
+   */
+  bool get_compute_inverse() const;
+
   /**
    * @brief Modify the decision vector dimension
    */
@@ -182,7 +238,53 @@ class BoxQP {
    */
   void set_alphas(const std::vector<double>& alphas);
 
+  /**
+   * @brief Modify the flag that enables the computation of the inverse of the
+   * free space Hessian
+   */
+  void set_compute_inverse(const bool compute_inverse);
+
  private:
+  /**
+   * @brief Update the Cholesky decomposition of the free space Hessian
+   *
+   * It refactorizes the free space Hessian when the free indexes differ by
+   * more than one index from the ones used by the current decomposition, or
+   * when an up/downdate breaks down.
+   */
+  void updateFactorization(const Eigen::MatrixXd& H);
+
+  /**
+   * @brief Add a free index to the Cholesky decomposition
+   *
+   * @param[in] H  Hessian
+   * @param[in] p  Position of the new index in the free indexes
+   * @return true if the decomposition remains positive definite
+   */
+  bool addFreeIndex(const Eigen::MatrixXd& H, const std::size_t p);
+
+  /**
+   * @brief Remove a free index from the Cholesky decomposition
+   *
+   * @param[in] p  Position of the removed index in the factorized indexes
+   */
+  void removeFreeIndex(const std::size_t p);
+
+  /**
+   * @brief Compute a rank-1 up/downdate of a block of the Cholesky
+   * decomposition
+   *
+   * The vector is stored in the block segment of `w_`, and it is
+   * overwritten.
+   *
+   * @param[in] k0     First row/column of the block
+   * @param[in] n      Dimension of the block
+   * @param[in] sigma  Sign of the rank-1 modification (1 or -1)
+   * @return true if the decomposition remains positive definite
+   */
+  bool rankUpdate(const std::size_t k0, const std::size_t n,
+                  const double sigma);
+
   std::size_t nx_;          //!< Decision variable dimension
   BoxQPSolution solution_;  //!< Solution of the Box QP
   std::size_t maxiter_;     //!< Allowed maximum number of iterations
@@ -190,6 +292,8 @@ class BoxQP {
   double
       th_grad_;  //!< Tolerance for stopping the algorithm (gradient threshold)
   double reg_;   //!< Current regularization value
+  bool compute_inverse_;  //!< Flag to compute the inverse of the free space
+                          //!< Hessian
 
   double fold_;     //!< Cost of previous iteration
   double fnew_;     //!< Cost of current iteration
@@ -202,14 +306,17 @@ class BoxQP {
   Eigen::VectorXd g_;     //!< Current gradient
   Eigen::VectorXd dx_;    //!< Current search direction
 
-  Eigen::VectorXd xo_;  //!< Organized decision
   Eigen::VectorXd
       dxo_;  //!< Search direction organized by free and constrained subspaces
   Eigen::VectorXd
       qo_;  //!< Gradient organized by free and constrained subspaces
-  Eigen::MatrixXd Ho_;  //!< Hessian organized by free and constrained subspaces
-
-  Eigen::LLT<Eigen::MatrixXd> Hff_inv_llt_;  //!< Cholesky solver
+  Eigen::VectorXd Hx_;  //!< Product between the Hessian and a decision vector
+  Eigen::MatrixXd Lff_;  //!< Cholesky decomposition of the free space Hessian
+                         //!< (lower triangular part of its top-left block)
+  Eigen::VectorXd w_;    //!< Vector used by the decomposition updates
+  std::vector<std::size_t>
+      factor_idx_;     //!< Free indexes of the current decomposition
+  bool factor_valid_;  //!< True if the decomposition matches the Hessian
 };
 
 }  // namespace crocoddyl
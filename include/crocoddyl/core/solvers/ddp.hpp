@@ -11,6 +11,7 @@
 #define CROCODDYL_CORE_SOLVERS_DDP_HPP_
 
 #include <Eigen/Cholesky>
+#include <Eigen/LU>
 #include <vector>
 
 #include "crocoddyl/core/mathbase.hpp"
@@ -83,7 +84,11 @@ class SolverDDP : public SolverAbstract {
    * problem
    *
    * These derivatives are computed around the guess state and control
-   * trajectory. These trajectory can be set by using `setCandidate()`.
+   * trajectory. These trajectory can be set by using `setCandidate()`. If the
+   * second-order terms of the problem are enabled (see
+   * `ShootingProblem::set_second_order()`), then it also computes the
+   * contractions of the dynamics Hessians with the gradients of the Value
+   * function of the last backward pass.
    *
    * @return the total cost around the guess trajectory
    */
@@ -120,9 +125,76 @@ class SolverDDP : public SolverAbstract {
    * \f$V_{\mathbf{x}_{k+1}}\f$ and \f$V_{\mathbf{xx}_{k+1}}\f$ defines the
    * linear-quadratic approximation of the Value function, and
    * \f$\mathbf{\bar{f}}_{k+1}\f$ describes the gaps of the dynamics.
+   *
+   * If the second-order terms of the problem are enabled, then the Hessians
+   * of the control Hamiltonian also include the contractions
+   * \f$\nabla^2_{\mathbf{z}\mathbf{z}}(V_{\mathbf{x}_{k+1}}^\top
+   * \mathbf{f}_k)\f$ computed in `calcDiff()` (i.e., the solver runs the full
+   * DDP instead of iLQR).
+   *
+   * If `bp_nthreads` is higher than one, then it runs the parallel-in-time
+   * backward pass described in `backwardPassParallel()`. If `bp_fixed_size`
+   * is enabled, then the Riccati steps use compile-time dimensions (see
+   * `set_bp_fixed_size()`). Both options are ignored when the second-order
+   * terms are enabled.
    */
   virtual void backwardPass();
 
+  /**
+   * @brief Run the parallel-in-time backward pass
+   *
+   * The Riccati step of each node is described as an element
+   * \f$(\mathbf{A}_k,\mathbf{b}_k,\mathbf{C}_k,\boldsymbol{\eta}_k,
+   * \mathbf{J}_k)\f$ of an associative operator that maps the state and the
+   * costate of its boundaries, i.e., \f{eqnarray*}
+   *   \delta\mathbf{x}_{k+1} &=& \mathbf{A}_k\delta\mathbf{x}_k +
+   * \mathbf{b}_k - \mathbf{C}_k\boldsymbol{\lambda}_{k+1},\\
+   *   \boldsymbol{\lambda}_k &=& \mathbf{J}_k\delta\mathbf{x}_k -
+   * \boldsymbol{\eta}_k + \mathbf{A}_k^\top\boldsymbol{\lambda}_{k+1},
+   * \f} with \f$\mathbf{A}_k = \mathbf{f}_{\mathbf{x}_k} -
+   * \mathbf{f}_{\mathbf{u}_k}\mathbf{l}_{\mathbf{uu}_k}^{-1}
+   * \mathbf{l}_{\mathbf{ux}_k}\f$ and \f$\mathbf{C}_k =
+   * \mathbf{f}_{\mathbf{u}_k}\mathbf{l}_{\mathbf{uu}_k}^{-1}
+   * \mathbf{f}_{\mathbf{u}_k}^\top\f$ (for more details, see S. Sarkka and
+   * A. F. Garcia-Fernandez, "Temporal Parallelization of Dynamic Programming
+   * and Linear Quadratic Control"). The horizon is partitioned into
+   * `bp_nthreads` chunks that combine their elements in parallel. Then, the
+   * Value functions at the chunk boundaries are stitched together serially,
+   * and each chunk computes its Value functions and gains in parallel. The
+   * nodes whose Riccati step cannot be described by this operator (see
+   * `isRiccatiStepParallelizable()`) are handled within the serial stitching.
+   *
+   * @return false if `bp_nthreads` is not higher than one (i.e., there are no
+   * workspaces) or if the elements cannot be built (i.e., the regularized
+   * control Hessian \f$\mathbf{l}_{\mathbf{uu}_k}\f$ is not positive
+   * definite), in which case the serial backward pass should be used
+   */
+  bool backwardPassParallel();
+
+  /**
+   * @brief Indicate if the Riccati step of a node can be computed by the
+   * parallel backward pass
+   *
+   * This is the case when the Value function is updated through the
+   * unconstrained Riccati step described in `backwardPass()`. Solvers that
+   * modify this step (e.g., with box constraints) need to override this
+   * function.
+   *
+   * @param[in] t  Time instance
+   */
+  virtual bool isRiccatiStepParallelizable(const std::size_t t) const;
+
+  /**
+   * @brief Indicate if the line search can roll out several step lengths
+   * concurrently
+   *
+   * The concurrent rollouts run `computeRollout()` and only compute the cost
+   * of the trial trajectories. Solvers that override `tryStep()` or the
+   * line-search loop (e.g., with a merit function) need to override this
+   * function, so that `set_ls_nthreads()` keeps the serial line search.
+   */
+  virtual bool isLineSearchParallelizable() const;
+
   /**
    * @brief Run the forward pass or rollout
    *
@@ -138,6 +210,29 @@ class SolverDDP : public SolverAbstract {
    */
   virtual void forwardPass(const double stepLength);
 
+  /**
+   * @brief Run the forward pass into a given line-search workspace
+   *
+   * This function rollouts the policy as described in `forwardPass()`, but it
+   * writes the trial trajectory and the action data into the containers passed
+   * as arguments instead of the solver and problem ones. This allows us to
+   * rollout several step lengths concurrently (see `set_ls_nthreads()`). Note
+   * that this function must not modify any internal variable of the solver.
+   *
+   * @param[in] stepLength  applied step length (\f$0\leq\alpha\leq1\f$)
+   * @param[out] xs_try     trial state trajectory (size \f$T+1\f$)
+   * @param[out] us_try     trial control trajectory (size \f$T\f$)
+   * @param[out] dx         state error along the rollout (size \f$T\f$)
+   * @param[in] datas       running action datas used in the rollout
+   * @param[in] data_T      terminal action data used in the rollout
+   * @return the total cost of the trial trajectory
+   */
+  virtual double computeRollout(
+      const double stepLength, std::vector<Eigen::VectorXd>& xs_try,
+      std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+      const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+      const std::shared_ptr<ActionDataAbstract>& data_T);
+
   /**
    * @brief Compute the linear-quadratic approximation of the control
    * Hamiltonian function
@@ -178,6 +273,32 @@ class SolverDDP : public SolverAbstract {
    */
   virtual void computeGains(const std::size_t t);
 
+  /**
+   * @brief Try the i-th step length of the line-search procedure
+   *
+   * If the line search runs in parallel, then the first step length of each
+   * batch rolls out the next `ls_nthreads` step lengths concurrently, while
+   * the remaining ones only retrieve their results from the line-search
+   * workspaces. Otherwise, it simply runs `tryStep()`. Note that the
+   * concurrent rollouts call `computeRollout()` instead of `tryStep()` (see
+   * `isLineSearchParallelizable()`).
+   *
+   * @param[in] i  index of the step length in `alphas_`
+   * @return the cost reduction along the trial trajectory
+   */
+  double tryLineSearchStep(const std::size_t i);
+
+  /**
+   * @brief Update the problem data after accepting a step length
+   *
+   * The problem data keeps the rollout of the first line-search workspace. If
+   * the accepted step length was rolled out in another workspace, then it
+   * computes the problem data along the accepted trajectory. In consequence,
+   * the stopping criteria, callbacks and returned solution are consistent with
+   * the problem data.
+   */
+  void acceptLineSearchStep();
+
   /**
    * @brief Increase the state and control regularization values by a
    * `regfactor_` factor
@@ -195,6 +316,21 @@ class SolverDDP : public SolverAbstract {
    */
   virtual void allocateData();
 
+  /**
+   * @brief Allocate the workspaces used by the parallel line search
+   *
+   * Each workspace has its own trial trajectory and its own set of action
+   * datas. The action datas are created only for the nodes whose action model
+   * has changed since the last call.
+   */
+  void resizeLineSearchData();
+
+  /**
+   * @brief Allocate the Riccati elements and workspaces used by the parallel
+   * backward pass
+   */
+  void resizeBackwardPassData();
+
   /**
    * @brief Return the regularization factor used to increase the damping value
    */
@@ -228,6 +364,22 @@ class SolverDDP : public SolverAbstract {
    */
   const std::vector<double>& get_alphas() const;
 
+  /**
+   * @brief Return the number of step lengths rolled out concurrently by the
+   * line-search procedure
+   */
+  std::size_t get_ls_nthreads() const;
+
+  /**
+   * @brief Return the number of threads used by the backward pass
+   */
+  std::size_t get_bp_nthreads() const;
+
+  /**
+   * @brief Indicate if the backward pass uses the fixed-size Riccati step
+   */
+  bool get_bp_fixed_size() const;
+
   /**
    * @brief Return the step-length threshold used to decrease regularization
    */
@@ -327,6 +479,53 @@ class SolverDDP : public SolverAbstract {
    */
   void set_alphas(const std::vector<double>& alphas);
 
+  /**
+   * @brief Modify the number of step lengths rolled out concurrently by the
+   * line-search procedure
+   *
+   * Each batch of step lengths is rolled out on separate threads, and the
+   * solver accepts the largest step length that satisfies the acceptance
+   * criteria. By default, the line search runs serially (i.e., one thread). If
+   * `nthreads` is lower than one, then it uses `CROCODDYL_WITH_NTHREADS`. The
+   * line search also runs serially if multithreading support is not enabled,
+   * or if the solver does not support it (see `isLineSearchParallelizable()`).
+   *
+   * @param[in] nthreads  number of threads
+   */
+  void set_ls_nthreads(const int nthreads);
+
+  /**
+   * @brief Modify the number of threads used by the backward pass
+   *
+   * If `nthreads` is higher than one, then the horizon is partitioned into
+   * `nthreads` chunks and the backward pass runs in parallel (see
+   * `backwardPassParallel()`). By default, the backward pass runs serially
+   * (i.e., one thread). If `nthreads` is lower than one, then it uses
+   * `CROCODDYL_WITH_NTHREADS`.
+   *
+   * @param[in] nthreads  number of threads
+   */
+  void set_bp_nthreads(const int nthreads);
+
+  /**
+   * @brief Modify the use of the fixed-size Riccati step
+   *
+   * The fixed-size Riccati step computes the linear-quadratic approximations
+   * of the control Hamiltonian and Value functions, and the gains, with
+   * matrices of compile-time dimensions. This avoids the dynamic allocations
+   * and loops of small problems, whose Riccati step is otherwise dominated by
+   * this overhead. It is used when every running model has the same control
+   * dimension, and the pair \f$(n_{dx},n_u)\f$ is one of the instantiated
+   * ones: (2,1), (3,2), (4,2), (8,4), (12,4), (12,6) and (14,7). Otherwise,
+   * or for the nodes whose Riccati step is modified by the solver (see
+   * `isRiccatiStepParallelizable()`), the dynamic-size Riccati step is used.
+   * Note that this step does not call `computeActionValueFunction()`,
+   * `computeGains()` and `computeValueFunction()`. By default, it is disabled.
+   *
+   * @param[in] fixed_size  true for using the fixed-size Riccati step
+   */
+  void set_bp_fixed_size(const bool fixed_size);
+
   /**
    * @brief Modify the step-length threshold used to decrease regularization
    */
@@ -394,12 +593,76 @@ class SolverDDP : public SolverAbstract {
               //!< running node
   std::vector<double>
       alphas_;      //!< Set of step lengths using by the line-search procedure
+  std::size_t ls_nthreads_;  //!< Number of step lengths rolled out concurrently
+                             //!< by the line-search procedure
+  bool ls_recalc_;  //!< Indicates that the last step length was rolled out in
+                    //!< a line-search workspace, so the problem data needs to
+                    //!< be recomputed if it is accepted
+  std::vector<std::vector<Eigen::VectorXd> >
+      ls_xs_try_;  //!< State trajectory of each line-search workspace
+  std::vector<std::vector<Eigen::VectorXd> >
+      ls_us_try_;  //!< Control trajectory of each line-search workspace
+  std::vector<std::vector<Eigen::VectorXd> >
+      ls_dx_;  //!< State error of each line-search workspace
+  std::vector<std::vector<std::shared_ptr<ActionDataAbstract> > >
+      ls_datas_;  //!< Action datas (running and terminal) of each line-search
+                  //!< workspace
+  std::vector<std::shared_ptr<ActionModelAbstract> >
+      ls_models_;  //!< Action models used to create the line-search datas
+  std::vector<double>
+      ls_cost_try_;  //!< Total cost computed by each line-search workspace
+  std::size_t bp_nthreads_;  //!< Number of threads used by the backward pass
+  std::vector<std::pair<std::size_t, std::size_t> >
+      bp_chunks_;  //!< First and past-the-end nodes of each chunk used by the
+                   //!< parallel backward pass
+  std::vector<Eigen::MatrixXd>
+      bp_A_;  //!< Riccati element \f$\mathbf{A}\f$ per each running node
+  std::vector<Eigen::VectorXd>
+      bp_b_;  //!< Riccati element \f$\mathbf{b}\f$ per each running node
+  std::vector<Eigen::MatrixXd>
+      bp_C_;  //!< Riccati element \f$\mathbf{C}\f$ per each running node
+  std::vector<Eigen::VectorXd> bp_eta_;  //!< Riccati element
+                                         //!< \f$\boldsymbol{\eta}\f$ per
+                                         //!< each running node
+  std::vector<Eigen::MatrixXd>
+      bp_J_;  //!< Riccati element \f$\mathbf{J}\f$ per each running node
+  std::vector<Eigen::PartialPivLU<Eigen::MatrixXd> >
+      bp_lu_;  //!< LU solver per each backward-pass thread
+  std::vector<Eigen::MatrixXd>
+      bp_MA_;  //!< Temporary variable per each backward-pass thread
+  std::vector<Eigen::MatrixXd>
+      bp_MC_;  //!< Temporary variable per each backward-pass thread
+  std::vector<Eigen::MatrixXd>
+      bp_tmp_;  //!< Temporary variable per each backward-pass thread
+  std::vector<MatrixXdRowMajor>
+      bp_FxTVxx_;  //!< Store the value of
+                   //!< \f$\mathbf{f_x}^T\mathbf{V_{xx}}^{'}\f$ per each
+                   //!< backward-pass thread
+  std::vector<Eigen::VectorXd>
+      bp_v_;  //!< Temporary variable per each backward-pass thread
+  std::vector<Eigen::VectorXd>
+      bp_w_;  //!< Temporary variable per each backward-pass thread
+  bool bp_fixed_size_;  //!< Indicates the use of the fixed-size Riccati step
+  void (SolverDDP::*bp_fixed_step_)(
+      const std::size_t);  //!< Fixed-size Riccati step that matches the
+                           //!< problem dimensions (NULL if none)
   double th_grad_;  //!< Tolerance of the expected gradient used for testing the
                     //!< step
   double
       th_stepdec_;  //!< Step-length threshold used to decrease regularization
   double
       th_stepinc_;  //!< Step-length threshold used to increase regularization
+
+ private:
+  void computeBackwardPassStep(const std::size_t t);
+  bool computeRiccatiElement(const std::size_t t);
+  void combineRiccatiElements(const std::size_t t, const std::size_t k);
+  void computeRiccatiValueFunction(const std::size_t t, const std::size_t e,
+                                   const std::size_t k);
+  bool computeRiccatiGains(const std::size_t t, const std::size_t k);
+  template <int NDX, int NU>
+  void computeFixedSizeBackwardPassStep(const std::size_t t);
+  void updateFixedSizeBackwardPassStep();
 };
 
 }  // namespace crocoddyl
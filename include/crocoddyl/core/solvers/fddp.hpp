@@ -93,7 +93,18 @@ class SolverFDDP : public SolverDDP {
    * @brief Update internal values for computing the expected improvement
    */
   void updateExpectedImprovement();
-  virtual void forwardPass(const double stepLength);
+
+  /**
+   * @copybrief SolverDDP::computeRollout
+   *
+   * The rollout keeps the gaps \f$\mathbf{\bar{f}}_s\f$ open according to
+   * the applied step length as described in `SolverFDDP`.
+   */
+  virtual double computeRollout(
+      const double stepLength, std::vector<Eigen::VectorXd>& xs_try,
+      std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+      const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+      const std::shared_ptr<ActionDataAbstract>& data_T);
 
   /**
    * @brief Return the threshold used for accepting step along ascent direction
@@ -41,6 +41,8 @@ class SolverIntro : public SolverFDDP {
   virtual void computeValueFunction(
       const std::size_t t, const std::shared_ptr<ActionModelAbstract>& model);
   virtual void computeGains(const std::size_t t);
+  virtual bool isRiccatiStepParallelizable(const std::size_t t) const;
+  virtual bool isLineSearchParallelizable() const;
 
   /**
    * @brief Return the type of solver used for handling the equality constraints
@@ -157,6 +159,18 @@ class SolverIntro : public SolverFDDP {
   void set_zero_upsilon(const bool zero_upsilon);
 
  protected:
+  /**
+   * @brief Resize the reduced Hamiltonian of a node
+   *
+   * Its dimension is the nullity of \f$\mathbf{H_u}\f$ for the nullspace
+   * solvers, and the number of equality constraints for the Schur complement.
+   * The memory is only reallocated when this dimension changes.
+   *
+   * @param[in] t   node index
+   * @param[in] nz  dimension of the reduced Hamiltonian
+   */
+  void resizeReducedHamiltonian(const std::size_t t, const std::size_t nz);
+
   enum EqualitySolverType
       eq_solver_;   //!< Strategy used for handling the equality constraints
   double th_feas_;  //!< Threshold for switching to feasibility
@@ -205,6 +219,13 @@ class SolverIntro : public SolverFDDP {
   std::vector<Eigen::PartialPivLU<Eigen::MatrixXd> >
       Hy_lu_;  //!< Partial-pivot LU solvers used for computing the feedforward
                //!< and feedback gain related to the equality constraint
+  std::vector<Eigen::MatrixXd>
+      Hu_ker_tmp_;  //!< Trapezoid matrices used for computing the nullspace
+                    //!< from the full-pivot LU decomposition
+  std::vector<Eigen::VectorXi>
+      Hu_pivots_;  //!< Nonnegligible pivots of the full-pivot LU decomposition
+  std::vector<Eigen::VectorXd>
+      Hu_qr_ws_;  //!< Workspaces used for evaluating the Householder sequence
 };
 
 }  // namespace crocoddyl
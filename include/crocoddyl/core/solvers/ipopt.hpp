@@ -63,6 +63,35 @@ class SolverIpopt : public SolverAbstract {
 
   void set_th_stop(const double th_stop);
 
+  /**
+   * @brief Return true if the sparsity detection of the NLP derivatives is
+   * enabled
+   */
+  bool get_sparsity_detection() const;
+
+  /**
+   * @brief Modify the flag that enables the sparsity detection of the NLP
+   * derivatives
+   *
+   * \sa `IpoptInterface::detectSparsity()`
+   */
+  void set_sparsity_detection(const bool sparsity_detection);
+
+  /**
+   * @brief Return the type of Hessian of the Lagrangian
+   */
+  IpoptHessianType get_hessian_type() const;
+
+  /**
+   * @brief Modify the type of Hessian of the Lagrangian
+   *
+   * The `LimitedMemoryHessian` type runs %Ipopt with its limited-memory
+   * (L-BFGS) Hessian approximation, so the Hessian is never requested.
+   *
+   * \sa `IpoptHessianType`
+   */
+  void set_hessian_type(const IpoptHessianType hessian_type);
+
  private:
   Ipopt::SmartPtr<IpoptInterface> ipopt_iface_;
   Ipopt::SmartPtr<Ipopt::IpoptApplication> ipopt_app_;
@@ -20,6 +20,18 @@ namespace crocoddyl {
 
 struct IpoptInterfaceData;
 
+/**
+ * @brief Hessian of the Lagrangian used by IpoptInterface
+ *
+ *  - `FullHessian`: the cost Hessians of the action models are used. They are
+ *    computed by the same `calcDiff()` as the gradient, so a Hessian request
+ *    at the point of the last gradient evaluation does not evaluate the
+ *    action models again
+ *  - `LimitedMemoryHessian`: %Ipopt approximates the Hessian with L-BFGS
+ *    updates, and the Hessian is never requested
+ */
+enum IpoptHessianType { FullHessian = 0, LimitedMemoryHessian };
+
 /**
  * @brief Class for interfacing a crocoddyl::ShootingProblem with IPOPT
  *
@@ -54,6 +66,17 @@ struct IpoptInterfaceData;
  * Initial condition: \f$ \mathbf{x}(0) \ominus (\mathbf{x}_{k}^0 \oplus
  * \mathbf{\Delta x}_{k}) = \mathbf{0}\f$
  *
+ * By default, the Jacobian of the constraints and the Hessian of the Lagrangian
+ * are reported as dense per-node blocks. With sparsity detection enabled, their
+ * nonzero pattern is detected once, and only these entries are passed to
+ * %Ipopt. This reduces the cost of its sparse factorizations (e.g., MA27 or
+ * MUMPS), since multibody dynamics have many structural zeros.
+ *
+ * The derivatives of the action models are computed once per point, and they
+ * are shared by the gradient, Jacobian and Hessian evaluations. The type of
+ * Hessian (`IpoptHessianType`) defines how the Hessian of the Lagrangian is
+ * obtained.
+ *
  * Documentation of the methods has been extracted from Ipopt::TNLP.hpp file
  *
  *  \sa `get_nlp_info()`, `get_bounds_info()`, `eval_f()`, `eval_g()`,
@@ -421,6 +444,17 @@ class IpoptInterface : public Ipopt::TNLP {
 
   void resizeData();
 
+  /**
+   * @brief Detect the sparsity pattern of the NLP derivatives
+   *
+   * It evaluates the constraint Jacobian and the Lagrangian Hessian at random
+   * points around the current guess, and keeps the entries that are nonzero in
+   * any of these points. The pattern is then reported to %Ipopt instead of the
+   * dense per-node blocks. This method is called by `get_nlp_info()` when the
+   * sparsity detection is enabled.
+   */
+  void detectSparsity();
+
   /**
    * @brief Return the total number of optimization variables (states and
    * controls)
@@ -449,6 +483,16 @@ class IpoptInterface : public Ipopt::TNLP {
 
   double get_cost() const;
 
+  /**
+   * @brief Return true if the sparsity detection is enabled
+   */
+  bool get_sparsity_detection() const;
+
+  /**
+   * @brief Return the type of Hessian of the Lagrangian
+   */
+  IpoptHessianType get_hessian_type() const;
+
   /**
    * @brief Modify the state vector
    */
@@ -459,6 +503,24 @@ class IpoptInterface : public Ipopt::TNLP {
    */
   void set_us(const std::vector<Eigen::VectorXd>& us);
 
+  /**
+   * @brief Modify the flag that enables the sparsity detection
+   *
+   * Note that the detected pattern misses the entries that are zero at all the
+   * sampled points, e.g., the Hessian of costs with dead zones. Do not enable
+   * it for these problems. In debug mode, `eval_jac_g()` and `eval_h()` check
+   * that no derivative is nonzero outside the detected pattern.
+   */
+  void set_sparsity_detection(const bool sparsity_detection);
+
+  /**
+   * @brief Modify the type of Hessian of the Lagrangian
+   *
+   * Note that `LimitedMemoryHessian` also requires to set the %Ipopt option
+   * `hessian_approximation` to `limited-memory`, which is done by SolverIpopt.
+   */
+  void set_hessian_type(const IpoptHessianType hessian_type);
+
  private:
   std::shared_ptr<crocoddyl::ShootingProblem>
       problem_;                      //!< Optimal control problem
@@ -469,6 +531,11 @@ class IpoptInterface : public Ipopt::TNLP {
   std::size_t nconst_;               //!< Number of the NLP constraints
   std::vector<std::shared_ptr<IpoptInterfaceData>> datas_;  //!< Vector of Datas
   double cost_;                                             //!< Total cost
+  bool sparsity_detection_;  //!< Flag to enable the sparsity detection
+  bool sparsity_detected_;   //!< True if the sparsity pattern is detected
+  IpoptHessianType hessian_type_;  //!< Type of Hessian of the Lagrangian
+  bool diff_computed_;  //!< True if the derivatives of the action models are
+                        //!< computed at the current point
 
   IpoptInterface(const IpoptInterface&);
 
@@ -478,6 +545,8 @@ class IpoptInterface : public Ipopt::TNLP {
 struct IpoptInterfaceData {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+  typedef Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> MatrixXb;
+
   IpoptInterfaceData(const std::size_t nx, const std::size_t ndx,
                      const std::size_t nu)
       : x(nx),
@@ -497,7 +566,14 @@ struct IpoptInterfaceData {
         FxJint_dx(ndx, ndx),
         Ldx(ndx),
         Ldxdx(ndx, ndx),
-        Ldxu(ndx, nu) {
+        Ldxu(ndx, nu),
+        Jg_dx_mask(ndx, ndx),
+        Jg_dxnext_mask(ndx, ndx),
+        Jg_u_mask(ndx, nu),
+        Jg_ic_mask(ndx, ndx),
+        Ldxdx_mask(ndx, ndx),
+        Ldxu_mask(ndx, nu),
+        Luu_mask(nu, nu) {
     x.setZero();
     xnext.setZero();
     dx.setZero();
@@ -516,6 +592,7 @@ struct IpoptInterfaceData {
     Ldx.setZero();
     Ldxdx.setZero();
     Ldxu.setZero();
+    setDensePattern();
   }
 
   void resize(const std::size_t nx, const std::size_t ndx,
@@ -538,6 +615,30 @@ struct IpoptInterfaceData {
     Ldx.conservativeResize(ndx);
     Ldxdx.conservativeResize(ndx, ndx);
     Ldxu.conservativeResize(ndx, nu);
+    Jg_dx_mask.resize(ndx, ndx);
+    Jg_dxnext_mask.resize(ndx, ndx);
+    Jg_u_mask.resize(ndx, nu);
+    Jg_ic_mask.resize(ndx, ndx);
+    Ldxdx_mask.resize(ndx, ndx);
+    Ldxu_mask.resize(ndx, nu);
+    Luu_mask.resize(nu, nu);
+    setDensePattern();
+  }
+
+  /**
+   * @brief Set the dense sparsity pattern of the node derivatives, i.e., all
+   * the Jacobian entries and the lower triangular part of the Hessian
+   */
+  void setDensePattern() {
+    Jg_dx_mask.setConstant(true);
+    Jg_dxnext_mask.setConstant(true);
+    Jg_u_mask.setConstant(true);
+    Jg_ic_mask.setConstant(true);
+    Ldxdx_mask.setConstant(false);
+    Ldxdx_mask.triangularView<Eigen::Lower>().setConstant(true);
+    Ldxu_mask.setConstant(true);
+    Luu_mask.setConstant(false);
+    Luu_mask.triangularView<Eigen::Lower>().setConstant(true);
   }
 
   Eigen::VectorXd x;        //!< Integrated state
@@ -563,6 +664,13 @@ struct IpoptInterfaceData {
   Eigen::VectorXd Ldx;        //!< Jacobian of the cost w.r.t dx
   Eigen::MatrixXd Ldxdx;      //!< Hessian of the cost w.r.t dxdx
   Eigen::MatrixXd Ldxu;       //!< Hessian of the cost w.r.t dxu
+  MatrixXb Jg_dx_mask;      //!< Nonzero entries of Jg_dx
+  MatrixXb Jg_dxnext_mask;  //!< Nonzero entries of Jg_dxnext
+  MatrixXb Jg_u_mask;       //!< Nonzero entries of Jg_u
+  MatrixXb Jg_ic_mask;      //!< Nonzero entries of Jg_ic
+  MatrixXb Ldxdx_mask;      //!< Nonzero entries of the lower part of Ldxdx
+  MatrixXb Ldxu_mask;       //!< Nonzero entries of Ldxu
+  MatrixXb Luu_mask;        //!< Nonzero entries of the lower part of Luu
 };
 
 }  // namespace crocoddyl
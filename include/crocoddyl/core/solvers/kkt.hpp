@@ -13,6 +13,8 @@
 
 #include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <Eigen/SparseCore>
+#include <Eigen/SparseLU>
 
 #include "crocoddyl/core/solver-base.hpp"
 
@@ -35,7 +37,7 @@ class SolverKKT : public SolverAbstract {
   virtual double stoppingCriteria();
   virtual const Eigen::Vector2d& expectedImprovement();
 
-  const Eigen::MatrixXd& get_kkt() const;
+  Eigen::MatrixXd get_kkt() const;
   const Eigen::VectorXd& get_kktref() const;
   const Eigen::VectorXd& get_primaldual() const;
   const std::vector<Eigen::VectorXd>& get_dxs() const;
@@ -60,6 +62,8 @@ class SolverKKT : public SolverAbstract {
   void increaseRegularization();
   void decreaseRegularization();
   void allocateData();
+  void setBlock(const std::size_t row, const std::size_t col,
+                const Eigen::Ref<const Eigen::MatrixXd>& block);
 
   std::size_t nx_;
   std::size_t ndx_;
@@ -69,7 +73,10 @@ class SolverKKT : public SolverAbstract {
   std::vector<Eigen::VectorXd> lambdas_;
 
   // allocate data
-  Eigen::MatrixXd kkt_;
+  Eigen::SparseMatrix<double> kkt_;
+  Eigen::SparseMatrix<double> kkt_reg_;
+  Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> >
+      kkt_lu_;
   Eigen::VectorXd kktref_;
   Eigen::VectorXd primaldual_;
   Eigen::VectorXd primal_;
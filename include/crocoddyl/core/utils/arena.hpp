@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_ARENA_HPP_
+#define CROCODDYL_CORE_UTILS_ARENA_HPP_
+
+#include <Eigen/Core>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace crocoddyl {
+
+/**
+ * @brief Monotonic arena used to allocate data trees
+ *
+ * The arena reserves large memory blocks and serves the allocations
+ * contiguously from them. The memory is never released individually; instead,
+ * all the blocks are released when the arena is destroyed. This improves the
+ * locality of the datas created by a node (action, cost, residual, activation
+ * and contact datas) and reduces the number of heap allocations to the number
+ * of blocks.
+ *
+ * An arena is enabled in the current thread through `DataArenaScope`. While
+ * the scope is alive, the datas created with `DataAllocator` (i.e., the ones
+ * created by the `createData()` functions) are placed in the arena. The datas
+ * keep the arena alive, so it can be safely released once the scope is
+ * closed. Note that the arena is not thread-safe, and that the dynamic-size
+ * Eigen buffers of the datas are still allocated in the heap.
+ *
+ * \sa `DataArenaScope`, `DataAllocator`
+ */
+class DataArena {
+ public:
+  /**
+   * @brief Initialize the arena
+   *
+   * @param[in] block_size  minimum size of the memory blocks (in bytes)
+   */
+  explicit DataArena(const std::size_t block_size = 16384);
+  ~DataArena();
+
+  /**
+   * @brief Allocate memory from the current block
+   *
+   * A new block is reserved if the current one has not enough space.
+   *
+   * @param[in] size       number of bytes
+   * @param[in] alignment  alignment of the memory (power of two)
+   * @return the allocated memory
+   */
+  void* allocate(const std::size_t size, const std::size_t alignment);
+
+  /**
+   * @brief Return the number of bytes allocated (including the padding)
+   */
+  std::size_t get_size() const;
+
+  /**
+   * @brief Return the number of bytes reserved by the blocks
+   */
+  std::size_t get_capacity() const;
+
+  /**
+   * @brief Return the number of reserved blocks
+   */
+  std::size_t get_nblocks() const;
+
+  /**
+   * @brief Return the minimum size of the memory blocks
+   */
+  std::size_t get_block_size() const;
+
+  /**
+   * @brief Return the arena enabled in the current thread (null if none)
+   */
+  static const std::shared_ptr<DataArena>& get_current();
+
+ private:
+  friend class DataArenaScope;
+
+  static std::shared_ptr<DataArena>& current();
+
+  std::size_t block_size_;                        //!< Minimum size of blocks
+  std::vector<std::unique_ptr<char[]> > blocks_;  //!< Reserved blocks
+  char* ptr_;                                     //!< Next free byte
+  std::size_t available_;                         //!< Free bytes of block
+  std::size_t size_;                              //!< Allocated bytes
+  std::size_t capacity_;                          //!< Reserved bytes
+};
+
+/**
+ * @brief Enable an arena in the current thread
+ *
+ * The arena is enabled during the lifetime of this object, and the previous
+ * one is restored once it is destroyed.
+ */
+class DataArenaScope {
+ public:
+  explicit DataArenaScope(const std::shared_ptr<DataArena>& arena);
+  ~DataArenaScope();
+
+ private:
+  DataArenaScope(const DataArenaScope&);
+  DataArenaScope& operator=(const DataArenaScope&);
+
+  std::shared_ptr<DataArena> previous_;  //!< Arena enabled before this scope
+};
+
+/**
+ * @brief Allocator of the datas
+ *
+ * It allocates the memory from the arena enabled in the current thread when
+ * the allocator is created. Otherwise, it behaves as
+ * `Eigen::aligned_allocator`. The allocator owns the arena, which makes the
+ * arena outlive the objects allocated with it.
+ *
+ * \sa `DataArena`, `DataArenaScope`
+ */
+template <typename T>
+class DataAllocator {
+ public:
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind {
+    typedef DataAllocator<U> other;
+  };
+
+  DataAllocator() : arena_(DataArena::get_current()) {}
+
+  template <typename U>
+  DataAllocator(const DataAllocator<U>& other) : arena_(other.get_arena()) {}
+
+  T* allocate(const std::size_t n) {
+    if (arena_) {
+      const std::size_t alignment =
+          alignof(T) > kAlignment ? alignof(T) : kAlignment;
+      return static_cast<T*>(arena_->allocate(n * sizeof(T), alignment));
+    }
+    return Eigen::aligned_allocator<T>().allocate(n);
+  }
+
+  void deallocate(T* p, const std::size_t n) {
+    // The arena memory is released together with the arena
+    if (!arena_) {
+      Eigen::aligned_allocator<T>().deallocate(p, n);
+    }
+  }
+
+  const std::shared_ptr<DataArena>& get_arena() const { return arena_; }
+
+ private:
+  static const std::size_t kAlignment =
+      EIGEN_MAX_ALIGN_BYTES > 16 ? EIGEN_MAX_ALIGN_BYTES : 16;
+
+  std::shared_ptr<DataArena> arena_;  //!< Arena (null to use the heap)
+};
+
+template <typename T, typename U>
+bool operator==(const DataAllocator<T>& a, const DataAllocator<U>& b) {
+  return a.get_arena() == b.get_arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const DataAllocator<T>& a, const DataAllocator<U>& b) {
+  return a.get_arena() != b.get_arena();
+}
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_ARENA_HPP_
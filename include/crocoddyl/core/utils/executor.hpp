@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_EXECUTOR_HPP_
+#define CROCODDYL_CORE_UTILS_EXECUTOR_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crocoddyl {
+
+/**
+ * @brief Return the number of threads used by an OpenMP parallel section
+ *
+ * A value lower than one selects `CROCODDYL_WITH_NTHREADS`. If multithreading
+ * support is not enabled, either at compile time or through
+ * `enableMultithreading()`, it warns that the section won't run in parallel
+ * and returns one.
+ *
+ * @param[in] nthreads  Requested number of threads
+ * @param[in] what      Name of the parallel section used in the warning
+ * @return the number of threads
+ */
+std::size_t getNumberOfThreads(const int nthreads, const char* what);
+
+/**
+ * @brief Abstract class for executing parallel loops
+ *
+ * An executor runs the iterations of a loop `for (i = 0; i < n; ++i)` on a
+ * given number of threads. It is used by the shooting problem and the solvers
+ * to compute the nodes of the problem in parallel. The iterations are assumed
+ * to be independent of each other. If an iteration throws an exception, the
+ * remaining iterations are still computed and the first exception is rethrown
+ * once the loop has finished.
+ *
+ * Optionally, the loop can receive an estimate of the computational cost of
+ * each iteration, which is used by the executors to balance the work across
+ * threads.
+ *
+ * \sa `parallelFor()`, `run()`
+ */
+class ExecutorAbstract {
+ public:
+  typedef void (*TaskFunction)(const void*, const std::size_t);
+
+  ExecutorAbstract();
+  virtual ~ExecutorAbstract();
+
+  /**
+   * @brief Run the iterations of a loop in parallel
+   *
+   * The body is a callable object with signature `void(std::size_t)`. It is
+   * passed by reference to the executor, so no memory is allocated.
+   *
+   * @param[in] n         number of iterations
+   * @param[in] nthreads  maximum number of threads
+   * @param[in] body      loop body
+   * @param[in] costs     estimated cost of each iteration (empty if unknown)
+   */
+  template <typename Body>
+  void parallelFor(const std::size_t n, const std::size_t nthreads,
+                   const Body& body,
+                   const std::vector<double>& costs = std::vector<double>()) {
+    run(n, nthreads, &ExecutorAbstract::invoke<Body>,
+        static_cast<const void*>(&body), costs);
+  }
+
+  /**
+   * @brief Run the iterations of a loop in parallel
+   *
+   * @param[in] n         number of iterations
+   * @param[in] nthreads  maximum number of threads
+   * @param[in] fn        function that runs the iteration `i` of a task
+   * @param[in] task      task data passed to `fn`
+   * @param[in] costs     estimated cost of each iteration (empty if unknown)
+   */
+  virtual void run(const std::size_t n, const std::size_t nthreads,
+                   TaskFunction fn, const void* task,
+                   const std::vector<double>& costs) = 0;
+
+  /**
+   * @brief Return the number of threads that this executor uses for a
+   * requested number of threads
+   *
+   * By default, it follows the OpenMP semantics of the free function
+   * `getNumberOfThreads()`, i.e., it returns one (and warns) if
+   * multithreading support is not enabled.
+   *
+   * @param[in] nthreads  Requested number of threads
+   * @param[in] what      Name of the parallel section used in the warning
+   * @return the number of threads
+   */
+  virtual std::size_t getNumberOfThreads(const int nthreads,
+                                         const char* what) const;
+
+ private:
+  template <typename Body>
+  static void invoke(const void* body, const std::size_t i) {
+    (*static_cast<const Body*>(body))(i);
+  }
+};
+
+/**
+ * @brief OpenMP executor
+ *
+ * It runs the loop inside an OpenMP parallel region with static scheduling.
+ * If the iteration costs are provided, each thread computes a contiguous range
+ * of iterations with a similar accumulated cost; otherwise, the ranges have
+ * the same number of iterations. This is the default executor. If
+ * multithreading support is not enabled, the loop is computed serially.
+ */
+class ExecutorOpenMP : public ExecutorAbstract {
+ public:
+  ExecutorOpenMP();
+  virtual ~ExecutorOpenMP();
+
+  virtual void run(const std::size_t n, const std::size_t nthreads,
+                   TaskFunction fn, const void* task,
+                   const std::vector<double>& costs);
+
+  /**
+   * @brief Return the first iteration of the k-th out of m balanced ranges
+   *
+   * Each iteration is assigned to the range that contains the midpoint of its
+   * accumulated cost. Negative costs are treated as zero.
+   *
+   * @param[in] costs  estimated cost of each iteration
+   * @param[in] total  sum of the non-negative costs
+   * @param[in] k      index of the range
+   * @param[in] m      number of ranges
+   * @return first iteration of the range (or the number of iterations if
+   * `k >= m`)
+   */
+  static std::size_t balancedBound(const std::vector<double>& costs,
+                                   const double total, const std::size_t k,
+                                   const std::size_t m);
+};
+
+/**
+ * @brief Work-stealing executor
+ *
+ * It runs the loop on a persistent pool of worker threads, which avoids
+ * creating or waking up a parallel region in each call. The iterations are
+ * split into contiguous chunks, whose boundaries are computed to have similar
+ * estimated costs if the iteration costs are provided. Each thread owns a
+ * contiguous range of chunks and, once it finishes them, it steals chunks
+ * from the back of the other ranges. In consequence, the loads remain
+ * balanced even when the iteration costs are inaccurate.
+ *
+ * The calling thread participates in the loop. After finishing a loop, the
+ * workers spin for a short period before sleeping, so consecutive calls (e.g.,
+ * `calc` followed by `calcDiff`) do not pay the wake-up latency. Nested or
+ * concurrent calls to the same executor are computed serially. As the pool
+ * is built on `std::thread`, it does not require OpenMP support.
+ */
+class ExecutorWorkStealing : public ExecutorAbstract {
+ public:
+  /**
+   * @brief Initialize the work-stealing executor
+   *
+   * @param[in] nthreads  number of threads, including the calling thread (for
+   * values lower than 1, it uses `CROCODDYL_WITH_NTHREADS`, or the number of
+   * hardware threads if multithreading support is not enabled)
+   * @param[in] nchunks   number of chunks per thread (default 4)
+   */
+  explicit ExecutorWorkStealing(const int nthreads = -1,
+                                const std::size_t nchunks = 4);
+  virtual ~ExecutorWorkStealing();
+
+  virtual void run(const std::size_t n, const std::size_t nthreads,
+                   TaskFunction fn, const void* task,
+                   const std::vector<double>& costs);
+
+  /**
+   * @brief Return the number of threads that this executor uses for a
+   * requested number of threads
+   *
+   * As the pool does not depend on OpenMP, it does not require multithreading
+   * support. For values lower than 1, it returns the size of the pool;
+   * otherwise, the requested value is bounded by the size of the pool.
+   *
+   * @param[in] nthreads  Requested number of threads
+   * @param[in] what      Name of the parallel section (unused)
+   * @return the number of threads
+   */
+  virtual std::size_t getNumberOfThreads(const int nthreads,
+                                         const char* what) const;
+
+  /**
+   * @brief Return the number of threads of the pool (including the calling
+   * thread)
+   */
+  std::size_t get_nthreads() const;
+
+  /**
+   * @brief Return the number of chunks per thread
+   */
+  std::size_t get_nchunks() const;
+
+  /**
+   * @brief Modify the number of chunks per thread
+   */
+  void set_nchunks(const std::size_t nchunks);
+
+ private:
+  struct Slot {
+    Slot() : ticket(0), range(0) {}
+
+    std::atomic<std::size_t> ticket;   //!< Last job assigned to the thread
+    std::atomic<std::uint64_t> range;  //!< Packed range of pending chunks
+  };
+
+  void work(const std::size_t id);
+  void execute(const std::size_t id);
+  std::size_t partition(const std::size_t n, const std::size_t nchunks,
+                        const std::vector<double>& costs);
+  bool pop(const std::size_t id, std::size_t& chunk);
+  bool steal(const std::size_t id, std::size_t& chunk);
+
+  std::size_t nthreads_;              //!< Number of threads (with the caller)
+  std::size_t nchunks_;               //!< Number of chunks per thread
+  std::vector<std::thread> workers_;  //!< Worker threads
+  std::unique_ptr<Slot[]> slots_;     //!< Scheduling slot of each thread
+  std::vector<std::size_t> bounds_;   //!< Boundaries of the chunks
+  std::mutex mutex_;                  //!< Mutex used to sleep the workers
+  std::condition_variable cv_;        //!< Condition to wake up the workers
+  std::atomic<bool> busy_;            //!< True while a loop is running
+  std::atomic<bool> stop_;            //!< True to stop the workers
+  std::atomic<std::size_t> done_;     //!< Number of workers that finished
+  std::size_t ticket_;                //!< Identifier of the current job
+  std::size_t nparticipants_;         //!< Number of threads in the job
+  TaskFunction fn_;                   //!< Function of the current job
+  const void* task_;                  //!< Task data of the current job
+  std::mutex exception_mutex_;        //!< Mutex to store the exception
+  std::exception_ptr exception_;      //!< First exception of the job
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_EXECUTOR_HPP_
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_MALLOC_GUARD_HPP_
+#define CROCODDYL_CORE_UTILS_MALLOC_GUARD_HPP_
+
+namespace crocoddyl {
+
+/**
+ * @brief Forbid or allow the heap allocations of Eigen within a scope
+ *
+ * The solvers use this guard to check that their iterations do not allocate
+ * memory. It only has effect if the library is built with the
+ * `BUILD_WITH_RUNTIME_NO_MALLOC` option, which defines
+ * `EIGEN_RUNTIME_NO_MALLOC`. In that case, Eigen raises an assertion when it
+ * allocates memory while the allocations are forbidden. Note that Eigen
+ * asserts are disabled in builds with `NDEBUG`.
+ *
+ * The guards can be nested, and the innermost guard defines the state of its
+ * thread. As Eigen stores a single process-wide flag, the allocations are
+ * forbidden only if no thread is inside an allowing guard and at least one
+ * thread is inside a forbidding guard. Threads without guards (e.g., the
+ * workers of an executor) follow the threads with guards. In consequence,
+ * concurrent solvers (e.g., in `SolverBatch`) do not trip each other, but
+ * an allocation is only detected while all of them forbid allocations.
+ */
+class MallocGuard {
+ public:
+  /**
+   * @brief Initialize the guard
+   *
+   * @param[in] allowed  true for allowing the allocations (default false)
+   */
+  explicit MallocGuard(const bool allowed = false);
+  ~MallocGuard();
+
+ private:
+  MallocGuard(const MallocGuard&);
+  MallocGuard& operator=(const MallocGuard&);
+
+  int previous_;  //!< State of the calling thread before this guard
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_MALLOC_GUARD_HPP_
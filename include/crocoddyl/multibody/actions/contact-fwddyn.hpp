@@ -67,6 +67,13 @@ namespace crocoddyl {
  * important to remark that `calcDiff()` computes the derivatives using the
  * latest stored values by `calc()`. Thus, we need to run `calc()` first.
  *
+ * The line search only needs the next state and cost computed by `calc()`.
+ * For this reason, the lazy kinematics mode (see `set_lazy_kinematics()`)
+ * replaces `pinocchio::computeAllTerms` by the kinematics, joint Jacobians,
+ * joint-space inertia matrix, nonlinear effects and centroidal momentum needed
+ * by the contact dynamics and residuals, and it defers the remaining terms
+ * (e.g., the CoM Jacobian) to `calcDiff()`.
+ *
  * \sa `DifferentialActionModelAbstractTpl`, `calc()`, `calcDiff()`,
  * `createData()`
  */
@@ -292,6 +299,24 @@ class DifferentialActionModelContactFwdDynamicsTpl
    */
   void set_damping_factor(const Scalar damping);
 
+  /**
+   * @brief Indicate if the lazy kinematics mode is enabled
+   */
+  bool get_lazy_kinematics() const;
+
+  /**
+   * @brief Enable or disable the lazy kinematics mode
+   *
+   * In this mode, `calc()` computes only the terms needed for the contact
+   * dynamics and the values of the residuals, and `calcDiff()` computes the
+   * deferred ones. It avoids computing the centroidal momentum matrix, the CoM
+   * Jacobian and energies in the line search. Note that the Pinocchio data
+   * does not contain these terms after running `calc()`.
+   *
+   * @param[in] lazy  True for enabling the lazy kinematics mode
+   */
+  void set_lazy_kinematics(const bool lazy);
+
   /**
    * @brief Print relevant information of the contact forward-dynamics model
    *
@@ -318,6 +343,8 @@ class DifferentialActionModelContactFwdDynamicsTpl
                             //!< inertia matrix
   bool enable_force_;  //!< Indicate if we have enabled the computation of the
                        //!< contact-forces derivatives
+  bool lazy_kinematics_;  //!< Indicate if we defer the kinematic terms that
+                          //!< are not needed by `calc()`
 };
 
 template <typename _Scalar>
@@ -353,7 +380,8 @@ struct DifferentialActionDataContactFwdDynamicsTpl
         df_du(model->get_contacts()->get_nc_total(), model->get_nu()),
         tmp_xstatic(model->get_state()->get_nx()),
         tmp_Jstatic(model->get_state()->get_nv(),
-                    model->get_nu() + model->get_contacts()->get_nc_total()) {
+                    model->get_nu() + model->get_contacts()->get_nc_total()),
+        tmp_ddq0(model->get_state()->get_nv()) {
     multibody.joint->dtau_du.diagonal().setOnes();
     costs->shareMemory(this);
     if (model->get_constraints() != nullptr) {
@@ -365,6 +393,7 @@ struct DifferentialActionDataContactFwdDynamicsTpl
     df_du.setZero();
     tmp_xstatic.setZero();
     tmp_Jstatic.setZero();
+    tmp_ddq0.setZero();
     pinocchio.lambda_c.resize(model->get_contacts()->get_nc_total());
     pinocchio.lambda_c.setZero();
   }
@@ -378,6 +407,7 @@ struct DifferentialActionDataContactFwdDynamicsTpl
   MatrixXs df_du;
   VectorXs tmp_xstatic;
   MatrixXs tmp_Jstatic;
+  VectorXs tmp_ddq0;  //!< Zero acceleration used in the lazy kinematics
 
   using Base::cost;
   using Base::Fu;
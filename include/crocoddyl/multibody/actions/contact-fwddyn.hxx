@@ -7,11 +7,15 @@
 // All rights reserved.
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <pinocchio/algorithm/center-of-mass.hpp>
 #include <pinocchio/algorithm/centroidal.hpp>
 #include <pinocchio/algorithm/compute-all-terms.hpp>
 #include <pinocchio/algorithm/contact-dynamics.hpp>
+#include <pinocchio/algorithm/crba.hpp>
 #include <pinocchio/algorithm/frames.hpp>
+#include <pinocchio/algorithm/jacobian.hpp>
 #include <pinocchio/algorithm/kinematics-derivatives.hpp>
+#include <pinocchio/algorithm/kinematics.hpp>
 #include <pinocchio/algorithm/rnea-derivatives.hpp>
 #include <pinocchio/algorithm/rnea.hpp>
 
@@ -38,7 +42,8 @@ DifferentialActionModelContactFwdDynamicsTpl<Scalar>::
       with_armature_(true),
       armature_(VectorXs::Zero(state->get_nv())),
       JMinvJt_damping_(fabs(JMinvJt_damping)),
-      enable_force_(enable_force) {
+      enable_force_(enable_force),
+      lazy_kinematics_(false) {
   init();
 }
 
@@ -62,7 +67,8 @@ DifferentialActionModelContactFwdDynamicsTpl<Scalar>::
       with_armature_(true),
       armature_(VectorXs::Zero(state->get_nv())),
       JMinvJt_damping_(fabs(JMinvJt_damping)),
-      enable_force_(enable_force) {
+      enable_force_(enable_force),
+      lazy_kinematics_(false) {
   init();
 }
 
@@ -118,7 +124,18 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::calc(
 
   // Computing the forward dynamics with the holonomic constraints defined by
   // the contact model
-  pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+  if (lazy_kinematics_) {
+    // The kinematics with zero acceleration give the acceleration drifts
+    pinocchio::forwardKinematics(pinocchio_, d->pinocchio, q, v, d->tmp_ddq0);
+    pinocchio::computeJointJacobians(pinocchio_, d->pinocchio);
+    pinocchio::crba(pinocchio_, d->pinocchio, q);
+    d->pinocchio.M.template triangularView<Eigen::StrictlyLower>() =
+        d->pinocchio.M.transpose()
+            .template triangularView<Eigen::StrictlyLower>();
+    pinocchio::nonLinearEffects(pinocchio_, d->pinocchio, q, v);
+  } else {
+    pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+  }
   pinocchio::computeCentroidalMomentum(pinocchio_, d->pinocchio);
 
   if (!with_armature_) {
@@ -170,7 +187,11 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::calc(
   const Eigen::VectorBlock<const Eigen::Ref<const VectorXs>, Eigen::Dynamic> v =
       x.tail(state_->get_nv());
 
-  pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+  if (lazy_kinematics_) {
+    pinocchio::forwardKinematics(pinocchio_, d->pinocchio, q, v);
+  } else {
+    pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+  }
   pinocchio::computeCentroidalMomentum(pinocchio_, d->pinocchio);
   costs_->calc(d->costs, x);
   d->cost = d->costs->cost;
@@ -215,6 +236,10 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::calcDiff(
   pinocchio::getKKTContactDynamicMatrixInverse(
       pinocchio_, d->pinocchio, d->multibody.contacts->Jc.topRows(nc), d->Kinv);
 
+  if (lazy_kinematics_) {
+    // Computing the terms deferred by calc
+    pinocchio::jacobianCenterOfMass(pinocchio_, d->pinocchio, false);
+  }
   actuation_->calcDiff(d->multibody.actuation, x, u);
   contacts_->calcDiff(d->multibody.contacts, x);
 
@@ -265,6 +290,11 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::calcDiff(
                                     std::to_string(state_->get_nx()) + ")");
   }
   Data* d = static_cast<Data*>(data.get());
+  if (lazy_kinematics_) {
+    // Computing the terms deferred by calc
+    pinocchio::computeJointJacobians(pinocchio_, d->pinocchio);
+    pinocchio::jacobianCenterOfMass(pinocchio_, d->pinocchio, false);
+  }
   costs_->calcDiff(d->costs, x);
   if (constraints_ != nullptr) {
     constraints_->calcDiff(d->constraints, x);
@@ -274,7 +304,7 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<DifferentialActionDataAbstractTpl<Scalar> >
 DifferentialActionModelContactFwdDynamicsTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -468,4 +498,16 @@ void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::set_damping_factor(
   JMinvJt_damping_ = damping;
 }
 
+template <typename Scalar>
+bool DifferentialActionModelContactFwdDynamicsTpl<Scalar>::get_lazy_kinematics()
+    const {
+  return lazy_kinematics_;
+}
+
+template <typename Scalar>
+void DifferentialActionModelContactFwdDynamicsTpl<Scalar>::set_lazy_kinematics(
+    const bool lazy) {
+  lazy_kinematics_ = lazy;
+}
+
 }  // namespace crocoddyl
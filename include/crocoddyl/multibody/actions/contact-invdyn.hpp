@@ -374,8 +374,7 @@ class DifferentialActionModelContactInvDynamicsTpl
     virtual std::shared_ptr<ResidualDataAbstract> createData(
         DataCollectorAbstract* const data) {
       return std::allocate_shared<typename Data::ResidualDataActuation>(
-          Eigen::aligned_allocator<typename Data::ResidualDataActuation>(),
-          this, data);
+          DataAllocator<typename Data::ResidualDataActuation>(), this, data);
     }
 
     /**
@@ -502,8 +501,8 @@ class DifferentialActionModelContactInvDynamicsTpl
     virtual std::shared_ptr<ResidualDataAbstract> createData(
         DataCollectorAbstract* const data) {
       return std::allocate_shared<typename Data::ResidualDataContact>(
-          Eigen::aligned_allocator<typename Data::ResidualDataContact>(), this,
-          data, id_);
+          DataAllocator<typename Data::ResidualDataContact>(), this, data,
+          id_);
     }
 
     /**
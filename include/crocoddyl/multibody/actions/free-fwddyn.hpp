@@ -52,6 +52,14 @@ namespace crocoddyl {
  * important to remark that `calcDiff()` computes the derivatives using the
  * latest stored values by `calc()`. Thus, we need to run `calc()` first.
  *
+ * The data keeps the state, joint torque and model generation at which the
+ * dynamics were last computed by `calc()`. When `calc()` is called again at the
+ * same point (e.g., when the solver evaluates an accepted trial point), it only
+ * computes the cost and constraints. The generation changes with the armature,
+ * and the computations of `calcDiff()`, `calc(data, x)` and `quasiStatic()`
+ * invalidate the stored point. Note that in-place modifications of the
+ * Pinocchio model are not tracked.
+ *
  * \sa `DifferentialActionModelAbstractTpl`, `calc()`, `calcDiff()`,
  * `createData()`
  */
@@ -221,8 +229,9 @@ class DifferentialActionModelFreeFwdDynamicsTpl
   std::shared_ptr<CostModelSum> costs_;                  //!< Cost model
   std::shared_ptr<ConstraintModelManager> constraints_;  //!< Constraint model
   pinocchio::ModelTpl<Scalar>& pinocchio_;               //!< Pinocchio model
-  bool without_armature_;  //!< Indicate if we have defined an armature
-  VectorXs armature_;      //!< Armature vector
+  bool without_armature_;   //!< Indicate if we have defined an armature
+  VectorXs armature_;       //!< Armature vector
+  std::size_t generation_;  //!< Generation of the dynamics parameters
 };
 
 template <typename _Scalar>
@@ -250,7 +259,10 @@ struct DifferentialActionDataFreeFwdDynamicsTpl
         Minv(model->get_state()->get_nv(), model->get_state()->get_nv()),
         u_drift(model->get_state()->get_nv()),
         dtau_dx(model->get_state()->get_nv(), model->get_state()->get_ndx()),
-        tmp_xstatic(model->get_state()->get_nx()) {
+        tmp_xstatic(model->get_state()->get_nx()),
+        x_dyn(model->get_state()->get_nx()),
+        tau_dyn(model->get_state()->get_nv()),
+        generation(0) {
     multibody.joint->dtau_du.diagonal().setOnes();
     costs->shareMemory(this);
     if (model->get_constraints() != nullptr) {
@@ -261,6 +273,8 @@ struct DifferentialActionDataFreeFwdDynamicsTpl
     u_drift.setZero();
     dtau_dx.setZero();
     tmp_xstatic.setZero();
+    x_dyn.setZero();
+    tau_dyn.setZero();
   }
 
   pinocchio::DataTpl<Scalar> pinocchio;
@@ -271,6 +285,10 @@ struct DifferentialActionDataFreeFwdDynamicsTpl
   VectorXs u_drift;
   MatrixXs dtau_dx;
   VectorXs tmp_xstatic;
+  VectorXs x_dyn;    //!< State at which the dynamics were computed
+  VectorXs tau_dyn;  //!< Joint torque at which the dynamics were computed
+  std::size_t generation;  //!< Model generation at which the dynamics were
+                           //!< computed (zero if they are not valid)
 
   using Base::cost;
   using Base::Fu;
@@ -16,6 +16,7 @@
 #include <pinocchio/algorithm/kinematics.hpp>
 #include <pinocchio/algorithm/rnea-derivatives.hpp>
 #include <pinocchio/algorithm/rnea.hpp>
+#include <type_traits>
 
 #include "crocoddyl/core/utils/exception.hpp"
 #include "crocoddyl/multibody/actions/free-fwddyn.hpp"
@@ -39,7 +40,8 @@ DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::
       constraints_(constraints),
       pinocchio_(*state->get_pinocchio().get()),
       without_armature_(true),
-      armature_(VectorXs::Zero(state->get_nv())) {
+      armature_(VectorXs::Zero(state->get_nv())),
+      generation_(1) {
   if (costs_->get_nu() != nu_) {
     throw_pretty(
         "Invalid argument: "
@@ -77,19 +79,26 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::calc(
 
   actuation_->calc(d->multibody.actuation, x, u);
 
-  // Computing the dynamics using ABA or manually for armature case
-  if (without_armature_) {
-    d->xout = pinocchio::aba(pinocchio_, d->pinocchio, q, v,
-                             d->multibody.actuation->tau);
-    pinocchio::updateGlobalPlacements(pinocchio_, d->pinocchio);
-  } else {
-    pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
-    d->pinocchio.M.diagonal() += armature_;
-    pinocchio::cholesky::decompose(pinocchio_, d->pinocchio);
-    d->Minv.setZero();
-    pinocchio::cholesky::computeMinv(pinocchio_, d->pinocchio, d->Minv);
-    d->u_drift = d->multibody.actuation->tau - d->pinocchio.nle;
-    d->xout.noalias() = d->Minv * d->u_drift;
+  // Computing the dynamics using ABA or manually for armature case. We reuse
+  // them if the data already has the dynamics at the same point
+  if (!std::is_floating_point<Scalar>::value || d->generation != generation_ ||
+      d->x_dyn != x || d->tau_dyn != d->multibody.actuation->tau) {
+    if (without_armature_) {
+      d->xout = pinocchio::aba(pinocchio_, d->pinocchio, q, v,
+                               d->multibody.actuation->tau);
+      pinocchio::updateGlobalPlacements(pinocchio_, d->pinocchio);
+    } else {
+      pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+      d->pinocchio.M.diagonal() += armature_;
+      pinocchio::cholesky::decompose(pinocchio_, d->pinocchio);
+      d->Minv.setZero();
+      pinocchio::cholesky::computeMinv(pinocchio_, d->pinocchio, d->Minv);
+      d->u_drift = d->multibody.actuation->tau - d->pinocchio.nle;
+      d->xout.noalias() = d->Minv * d->u_drift;
+    }
+    d->x_dyn = x;
+    d->tau_dyn = d->multibody.actuation->tau;
+    d->generation = generation_;
   }
   d->multibody.joint->a = d->xout;
   d->multibody.joint->tau = u;
@@ -118,6 +127,7 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::calc(
       x.tail(state_->get_nv());
 
   pinocchio::computeAllTerms(pinocchio_, d->pinocchio, q, v);
+  d->generation = 0;
 
   costs_->calc(d->costs, x);
   d->cost = d->costs->cost;
@@ -149,6 +159,7 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::calcDiff(
       x.tail(nv);
 
   Data* d = static_cast<Data*>(data.get());
+  d->generation = 0;
 
   actuation_->calcDiff(d->multibody.actuation, x, u);
 
@@ -196,7 +207,7 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::calcDiff(
 template <typename Scalar>
 std::shared_ptr<DifferentialActionDataAbstractTpl<Scalar> >
 DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::createData() {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this);
 }
 
 template <typename Scalar>
@@ -236,6 +247,7 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::quasiStatic(
   d->tmp_xstatic.head(nq) = q;
   d->tmp_xstatic.tail(nv).setZero();
   u.setZero();
+  d->generation = 0;
 
   pinocchio::rnea(pinocchio_, d->pinocchio, q, d->tmp_xstatic.tail(nv),
                   d->tmp_xstatic.tail(nv));
@@ -353,6 +365,7 @@ void DifferentialActionModelFreeFwdDynamicsTpl<Scalar>::set_armature(
 
   armature_ = armature;
   without_armature_ = false;
+  ++generation_;
 }
 
 }  // namespace crocoddyl
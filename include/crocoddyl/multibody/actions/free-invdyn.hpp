@@ -356,8 +356,7 @@ class DifferentialActionModelFreeInvDynamicsTpl
     virtual std::shared_ptr<ResidualDataAbstract> createData(
         DataCollectorAbstract* const data) {
       return std::allocate_shared<typename Data::ResidualDataActuation>(
-          Eigen::aligned_allocator<typename Data::ResidualDataActuation>(),
-          this, data);
+          DataAllocator<typename Data::ResidualDataActuation>(), this, data);
     }
 
     /**
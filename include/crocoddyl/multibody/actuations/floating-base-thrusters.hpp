@@ -251,7 +251,7 @@ class ActuationModelFloatingBaseThrustersTpl
    */
   virtual std::shared_ptr<Data> createData() {
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     updateData(data);
     return data;
   }
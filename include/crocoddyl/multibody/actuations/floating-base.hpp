@@ -136,7 +136,7 @@ class ActuationModelFloatingBaseTpl
     std::shared_ptr<StateMultibody> state =
         std::static_pointer_cast<StateMultibody>(state_);
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     const std::size_t root_joint_id =
         state->get_pinocchio()->existJointName("root_joint")
             ? state->get_pinocchio()->getJointId("root_joint")
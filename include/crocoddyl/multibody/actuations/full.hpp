@@ -120,7 +120,7 @@ class ActuationModelFullTpl : public ActuationModelAbstractTpl<_Scalar> {
    */
   virtual std::shared_ptr<Data> createData() {
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     data->dtau_du.diagonal().setOnes();
     data->Mtau.setIdentity();
     return data;
@@ -118,7 +118,7 @@ class ActuationModelMultiCopterBaseTpl
 
   std::shared_ptr<Data> createData() {
     std::shared_ptr<Data> data =
-        std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this);
+        std::allocate_shared<Data>(DataAllocator<Data>(), this);
     data->dtau_du = tau_f_;
     data->Mtau = Mtau_;
     for (std::size_t i = 0; i < 2; ++i) {
@@ -89,7 +89,7 @@ std::shared_ptr<ContactDataAbstractTpl<Scalar> >
 ContactModelAbstractTpl<Scalar>::createData(
     pinocchio::DataTpl<Scalar>* const data) {
   return std::allocate_shared<ContactDataAbstract>(
-      Eigen::aligned_allocator<ContactDataAbstract>(), this, data);
+      DataAllocator<ContactDataAbstract>(), this, data);
 }
 
 template <typename Scalar>
@@ -196,8 +196,7 @@ void ContactModel6DTpl<Scalar>::updateForce(
 template <typename Scalar>
 std::shared_ptr<ContactDataAbstractTpl<Scalar> >
 ContactModel6DTpl<Scalar>::createData(pinocchio::DataTpl<Scalar>* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
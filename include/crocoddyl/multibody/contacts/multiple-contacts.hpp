@@ -14,6 +14,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "crocoddyl/core/utils/exception.hpp"
 #include "crocoddyl/multibody/contact-base.hpp"
@@ -79,6 +80,7 @@ class ContactModelMultipleTpl {
       ContactModelContainer;
   typedef std::map<std::string, std::shared_ptr<ContactDataAbstract> >
       ContactDataContainer;
+  typedef std::vector<std::shared_ptr<ContactItem> > ContactItemVector;
   typedef typename pinocchio::container::aligned_vector<
       pinocchio::ForceTpl<Scalar> >::iterator ForceIterator;
 
@@ -223,6 +225,15 @@ class ContactModelMultipleTpl {
    */
   const ContactModelContainer& get_contacts() const;
 
+  /**
+   * @brief Return the contact items stored in a contiguous vector
+   *
+   * The items follow the order of the names in `get_contacts()`. This vector,
+   * and the vector of contact datas in `ContactDataMultipleTpl`, are used to
+   * avoid traversing the maps in the contact computations.
+   */
+  const ContactItemVector& get_contact_items() const;
+
   /**
    * @brief Return the dimension of active contacts
    */
@@ -276,8 +287,11 @@ class ContactModelMultipleTpl {
                                   const ContactModelMultipleTpl<Scalar>& model);
 
  private:
+  void updateContactItems();
+
   std::shared_ptr<StateMultibody> state_;
   ContactModelContainer contacts_;
+  ContactItemVector contact_items_;
   std::size_t nc_;
   std::size_t nc_total_;
   std::size_t nu_;
@@ -299,6 +313,7 @@ struct ContactDataMultipleTpl {
   typedef MathBaseTpl<Scalar> MathBase;
   typedef ContactModelMultipleTpl<Scalar> ContactModelMultiple;
   typedef ContactItemTpl<Scalar> ContactItem;
+  typedef ContactDataAbstractTpl<Scalar> ContactDataAbstract;
   typedef typename MathBase::VectorXs VectorXs;
   typedef typename MathBase::MatrixXs MatrixXs;
 
@@ -323,12 +338,15 @@ struct ContactDataMultipleTpl {
     da0_dx.setZero();
     dv.setZero();
     ddv_dx.setZero();
+    contact_datas.reserve(model->get_contacts().size());
     for (typename ContactModelMultiple::ContactModelContainer::const_iterator
              it = model->get_contacts().begin();
          it != model->get_contacts().end(); ++it) {
       const std::shared_ptr<ContactItem>& item = it->second;
-      contacts.insert(
-          std::make_pair(item->name, item->contact->createData(data)));
+      const std::shared_ptr<ContactDataAbstract> contact_data =
+          item->contact->createData(data);
+      contacts.insert(std::make_pair(item->name, contact_data));
+      contact_datas.push_back(contact_data);
     }
   }
 
@@ -352,6 +370,9 @@ struct ContactDataMultipleTpl {
                //!< ndx}\f$
   typename ContactModelMultiple::ContactDataContainer
       contacts;  //!< Stack of contact data
+  std::vector<std::shared_ptr<ContactDataAbstract> >
+      contact_datas;  //!< Contact datas in the order of the model's contact
+                      //!< items
   pinocchio::container::aligned_vector<pinocchio::ForceTpl<Scalar> >
       fext;  //!< External spatial forces in body coordinates
 };
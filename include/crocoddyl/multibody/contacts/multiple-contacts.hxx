@@ -54,6 +54,7 @@ void ContactModelMultipleTpl<Scalar>::addContact(
     nc_total_ += contact->get_nc();
     inactive_set_.insert(name);
   }
+  updateContactItems();
 }
 
 template <typename Scalar>
@@ -65,6 +66,7 @@ void ContactModelMultipleTpl<Scalar>::removeContact(const std::string& name) {
     contacts_.erase(it);
     active_set_.erase(name);
     inactive_set_.erase(name);
+    updateContactItems();
   } else {
     std::cerr << "Warning: we couldn't remove the " << name
               << " contact item, it doesn't exist." << std::endl;
@@ -97,27 +99,25 @@ template <typename Scalar>
 void ContactModelMultipleTpl<Scalar>::calc(
     const std::shared_ptr<ContactDataMultiple>& data,
     const Eigen::Ref<const VectorXs>& x) {
-  if (data->contacts.size() != contacts_.size()) {
+  if (data->contact_datas.size() != contact_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of contact datas and models");
   }
 
   std::size_t nc = 0;
   const std::size_t nv = state_->get_nv();
-  typename ContactModelContainer::iterator it_m, end_m;
-  typename ContactDataContainer::iterator it_d, end_d;
   if (compute_all_contacts_) {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
+    for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+      const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
       const std::size_t nc_i = m_i->contact->get_nc();
       if (m_i->active) {
-        const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-        assert_pretty(
-            it_m->first == it_d->first,
-            "it doesn't match the contact name between model and data ("
-                << it_m->first << " != " << it_d->first << ")");
+        const std::shared_ptr<ContactDataAbstract>& d_i =
+            data->contact_datas[i];
+        assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                          data->contacts.find(m_i->name)->second == d_i,
+                      "it doesn't match the contact name between model and "
+                      "data ("
+                          << m_i->name << ")");
         m_i->contact->calc(d_i, x);
         data->a0.segment(nc, nc_i) = d_i->a0;
         data->Jc.block(nc, 0, nc_i, nv) = d_i->Jc;
@@ -128,23 +128,21 @@ void ContactModelMultipleTpl<Scalar>::calc(
       nc += nc_i;
     }
   } else {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      if (m_i->active) {
-        const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-        assert_pretty(
-            it_m->first == it_d->first,
-            "it doesn't match the contact name between model and data ("
-                << it_m->first << " != " << it_d->first << ")");
-
-        m_i->contact->calc(d_i, x);
-        const std::size_t nc_i = m_i->contact->get_nc();
-        data->a0.segment(nc, nc_i) = d_i->a0;
-        data->Jc.block(nc, 0, nc_i, nv) = d_i->Jc;
-        nc += nc_i;
+    for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+      const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
+      if (!m_i->active) {
+        continue;
       }
+      const std::shared_ptr<ContactDataAbstract>& d_i = data->contact_datas[i];
+      assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                        data->contacts.find(m_i->name)->second == d_i,
+                    "it doesn't match the contact name between model and data ("
+                        << m_i->name << ")");
+      m_i->contact->calc(d_i, x);
+      const std::size_t nc_i = m_i->contact->get_nc();
+      data->a0.segment(nc, nc_i) = d_i->a0;
+      data->Jc.block(nc, 0, nc_i, nv) = d_i->Jc;
+      nc += nc_i;
     }
   }
 }
@@ -153,28 +151,25 @@ template <typename Scalar>
 void ContactModelMultipleTpl<Scalar>::calcDiff(
     const std::shared_ptr<ContactDataMultiple>& data,
     const Eigen::Ref<const VectorXs>& x) {
-  if (data->contacts.size() != contacts_.size()) {
+  if (data->contact_datas.size() != contact_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of contact datas and models");
   }
 
   std::size_t nc = 0;
   const std::size_t ndx = state_->get_ndx();
-  typename ContactModelContainer::iterator it_m, end_m;
-  typename ContactDataContainer::iterator it_d, end_d;
   if (compute_all_contacts_) {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
+    for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+      const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
       const std::size_t nc_i = m_i->contact->get_nc();
       if (m_i->active) {
-        assert_pretty(
-            it_m->first == it_d->first,
-            "it doesn't match the contact name between model and data ("
-                << it_m->first << " != " << it_d->first << ")");
-        const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-
+        const std::shared_ptr<ContactDataAbstract>& d_i =
+            data->contact_datas[i];
+        assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                          data->contacts.find(m_i->name)->second == d_i,
+                      "it doesn't match the contact name between model and "
+                      "data ("
+                          << m_i->name << ")");
         m_i->contact->calcDiff(d_i, x);
         data->da0_dx.block(nc, 0, nc_i, ndx) = d_i->da0_dx;
       } else {
@@ -183,22 +178,20 @@ void ContactModelMultipleTpl<Scalar>::calcDiff(
       nc += nc_i;
     }
   } else {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      if (m_i->active) {
-        const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-        assert_pretty(
-            it_m->first == it_d->first,
-            "it doesn't match the contact name between model and data ("
-                << it_m->first << " != " << it_d->first << ")");
-
-        m_i->contact->calcDiff(d_i, x);
-        const std::size_t nc_i = m_i->contact->get_nc();
-        data->da0_dx.block(nc, 0, nc_i, ndx) = d_i->da0_dx;
-        nc += nc_i;
+    for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+      const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
+      if (!m_i->active) {
+        continue;
       }
+      const std::shared_ptr<ContactDataAbstract>& d_i = data->contact_datas[i];
+      assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                        data->contacts.find(m_i->name)->second == d_i,
+                    "it doesn't match the contact name between model and data ("
+                        << m_i->name << ")");
+      m_i->contact->calcDiff(d_i, x);
+      const std::size_t nc_i = m_i->contact->get_nc();
+      data->da0_dx.block(nc, 0, nc_i, ndx) = d_i->da0_dx;
+      nc += nc_i;
     }
   }
 }
@@ -225,7 +218,7 @@ void ContactModelMultipleTpl<Scalar>::updateForce(
         << "force has wrong dimension (it should be " +
                std::to_string((compute_all_contacts_ ? nc_total_ : nc_)) + ")");
   }
-  if (static_cast<std::size_t>(data->contacts.size()) != contacts_.size()) {
+  if (data->contact_datas.size() != contact_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of contact datas and models");
   }
@@ -235,58 +228,31 @@ void ContactModelMultipleTpl<Scalar>::updateForce(
   }
 
   std::size_t nc = 0;
-  typename ContactModelContainer::iterator it_m, end_m;
-  typename ContactDataContainer::iterator it_d, end_d;
-  if (compute_all_contacts_) {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the contact name between data and model");
-      const std::size_t nc_i = m_i->contact->get_nc();
-      if (m_i->active) {
-        const Eigen::VectorBlock<const VectorXs, Eigen::Dynamic> force_i =
-            force.segment(nc, nc_i);
-        m_i->contact->updateForce(d_i, force_i);
+  for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+    const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
+    const std::shared_ptr<ContactDataAbstract>& d_i = data->contact_datas[i];
+    assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                      data->contacts.find(m_i->name)->second == d_i,
+                  "it doesn't match the contact name between model and data ("
+                      << m_i->name << ")");
+    const std::size_t nc_i = m_i->contact->get_nc();
+    if (m_i->active) {
+      const Eigen::VectorBlock<const VectorXs, Eigen::Dynamic> force_i =
+          force.segment(nc, nc_i);
+      m_i->contact->updateForce(d_i, force_i);
 #if PINOCCHIO_VERSION_AT_LEAST(3, 0, 0)
-        const pinocchio::JointIndex joint =
-            state_->get_pinocchio()->frames[d_i->frame].parentJoint;
+      const pinocchio::JointIndex joint =
+          state_->get_pinocchio()->frames[d_i->frame].parentJoint;
 #else
-        const pinocchio::JointIndex joint =
-            state_->get_pinocchio()->frames[d_i->frame].parent;
+      const pinocchio::JointIndex joint =
+          state_->get_pinocchio()->frames[d_i->frame].parent;
 #endif
-        data->fext[joint] = d_i->fext;
-      } else {
-        m_i->contact->setZeroForce(d_i);
-      }
+      data->fext[joint] = d_i->fext;
       nc += nc_i;
-    }
-  } else {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the contact name between data and model");
-      if (m_i->active) {
-        const std::size_t nc_i = m_i->contact->get_nc();
-        const Eigen::VectorBlock<const VectorXs, Eigen::Dynamic> force_i =
-            force.segment(nc, nc_i);
-        m_i->contact->updateForce(d_i, force_i);
-#if PINOCCHIO_VERSION_AT_LEAST(3, 0, 0)
-        const pinocchio::JointIndex joint =
-            state_->get_pinocchio()->frames[d_i->frame].parentJoint;
-#else
-        const pinocchio::JointIndex joint =
-            state_->get_pinocchio()->frames[d_i->frame].parent;
-#endif
-        data->fext[joint] = d_i->fext;
+    } else {
+      m_i->contact->setZeroForce(d_i);
+      if (compute_all_contacts_) {
         nc += nc_i;
-      } else {
-        m_i->contact->setZeroForce(d_i);
       }
     }
   }
@@ -329,52 +295,31 @@ void ContactModelMultipleTpl<Scalar>::updateForceDiff(
                std::to_string((compute_all_contacts_ ? nc_total_ : nc_)) + "," +
                std::to_string(nu_) + ")");
   }
-  if (static_cast<std::size_t>(data->contacts.size()) != contacts_.size()) {
+  if (data->contact_datas.size() != contact_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of contact datas and models");
   }
 
   std::size_t nc = 0;
-  typename ContactModelContainer::const_iterator it_m, end_m;
-  typename ContactDataContainer::const_iterator it_d, end_d;
-  if (compute_all_contacts_) {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the contact name between data and model");
-      const std::size_t nc_i = m_i->contact->get_nc();
-      if (m_i->active) {
-        const Eigen::Block<const MatrixXs> df_dx_i =
-            df_dx.block(nc, 0, nc_i, ndx);
-        const Eigen::Block<const MatrixXs> df_du_i =
-            df_du.block(nc, 0, nc_i, nu_);
-        m_i->contact->updateForceDiff(d_i, df_dx_i, df_du_i);
-      } else {
-        m_i->contact->setZeroForceDiff(d_i);
-      }
+  for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+    const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
+    const std::shared_ptr<ContactDataAbstract>& d_i = data->contact_datas[i];
+    assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                      data->contacts.find(m_i->name)->second == d_i,
+                  "it doesn't match the contact name between model and data ("
+                      << m_i->name << ")");
+    const std::size_t nc_i = m_i->contact->get_nc();
+    if (m_i->active) {
+      const Eigen::Block<const MatrixXs> df_dx_i =
+          df_dx.block(nc, 0, nc_i, ndx);
+      const Eigen::Block<const MatrixXs> df_du_i =
+          df_du.block(nc, 0, nc_i, nu_);
+      m_i->contact->updateForceDiff(d_i, df_dx_i, df_du_i);
       nc += nc_i;
-    }
-  } else {
-    for (it_m = contacts_.begin(), end_m = contacts_.end(),
-        it_d = data->contacts.begin(), end_d = data->contacts.end();
-         it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-      const std::shared_ptr<ContactItem>& m_i = it_m->second;
-      const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-      assert_pretty(it_m->first == it_d->first,
-                    "it doesn't match the contact name between data and model");
-      if (m_i->active) {
-        const std::size_t nc_i = m_i->contact->get_nc();
-        const Eigen::Block<const MatrixXs> df_dx_i =
-            df_dx.block(nc, 0, nc_i, ndx);
-        const Eigen::Block<const MatrixXs> df_du_i =
-            df_du.block(nc, 0, nc_i, nu_);
-        m_i->contact->updateForceDiff(d_i, df_dx_i, df_du_i);
+    } else {
+      m_i->contact->setZeroForceDiff(d_i);
+      if (compute_all_contacts_) {
         nc += nc_i;
-      } else {
-        m_i->contact->setZeroForceDiff(d_i);
       }
     }
   }
@@ -384,29 +329,27 @@ template <typename Scalar>
 void ContactModelMultipleTpl<Scalar>::updateRneaDiff(
     const std::shared_ptr<ContactDataMultiple>& data,
     pinocchio::DataTpl<Scalar>& pinocchio) const {
-  if (static_cast<std::size_t>(data->contacts.size()) !=
-      this->get_contacts().size()) {
+  if (data->contact_datas.size() != contact_items_.size()) {
     throw_pretty("Invalid argument: "
                  << "it doesn't match the number of contact datas and models");
   }
-  typename ContactModelContainer::const_iterator it_m, end_m;
-  typename ContactDataContainer::const_iterator it_d, end_d;
-  for (it_m = contacts_.begin(), end_m = contacts_.end(),
-      it_d = data->contacts.begin(), end_d = data->contacts.end();
-       it_m != end_m || it_d != end_d; ++it_m, ++it_d) {
-    const std::shared_ptr<ContactItem>& m_i = it_m->second;
-    const std::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
-    assert_pretty(it_m->first == it_d->first,
-                  "it doesn't match the contact name between data and model");
-    if (m_i->active) {
-      switch (m_i->contact->get_type()) {
-        case pinocchio::ReferenceFrame::LOCAL:
-          break;
-        case pinocchio::ReferenceFrame::WORLD:
-        case pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED:
-          pinocchio.dtau_dq += d_i->dtau_dq;
-          break;
-      }
+  for (std::size_t i = 0; i < contact_items_.size(); ++i) {
+    const std::shared_ptr<ContactItem>& m_i = contact_items_[i];
+    if (!m_i->active) {
+      continue;
+    }
+    const std::shared_ptr<ContactDataAbstract>& d_i = data->contact_datas[i];
+    assert_pretty(data->contacts.count(m_i->name) != 0 &&
+                      data->contacts.find(m_i->name)->second == d_i,
+                  "it doesn't match the contact name between model and data ("
+                      << m_i->name << ")");
+    switch (m_i->contact->get_type()) {
+      case pinocchio::ReferenceFrame::LOCAL:
+        break;
+      case pinocchio::ReferenceFrame::WORLD:
+      case pinocchio::ReferenceFrame::LOCAL_WORLD_ALIGNED:
+        pinocchio.dtau_dq += d_i->dtau_dq;
+        break;
     }
   }
 }
@@ -416,7 +359,7 @@ std::shared_ptr<ContactDataMultipleTpl<Scalar> >
 ContactModelMultipleTpl<Scalar>::createData(
     pinocchio::DataTpl<Scalar>* const data) {
   return std::allocate_shared<ContactDataMultiple>(
-      Eigen::aligned_allocator<ContactDataMultiple>(), this, data);
+      DataAllocator<ContactDataMultiple>(), this, data);
 }
 
 template <typename Scalar>
@@ -431,6 +374,12 @@ ContactModelMultipleTpl<Scalar>::get_contacts() const {
   return contacts_;
 }
 
+template <typename Scalar>
+const typename ContactModelMultipleTpl<Scalar>::ContactItemVector&
+ContactModelMultipleTpl<Scalar>::get_contact_items() const {
+  return contact_items_;
+}
+
 template <typename Scalar>
 std::size_t ContactModelMultipleTpl<Scalar>::get_nc() const {
   return nc_;
@@ -481,6 +430,16 @@ void ContactModelMultipleTpl<Scalar>::setComputeAllContacts(const bool status) {
   compute_all_contacts_ = status;
 }
 
+template <typename Scalar>
+void ContactModelMultipleTpl<Scalar>::updateContactItems() {
+  contact_items_.clear();
+  contact_items_.reserve(contacts_.size());
+  for (typename ContactModelContainer::const_iterator it = contacts_.begin();
+       it != contacts_.end(); ++it) {
+    contact_items_.push_back(it->second);
+  }
+}
+
 template <class Scalar>
 std::ostream& operator<<(std::ostream& os,
                          const ContactModelMultipleTpl<Scalar>& model) {
@@ -59,7 +59,7 @@ std::shared_ptr<ImpulseDataAbstractTpl<Scalar> >
 ImpulseModelAbstractTpl<Scalar>::createData(
     pinocchio::DataTpl<Scalar>* const data) {
   return std::allocate_shared<ImpulseDataAbstract>(
-      Eigen::aligned_allocator<ImpulseDataAbstract>(), this, data);
+      DataAllocator<ImpulseDataAbstract>(), this, data);
 }
 
 template <typename Scalar>
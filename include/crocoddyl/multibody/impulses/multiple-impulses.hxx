@@ -285,7 +285,7 @@ std::shared_ptr<ImpulseDataMultipleTpl<Scalar> >
 ImpulseModelMultipleTpl<Scalar>::createData(
     pinocchio::DataTpl<Scalar>* const data) {
   return std::allocate_shared<ImpulseDataMultiple>(
-      Eigen::aligned_allocator<ImpulseDataMultiple>(), this, data);
+      DataAllocator<ImpulseDataMultiple>(), this, data);
 }
 
 template <typename Scalar>
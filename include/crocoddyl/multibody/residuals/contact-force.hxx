@@ -109,7 +109,7 @@ std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelContactForceTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
   std::shared_ptr<ResidualDataAbstract> d =
-      std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this, data);
+      std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
   if (!fwddyn_) {
     updateJacobians(d);
   }
@@ -27,6 +27,8 @@ ResidualModelFrameRotationTpl<Scalar>::ResidualModelFrameRotationTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
@@ -44,6 +46,8 @@ ResidualModelFrameRotationTpl<Scalar>::ResidualModelFrameRotationTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
@@ -81,8 +85,7 @@ template <typename Scalar>
 std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelFrameRotationTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
@@ -110,6 +113,8 @@ template <typename Scalar>
 void ResidualModelFrameRotationTpl<Scalar>::set_id(
     const pinocchio::FrameIndex id) {
   id_ = id;
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
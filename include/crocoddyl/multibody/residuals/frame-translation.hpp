@@ -17,6 +17,7 @@
 #include "crocoddyl/multibody/data/multibody.hpp"
 #include "crocoddyl/multibody/fwd.hpp"
 #include "crocoddyl/multibody/states/multibody.hpp"
+#include "crocoddyl/multibody/utils/jacobian-blocks.hpp"
 
 namespace crocoddyl {
 
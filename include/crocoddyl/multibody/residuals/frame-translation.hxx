@@ -26,6 +26,8 @@ ResidualModelFrameTranslationTpl<Scalar>::ResidualModelFrameTranslationTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
@@ -42,6 +44,8 @@ ResidualModelFrameTranslationTpl<Scalar>::ResidualModelFrameTranslationTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
@@ -76,8 +80,7 @@ template <typename Scalar>
 std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelFrameTranslationTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
@@ -103,6 +106,8 @@ template <typename Scalar>
 void ResidualModelFrameTranslationTpl<Scalar>::set_id(
     const pinocchio::FrameIndex id) {
   id_ = id;
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, false));
 }
 
 template <typename Scalar>
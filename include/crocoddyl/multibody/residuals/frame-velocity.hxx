@@ -30,6 +30,8 @@ ResidualModelFrameVelocityTpl<Scalar>::ResidualModelFrameVelocityTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, true));
 }
 
 template <typename Scalar>
@@ -47,6 +49,8 @@ ResidualModelFrameVelocityTpl<Scalar>::ResidualModelFrameVelocityTpl(
         "Invalid argument: "
         << "the frame index is wrong (it does not exist in the robot)");
   }
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, true));
 }
 
 template <typename Scalar>
@@ -81,8 +85,7 @@ template <typename Scalar>
 std::shared_ptr<ResidualDataAbstractTpl<Scalar> >
 ResidualModelFrameVelocityTpl<Scalar>::createData(
     DataCollectorAbstract* const data) {
-  return std::allocate_shared<Data>(Eigen::aligned_allocator<Data>(), this,
-                                    data);
+  return std::allocate_shared<Data>(DataAllocator<Data>(), this, data);
 }
 
 template <typename Scalar>
@@ -114,6 +117,8 @@ template <typename Scalar>
 void ResidualModelFrameVelocityTpl<Scalar>::set_id(
     const pinocchio::FrameIndex id) {
   id_ = id;
+  Base::set_Rx_blocks(
+      getFrameJacobianBlocks(*pin_model_.get(), id_, true, true));
 }
 
 template <typename Scalar>
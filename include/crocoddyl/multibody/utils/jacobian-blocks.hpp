@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_MULTIBODY_UTILS_JACOBIAN_BLOCKS_HPP_
+#define CROCODDYL_MULTIBODY_UTILS_JACOBIAN_BLOCKS_HPP_
+
+#include <pinocchio/multibody/model.hpp>
+#include <utility>
+#include <vector>
+
+namespace crocoddyl {
+
+/**
+ * @brief Return the column blocks of the state Jacobian of a frame quantity
+ *
+ * The kinematics of a frame only depend on the joints that support its parent
+ * joint. This function returns the column blocks of these joints in the
+ * tangent space of the multibody state, i.e., \f$(\delta\mathbf{q},
+ * \delta\mathbf{v})\f$. The blocks are sorted and can be passed to
+ * `ResidualModelAbstractTpl::set_Rx_blocks()`.
+ *
+ * @param[in] model        Pinocchio model
+ * @param[in] id           Frame index
+ * @param[in] q_dependent  Include the blocks of the configuration
+ * @param[in] v_dependent  Include the blocks of the velocity
+ * @return the first column and number of columns of each block
+ */
+template <typename Scalar>
+std::vector<std::pair<std::size_t, std::size_t> > getFrameJacobianBlocks(
+    const pinocchio::ModelTpl<Scalar>& model, const pinocchio::FrameIndex id,
+    const bool q_dependent, const bool v_dependent) {
+  std::vector<std::pair<std::size_t, std::size_t> > blocks;
+#if PINOCCHIO_VERSION_AT_LEAST(3, 0, 0)
+  const pinocchio::JointIndex joint = model.frames[id].parentJoint;
+#else
+  const pinocchio::JointIndex joint = model.frames[id].parent;
+#endif
+  // The first support is the universe, which has no degrees of freedom
+  const std::vector<pinocchio::JointIndex>& supports = model.supports[joint];
+  const std::size_t nv = static_cast<std::size_t>(model.nv);
+  for (std::size_t k = 0; k < 2; ++k) {
+    if ((k == 0 && !q_dependent) || (k == 1 && !v_dependent)) {
+      continue;
+    }
+    for (std::size_t i = 1; i < supports.size(); ++i) {
+      const std::size_t start =
+          static_cast<std::size_t>(model.idx_vs[supports[i]]) + k * nv;
+      const std::size_t size = static_cast<std::size_t>(model.nvs[supports[i]]);
+      if (!blocks.empty() &&
+          blocks.back().first + blocks.back().second == start) {
+        blocks.back().second += size;
+      } else if (size > 0) {
+        blocks.push_back(std::make_pair(start, size));
+      }
+    }
+  }
+  return blocks;
+}
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_MULTIBODY_UTILS_JACOBIAN_BLOCKS_HPP_
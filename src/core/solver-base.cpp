@@ -7,10 +7,6 @@
 // All rights reserved.
 ///////////////////////////////////////////////////////////////////////////////
 
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#include <omp.h>
-#endif  // CROCODDYL_WITH_MULTITHREADING
-
 #include "crocoddyl/core/solver-base.hpp"
 #include "crocoddyl/core/utils/exception.hpp"
 
@@ -99,14 +95,11 @@ double SolverAbstract::computeDynamicFeasibility() {
       problem_->get_runningDatas();
 
   models[0]->get_state()->diff(xs_[0], x0, fs_[0]);
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(problem_->get_nthreads())
-#endif
-  for (std::size_t t = 0; t < T; ++t) {
+  problem_->parallelFor(T, [&](const std::size_t t) {
     const std::shared_ptr<ActionModelAbstract>& m = models[t];
     const std::shared_ptr<ActionDataAbstract>& d = datas[t];
     m->get_state()->diff(xs_[t + 1], d->xnext, fs_[t + 1]);
-  }
+  });
   switch (feasnorm_) {
     case LInf:
       tmp_feas_ = std::max(tmp_feas_, fs_[0].lpNorm<Eigen::Infinity>());
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif  // CROCODDYL_WITH_MULTITHREADING
+
+#include "crocoddyl/core/solvers/batch.hpp"
+
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/malloc-guard.hpp"
+
+namespace crocoddyl {
+
+SolverBatch::SolverBatch(
+    const std::vector<std::shared_ptr<SolverAbstract> >& solvers)
+    : nthreads_(1) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  if (enableMultithreading()) {
+    nthreads_ = CROCODDYL_WITH_NTHREADS;
+  }
+#endif
+  set_solvers(solvers);
+}
+
+SolverBatch::~SolverBatch() {}
+
+bool SolverBatch::solve(
+    const std::vector<std::vector<Eigen::VectorXd> >& init_xs,
+    const std::vector<std::vector<Eigen::VectorXd> >& init_us,
+    const std::size_t maxiter, const bool is_feasible, const double init_reg) {
+  START_PROFILER("SolverBatch::solve");
+  const std::size_t n = solvers_.size();
+  if (init_xs.size() != 0 && init_xs.size() != n) {
+    throw_pretty("Invalid argument: "
+                 << "init_xs has wrong dimension (it should be " +
+                        std::to_string(n) + ")");
+  }
+  if (init_us.size() != 0 && init_us.size() != n) {
+    throw_pretty("Invalid argument: "
+                 << "init_us has wrong dimension (it should be " +
+                        std::to_string(n) + ")");
+  }
+
+  // Each problem runs its nodes, line search and backward pass serially as we
+  // parallelize across problems
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  const bool is_parallel = nthreads_ > 1 && n > 1;
+  if (is_parallel) {
+    for (std::size_t i = 0; i < n; ++i) {
+      const std::shared_ptr<ShootingProblem>& problem =
+          solvers_[i]->get_problem();
+      problem_nthreads_[i] = problem->get_nthreads();
+      problem->set_nthreads(1);
+      const std::shared_ptr<SolverDDP> ddp =
+          std::dynamic_pointer_cast<SolverDDP>(solvers_[i]);
+      if (ddp) {
+        ls_nthreads_[i] = ddp->get_ls_nthreads();
+        bp_nthreads_[i] = ddp->get_bp_nthreads();
+        if (ls_nthreads_[i] > 1) {
+          ddp->set_ls_nthreads(1);
+        }
+        if (bp_nthreads_[i] > 1) {
+          ddp->set_bp_nthreads(1);
+        }
+      }
+    }
+  }
+#endif
+
+  // The solving time differs between problems, so we schedule them
+  // dynamically
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads_) \
+    if (is_parallel)
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    // The allocation checks of each solver are process-wide, so this thread
+    // allows the allocations outside the iterations of its solver
+    MallocGuard allow(true);
+    const std::shared_ptr<SolverAbstract>& solver = solvers_[i];
+    SolverBatchResult& result = results_[i];
+    result = SolverBatchResult();
+    try {
+      result.is_converged =
+          solver->solve(init_xs.size() != 0 ? init_xs[i] : DEFAULT_VECTOR,
+                        init_us.size() != 0 ? init_us[i] : DEFAULT_VECTOR,
+                        maxiter, is_feasible, init_reg);
+    } catch (std::exception& e) {
+      result.error = e.what();
+    }
+    result.iter = solver->get_iter();
+    result.cost = solver->get_cost();
+    result.stop = solver->get_stop();
+    result.ffeas = solver->get_ffeas();
+    result.preg = solver->get_preg();
+  }
+
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  if (is_parallel) {
+    for (std::size_t i = 0; i < n; ++i) {
+      solvers_[i]->get_problem()->set_nthreads(
+          static_cast<int>(problem_nthreads_[i]));
+      const std::shared_ptr<SolverDDP> ddp =
+          std::dynamic_pointer_cast<SolverDDP>(solvers_[i]);
+      if (ddp) {
+        if (ls_nthreads_[i] > 1) {
+          ddp->set_ls_nthreads(static_cast<int>(ls_nthreads_[i]));
+        }
+        if (bp_nthreads_[i] > 1) {
+          ddp->set_bp_nthreads(static_cast<int>(bp_nthreads_[i]));
+        }
+      }
+    }
+  }
+#endif
+
+  bool is_converged = true;
+  for (std::size_t i = 0; i < n; ++i) {
+    is_converged &= results_[i].is_converged;
+  }
+  STOP_PROFILER("SolverBatch::solve");
+  return is_converged;
+}
+
+const std::vector<std::shared_ptr<SolverAbstract> >& SolverBatch::get_solvers()
+    const {
+  return solvers_;
+}
+
+const std::vector<SolverBatchResult>& SolverBatch::get_results() const {
+  return results_;
+}
+
+std::size_t SolverBatch::get_nthreads() const { return nthreads_; }
+
+void SolverBatch::set_solvers(
+    const std::vector<std::shared_ptr<SolverAbstract> >& solvers) {
+  const std::size_t n = solvers.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!solvers[i]) {
+      throw_pretty("Invalid argument: "
+                   << "solver " + std::to_string(i) + " is not defined");
+    }
+    for (std::size_t j = 0; j < i; ++j) {
+      if (solvers[i]->get_problem() == solvers[j]->get_problem()) {
+        throw_pretty("Invalid argument: "
+                     << "solvers " + std::to_string(j) + " and " +
+                            std::to_string(i) + " share the same problem");
+      }
+    }
+  }
+  solvers_ = solvers;
+  results_.resize(n);
+  problem_nthreads_.resize(n, 1);
+  ls_nthreads_.resize(n, 1);
+  bp_nthreads_.resize(n, 1);
+}
+
+void SolverBatch::set_nthreads(const int nthreads) {
+  nthreads_ = getNumberOfThreads(nthreads, "the batch");
+}
+
+}  // namespace crocoddyl
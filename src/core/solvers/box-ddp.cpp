@@ -46,6 +46,8 @@ void SolverBoxDDP::resizeData() {
     Quu_inv_[t].conservativeResize(nu, nu);
     du_lb_[t].conservativeResize(nu);
     du_ub_[t].conservativeResize(nu);
+    clamped_idx_[t].clear();
+    clamped_idx_[t].reserve(nu);
   }
   STOP_PROFILER("SolverBoxDDP::resizeData");
 }
@@ -57,6 +59,7 @@ void SolverBoxDDP::allocateData() {
   Quu_inv_.resize(T);
   du_lb_.resize(T);
   du_ub_.resize(T);
+  clamped_idx_.resize(T);
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
   for (std::size_t t = 0; t < T; ++t) {
@@ -65,6 +68,8 @@ void SolverBoxDDP::allocateData() {
     Quu_inv_[t] = Eigen::MatrixXd::Zero(nu, nu);
     du_lb_[t] = Eigen::VectorXd::Zero(nu);
     du_ub_[t] = Eigen::VectorXd::Zero(nu);
+    clamped_idx_[t].clear();
+    clamped_idx_[t].reserve(nu);
   }
 }
 
@@ -84,7 +89,9 @@ void SolverBoxDDP::computeGains(const std::size_t t) {
 
     START_PROFILER("SolverBoxDDP::boxQP");
     const BoxQPSolution& boxqp_sol =
-        qp_.solve(Quu_[t], Qu_[t], du_lb_[t], du_ub_[t], k_[t]);
+        qp_.solve(Quu_[t], Qu_[t], du_lb_[t], du_ub_[t], k_[t],
+                  clamped_idx_[t]);
+    clamped_idx_[t] = boxqp_sol.clamped_idx;
     START_PROFILER("SolverBoxDDP::boxQP");
 
     // Compute controls
@@ -113,63 +120,72 @@ void SolverBoxDDP::computeGains(const std::size_t t) {
   STOP_PROFILER("SolverBoxDDP::computeGains");
 }
 
-void SolverBoxDDP::forwardPass(double steplength) {
+bool SolverBoxDDP::isRiccatiStepParallelizable(const std::size_t t) const {
+  // The box-QP step is only used for control-limited models in feasible
+  // iterations
+  const std::shared_ptr<ActionModelAbstract>& model =
+      problem_->get_runningModels()[t];
+  return model->get_nu() == 0 || !model->get_has_control_limits() ||
+         !is_feasible_;
+}
+
+double SolverBoxDDP::computeRollout(
+    const double steplength, std::vector<Eigen::VectorXd>& xs_try,
+    std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+    const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+    const std::shared_ptr<ActionDataAbstract>& data_T) {
   if (steplength > 1. || steplength < 0.) {
     throw_pretty("Invalid argument: "
                  << "invalid step length, value is between 0. to 1.");
   }
-  START_PROFILER("SolverBoxDDP::forwardPass");
-  cost_try_ = 0.;
-  xnext_ = problem_->get_x0();
+  double cost_try = 0.;
   const std::size_t T = problem_->get_T();
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
-  const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
-      problem_->get_runningDatas();
   for (std::size_t t = 0; t < T; ++t) {
     const std::shared_ptr<ActionModelAbstract>& m = models[t];
     const std::shared_ptr<ActionDataAbstract>& d = datas[t];
     const std::size_t nu = m->get_nu();
 
-    xs_try_[t] = xnext_;
-    m->get_state()->diff(xs_[t], xs_try_[t], dx_[t]);
+    xs_try[t] = t == 0 ? problem_->get_x0() : datas[t - 1]->xnext;
+    m->get_state()->diff(xs_[t], xs_try[t], dx[t]);
     if (nu != 0) {
-      us_try_[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx_[t];
+      us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
       if (m->get_has_control_limits()) {  // clamp control
-        us_try_[t] = us_try_[t].cwiseMax(m->get_u_lb()).cwiseMin(m->get_u_ub());
+        us_try[t] = us_try[t].cwiseMax(m->get_u_lb()).cwiseMin(m->get_u_ub());
       }
-      m->calc(d, xs_try_[t], us_try_[t]);
+      m->calc(d, xs_try[t], us_try[t]);
     } else {
-      m->calc(d, xs_try_[t]);
+      m->calc(d, xs_try[t]);
     }
-    xnext_ = d->xnext;
-    cost_try_ += d->cost;
+    cost_try += d->cost;
 
-    if (raiseIfNaN(cost_try_)) {
-      STOP_PROFILER("SolverBoxDDP::forwardPass");
+    if (raiseIfNaN(cost_try)) {
       throw_pretty("forward_error");
     }
-    if (raiseIfNaN(xnext_.lpNorm<Eigen::Infinity>())) {
-      STOP_PROFILER("SolverBoxDDP::forwardPass");
+    if (raiseIfNaN(d->xnext.lpNorm<Eigen::Infinity>())) {
       throw_pretty("forward_error");
     }
   }
 
   const std::shared_ptr<ActionModelAbstract>& m = problem_->get_terminalModel();
-  const std::shared_ptr<ActionDataAbstract>& d = problem_->get_terminalData();
+  const Eigen::VectorXd& xnext =
+      T == 0 ? problem_->get_x0() : datas[T - 1]->xnext;
   if ((is_feasible_) || (steplength == 1)) {
-    xs_try_.back() = xnext_;
+    xs_try.back() = xnext;
   } else {
-    m->get_state()->integrate(xnext_, fs_.back() * (steplength - 1),
-                              xs_try_.back());
+    // We re-use the final element of dx for storing the scaled gap of the
+    // terminal node, which avoids allocating a temporary vector
+    dx.back() = fs_.back() * (steplength - 1);
+    m->get_state()->integrate(xnext, dx.back(), xs_try.back());
   }
-  m->calc(d, xs_try_.back());
-  cost_try_ += d->cost;
+  m->calc(data_T, xs_try.back());
+  cost_try += data_T->cost;
 
-  if (raiseIfNaN(cost_try_)) {
-    STOP_PROFILER("SolverBoxDDP::forwardPass");
+  if (raiseIfNaN(cost_try)) {
     throw_pretty("forward_error");
   }
+  return cost_try;
 }
 
 const std::vector<Eigen::MatrixXd>& SolverBoxDDP::get_Quu_inv() const {
@@ -21,16 +21,19 @@ BoxQP::BoxQP(const std::size_t nx, const std::size_t maxiter,
       th_acceptstep_(th_acceptstep),
       th_grad_(th_grad),
       reg_(reg),
+      compute_inverse_(true),
       fold_(0.),
       fnew_(0.),
       x_(nx),
       xnew_(nx),
       g_(nx),
       dx_(nx),
-      xo_(nx),
       dxo_(nx),
       qo_(nx),
-      Ho_(nx, nx) {
+      Hx_(nx),
+      Lff_(nx, nx),
+      w_(nx),
+      factor_valid_(false) {
   // Check if values have a proper range
   if (0. >= th_acceptstep && th_acceptstep >= 0.5) {
     std::cerr << "Warning: th_acceptstep value should between 0 and 0.5"
@@ -48,15 +51,18 @@ BoxQP::BoxQP(const std::size_t nx, const std::size_t maxiter,
   xnew_.setZero();
   g_.setZero();
   dx_.setZero();
-  xo_.setZero();
   dxo_.setZero();
   qo_.setZero();
-  Ho_.setZero();
+  Hx_.setZero();
+  Lff_.setZero();
+  w_.setZero();
 
   // Reserve the space and compute alphas
+  solution_.Hff_inv = Eigen::MatrixXd::Zero(nx, nx);
   solution_.x = Eigen::VectorXd::Zero(nx);
   solution_.clamped_idx.reserve(nx_);
   solution_.free_idx.reserve(nx_);
+  factor_idx_.reserve(nx_);
   const std::size_t n_alphas_ = 10;
   alphas_.resize(n_alphas_);
   for (std::size_t n = 0; n < n_alphas_; ++n) {
@@ -71,6 +77,15 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
                                   const Eigen::VectorXd& lb,
                                   const Eigen::VectorXd& ub,
                                   const Eigen::VectorXd& xinit) {
+  static const std::vector<std::size_t> no_clamped_idx;
+  return solve(H, q, lb, ub, xinit, no_clamped_idx);
+}
+
+const BoxQPSolution& BoxQP::solve(
+    const Eigen::MatrixXd& H, const Eigen::VectorXd& q,
+    const Eigen::VectorXd& lb, const Eigen::VectorXd& ub,
+    const Eigen::VectorXd& xinit,
+    const std::vector<std::size_t>& clamped_init) {
   if (static_cast<std::size_t>(H.rows()) != nx_ ||
       static_cast<std::size_t>(H.cols()) != nx_) {
     throw_pretty("Invalid argument: "
@@ -103,6 +118,31 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
     x_(i) = std::max(std::min(xinit(i), ub(i)), lb(i));
   }
 
+  // Warm-start the active set by moving the initial clamped indexes to the
+  // bounds pointed by the gradient
+  if (!clamped_init.empty()) {
+    g_ = q;
+    g_.noalias() += H * x_;
+    for (std::size_t i = 0; i < clamped_init.size(); ++i) {
+      const std::size_t ci = clamped_init[i];
+      if (ci >= nx_) {
+        throw_pretty("Invalid argument: "
+                     << "clamped_init has an index out of range (it should be "
+                        "lower than " +
+                            std::to_string(nx_) + ")");
+      }
+      if (g_(ci) > 0. && std::isfinite(lb(ci))) {
+        x_(ci) = lb(ci);
+      } else if (g_(ci) < 0. && std::isfinite(ub(ci))) {
+        x_(ci) = ub(ci);
+      }
+    }
+  }
+
+  // The Hessian might change between calls, so we cannot reuse the previous
+  // decomposition
+  factor_valid_ = false;
+
   // Start the numerical iterations
   for (std::size_t k = 0; k < maxiter_; ++k) {
     solution_.clamped_idx.clear();
@@ -125,41 +165,18 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
     // Compute the search direction as Newton step along the free space
     nf_ = solution_.free_idx.size();
     nc_ = solution_.clamped_idx.size();
-    Eigen::VectorBlock<Eigen::VectorXd> xf = xo_.head(nf_);
-    Eigen::VectorBlock<Eigen::VectorXd> xc = xo_.tail(nc_);
     Eigen::VectorBlock<Eigen::VectorXd> dxf = dxo_.head(nf_);
     Eigen::VectorBlock<Eigen::VectorXd> qf = qo_.head(nf_);
-    Eigen::Block<Eigen::MatrixXd> Hff = Ho_.topLeftCorner(nf_, nf_);
-    Eigen::Block<Eigen::MatrixXd> Hfc = Ho_.topRightCorner(nf_, nc_);
+    // The gradient of the free space is Hff * xf + Hfc * xc + qf, plus the
+    // regularization term
     for (std::size_t i = 0; i < nf_; ++i) {
       const std::size_t fi = solution_.free_idx[i];
-      qf(i) = q(fi);
-      xf(i) = x_(fi);
-      for (std::size_t j = 0; j < nf_; ++j) {
-        Hff(i, j) = H(fi, solution_.free_idx[j]);
-      }
-      for (std::size_t j = 0; j < nc_; ++j) {
-        const std::size_t cj = solution_.clamped_idx[j];
-        xc(j) = x_(cj);
-        Hfc(i, j) = H(fi, cj);
-      }
-    }
-    if (reg_ != 0.) {
-      Hff.diagonal().array() += reg_;
-    }
-    Hff_inv_llt_.compute(Hff);
-    const Eigen::ComputationInfo& info = Hff_inv_llt_.info();
-    if (info != Eigen::Success) {
-      throw_pretty("backward_error");
-    }
-    solution_.Hff_inv.setIdentity(nf_, nf_);
-    Hff_inv_llt_.solveInPlace(solution_.Hff_inv);
-    qf.noalias() += Hff * xf;
-    if (nc_ != 0) {
-      qf.noalias() += Hfc * xc;
+      qf(i) = g_(fi) + reg_ * x_(fi);
     }
+    // The Cholesky decomposition of Hff is updated when the free space changes
+    updateFactorization(H);
     dxf = -qf;
-    Hff_inv_llt_.solveInPlace(dxf);
+    solveFreeInPlace(dxf);
     dx_.setZero();
     for (std::size_t i = 0; i < nf_; ++i) {
       dx_(solution_.free_idx[i]) = dxf(i);
@@ -167,7 +184,8 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
     }
 
     // Try different step lengths
-    fold_ = 0.5 * x_.dot(H * x_) + q.dot(x_);
+    Hx_.noalias() = H * x_;
+    fold_ = 0.5 * x_.dot(Hx_) + q.dot(x_);
     for (std::vector<double>::const_iterator it = alphas_.begin();
          it != alphas_.end(); ++it) {
       double steplength = *it;
@@ -175,7 +193,8 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
         xnew_(i) =
             std::max(std::min(x_(i) + steplength * dx_(i), ub(i)), lb(i));
       }
-      fnew_ = 0.5 * xnew_.dot(H * xnew_) + q.dot(xnew_);
+      Hx_.noalias() = H * xnew_;
+      fnew_ = 0.5 * xnew_.dot(Hx_) + q.dot(xnew_);
       if (fold_ - fnew_ > th_acceptstep_ * g_.dot(x_ - xnew_)) {
         x_ = xnew_;
         break;
@@ -184,14 +203,168 @@ const BoxQPSolution& BoxQP::solve(const Eigen::MatrixXd& H,
 
     // Check convergence
     if (qf.lpNorm<Eigen::Infinity>() <= th_grad_) {
-      solution_.x = x_;
-      return solution_;
+      break;
     }
   }
+
+  // The inverse is only needed for the free space of the returned solution,
+  // so we compute it once from its Cholesky decomposition
+  if (compute_inverse_ && factor_valid_) {
+    solution_.Hff_inv.setZero();
+    Eigen::Block<Eigen::MatrixXd> Hff_inv =
+        solution_.Hff_inv.topLeftCorner(nf_, nf_);
+    Hff_inv.setIdentity();
+    solveFreeInPlace(Hff_inv);
+  }
   solution_.x = x_;
   return solution_;
 }
 
+void BoxQP::solveFreeInPlace(Eigen::Ref<Eigen::MatrixXd> B) const {
+  if (static_cast<std::size_t>(B.rows()) != nf_) {
+    throw_pretty(
+        "Invalid argument: " << "B has wrong number of rows (it should be " +
+                                    std::to_string(nf_) + ")");
+  }
+  Lff_.topLeftCorner(nf_, nf_).triangularView<Eigen::Lower>().solveInPlace(B);
+  Lff_.topLeftCorner(nf_, nf_)
+      .triangularView<Eigen::Lower>()
+      .adjoint()
+      .solveInPlace(B);
+}
+
+void BoxQP::updateFactorization(const Eigen::MatrixXd& H) {
+  const std::vector<std::size_t>& free_idx = solution_.free_idx;
+  if (factor_valid_) {
+    // Both sets of indexes are sorted, so we find their differences in a
+    // single pass
+    const std::size_t nfo = factor_idx_.size();
+    std::size_t i = 0, j = 0;
+    std::size_t n_added = 0, n_removed = 0, p_added = 0, p_removed = 0;
+    while (i < nf_ || j < nfo) {
+      if (i < nf_ && j < nfo && free_idx[i] == factor_idx_[j]) {
+        ++i;
+        ++j;
+      } else if (j == nfo || (i < nf_ && free_idx[i] < factor_idx_[j])) {
+        p_added = i++;
+        ++n_added;
+      } else {
+        p_removed = j++;
+        ++n_removed;
+      }
+    }
+    if (n_added + n_removed == 0) {
+      return;
+    }
+    if (n_added + n_removed == 1) {
+      bool success = true;
+      if (n_added == 1) {
+        success = addFreeIndex(H, p_added);
+      } else {
+        removeFreeIndex(p_removed);
+      }
+      if (success) {
+        factor_idx_ = free_idx;
+        return;
+      }
+    }
+  }
+
+  // Factorize the free space Hessian from scratch. The Cholesky decomposition
+  // overwrites Lff, which avoids allocating memory when the dimension of the
+  // free space changes
+  Eigen::Block<Eigen::MatrixXd> Lff = Lff_.topLeftCorner(nf_, nf_);
+  for (std::size_t i = 0; i < nf_; ++i) {
+    const std::size_t fi = free_idx[i];
+    for (std::size_t j = 0; j <= i; ++j) {
+      Lff(i, j) = H(fi, free_idx[j]);
+    }
+    Lff(i, i) += reg_;
+  }
+  factor_valid_ = false;
+  Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > Hff_llt(Lff);
+  const Eigen::ComputationInfo& info = Hff_llt.info();
+  if (info != Eigen::Success) {
+    throw_pretty("backward_error");
+  }
+  factor_idx_ = free_idx;
+  factor_valid_ = true;
+}
+
+bool BoxQP::addFreeIndex(const Eigen::MatrixXd& H, const std::size_t p) {
+  const std::vector<std::size_t>& free_idx = solution_.free_idx;
+  const std::size_t fi = free_idx[p];
+  // Shift the rows and columns after the new index
+  for (std::size_t i = nf_ - 1; i-- > p;) {
+    for (std::size_t j = 0; j <= i; ++j) {
+      Lff_(i + 1, j < p ? j : j + 1) = Lff_(i, j);
+    }
+  }
+  // Compute the new row, i.e., L11 * l21 = H1p and l22^2 = Hpp - l21^T * l21
+  for (std::size_t k = 0; k < p; ++k) {
+    w_(k) = H(free_idx[k], fi);
+  }
+  Lff_.topLeftCorner(p, p).triangularView<Eigen::Lower>().solveInPlace(
+      w_.head(p));
+  const double d = H(fi, fi) + reg_ - w_.head(p).squaredNorm();
+  if (d <= 0.) {
+    return false;
+  }
+  const double lpp = std::sqrt(d);
+  Lff_.row(p).head(p) = w_.head(p).transpose();
+  Lff_(p, p) = lpp;
+  // Compute the new column, i.e., l32 = (H3p - L31 * l21) / l22, and downdate
+  // the trailing block with it
+  for (std::size_t i = p + 1; i < nf_; ++i) {
+    Lff_(i, p) =
+        (H(free_idx[i], fi) - Lff_.row(i).head(p).dot(w_.head(p))) / lpp;
+  }
+  const std::size_t m = nf_ - p - 1;
+  w_.segment(p + 1, m) = Lff_.col(p).segment(p + 1, m);
+  return rankUpdate(p + 1, m, -1.);
+}
+
+void BoxQP::removeFreeIndex(const std::size_t p) {
+  const std::size_t n = factor_idx_.size();
+  const std::size_t m = n - p - 1;
+  w_.segment(p, m) = Lff_.col(p).segment(p + 1, m);
+  // Shift the rows and columns after the removed index
+  for (std::size_t i = p + 1; i < n; ++i) {
+    for (std::size_t j = 0; j <= i; ++j) {
+      if (j != p) {
+        Lff_(i - 1, j < p ? j : j - 1) = Lff_(i, j);
+      }
+    }
+  }
+  // An update never breaks down
+  rankUpdate(p, m, 1.);
+}
+
+bool BoxQP::rankUpdate(const std::size_t k0, const std::size_t n,
+                       const double sigma) {
+  for (std::size_t k = k0; k < k0 + n; ++k) {
+    const double lkk = Lff_(k, k);
+    const double wk = w_(k);
+    const double r2 = lkk * lkk + sigma * wk * wk;
+    if (r2 <= 0.) {
+      return false;
+    }
+    const double r = std::sqrt(r2);
+    const double c = r / lkk;
+    const double s = wk / lkk;
+    Lff_(k, k) = r;
+    const std::size_t m = k0 + n - k - 1;
+    if (m > 0) {
+      Lff_.col(k).segment(k + 1, m) =
+          (Lff_.col(k).segment(k + 1, m) + sigma * s * w_.segment(k + 1, m)) /
+          c;
+      w_.segment(k + 1, m) =
+          c * w_.segment(k + 1, m) - s * Lff_.col(k).segment(k + 1, m);
+    }
+  }
+  return true;
+}
+
 const BoxQPSolution& BoxQP::get_solution() const { return solution_; }
 
 std::size_t BoxQP::get_nx() const { return nx_; }
@@ -206,16 +379,25 @@ double BoxQP::get_reg() const { return reg_; }
 
 const std::vector<double>& BoxQP::get_alphas() const { return alphas_; }
 
+bool BoxQP::get_compute_inverse() const { return compute_inverse_; }
+
 void BoxQP::set_nx(const std::size_t nx) {
   nx_ = nx;
   x_.conservativeResize(nx);
   xnew_.conservativeResize(nx);
   g_.conservativeResize(nx);
   dx_.conservativeResize(nx);
-  xo_.conservativeResize(nx);
   dxo_.conservativeResize(nx);
   qo_.conservativeResize(nx);
-  Ho_.conservativeResize(nx, nx);
+  Hx_.conservativeResize(nx);
+  Lff_.conservativeResize(nx, nx);
+  w_.conservativeResize(nx);
+  solution_.Hff_inv.conservativeResize(nx, nx);
+  solution_.x.conservativeResize(nx);
+  solution_.clamped_idx.reserve(nx);
+  solution_.free_idx.reserve(nx);
+  factor_idx_.reserve(nx);
+  factor_valid_ = false;
 }
 
 void BoxQP::set_maxiter(const std::size_t maxiter) { maxiter_ = maxiter; }
@@ -261,4 +443,8 @@ void BoxQP::set_alphas(const std::vector<double>& alphas) {
   alphas_ = alphas;
 }
 
+void BoxQP::set_compute_inverse(const bool compute_inverse) {
+  compute_inverse_ = compute_inverse;
+}
+
 }  // namespace crocoddyl
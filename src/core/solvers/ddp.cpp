@@ -7,11 +7,16 @@
 // All rights reserved.
 ///////////////////////////////////////////////////////////////////////////////
 
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif  // CROCODDYL_WITH_MULTITHREADING
+
 #include "crocoddyl/core/solvers/ddp.hpp"
 
 #include <iostream>
 
 #include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/malloc-guard.hpp"
 
 namespace crocoddyl {
 
@@ -22,6 +27,11 @@ SolverDDP::SolverDDP(std::shared_ptr<ShootingProblem> problem)
       reg_min_(1e-9),
       reg_max_(1e9),
       cost_try_(0.),
+      ls_nthreads_(1),
+      ls_recalc_(false),
+      bp_nthreads_(1),
+      bp_fixed_size_(false),
+      bp_fixed_step_(NULL),
       th_grad_(1e-12),
       th_stepdec_(0.5),
       th_stepinc_(0.01) {
@@ -63,6 +73,8 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
   }
   was_feasible_ = false;
 
+  // The iterations should not allocate memory
+  MallocGuard guard;
   bool recalcDiff = true;
   for (iter_ = 0; iter_ < maxiter; ++iter_) {
     while (true) {
@@ -83,12 +95,12 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
 
     // We need to recalculate the derivatives when the step length passes
     recalcDiff = false;
-    for (std::vector<double>::const_iterator it = alphas_.begin();
-         it != alphas_.end(); ++it) {
-      steplength_ = *it;
+    const std::size_t n_alphas = alphas_.size();
+    for (std::size_t i = 0; i < n_alphas; ++i) {
+      steplength_ = alphas_[i];
 
       try {
-        dV_ = tryStep(steplength_);
+        dV_ = tryLineSearchStep(i);
       } catch (std::exception& e) {
         continue;
       }
@@ -100,6 +112,7 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
           was_feasible_ = is_feasible_;
           setCandidate(xs_try_, us_try_, true);
           cost_ = cost_try_;
+          acceptLineSearchStep();
           recalcDiff = true;
           break;
         }
@@ -120,6 +133,7 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
 
     const std::size_t n_callbacks = callbacks_.size();
     for (std::size_t c = 0; c < n_callbacks; ++c) {
+      MallocGuard allow(true);
       CallbackAbstract& callback = *callbacks_[c];
       callback(*this);
     }
@@ -196,6 +210,9 @@ void SolverDDP::resizeData() {
       FuTVxx_p_[t].setZero();
     }
   }
+  resizeLineSearchData();
+  resizeBackwardPassData();
+  updateFixedSizeBackwardPassStep();
   STOP_PROFILER("SolverDDP::resizeData");
 }
 
@@ -204,7 +221,13 @@ double SolverDDP::calcDiff() {
   if (iter_ == 0) {
     problem_->calc(xs_, us_);
   }
-  cost_ = problem_->calcDiff(xs_, us_);
+  if (problem_->get_second_order()) {
+    // The costates are taken from the last backward pass, as they are not
+    // known until the backward pass of this iteration
+    cost_ = problem_->calcDiff(xs_, us_, Vx_);
+  } else {
+    cost_ = problem_->calcDiff(xs_, us_);
+  }
 
   ffeas_ = computeDynamicFeasibility();
   gfeas_ = computeInequalityFeasibility();
@@ -214,6 +237,10 @@ double SolverDDP::calcDiff() {
 }
 
 void SolverDDP::backwardPass() {
+  if (bp_nthreads_ > 1 && !problem_->get_second_order() &&
+      backwardPassParallel()) {
+    return;
+  }
   START_PROFILER("SolverDDP::backwardPass");
   const std::shared_ptr<ActionDataAbstract>& d_T = problem_->get_terminalData();
   Vxx_.back() = d_T->Lxx;
@@ -226,82 +253,203 @@ void SolverDDP::backwardPass() {
   if (!is_feasible_) {
     Vx_.back().noalias() += Vxx_.back() * fs_.back();
   }
-  const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
-      problem_->get_runningModels();
-  const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
-      problem_->get_runningDatas();
   for (int t = static_cast<int>(problem_->get_T()) - 1; t >= 0; --t) {
-    const std::shared_ptr<ActionModelAbstract>& m = models[t];
-    const std::shared_ptr<ActionDataAbstract>& d = datas[t];
+    computeBackwardPassStep(t);
+  }
+  STOP_PROFILER("SolverDDP::backwardPass");
+}
 
-    // Compute the linear-quadratic approximation of the control Hamiltonian
-    // function
-    computeActionValueFunction(t, m, d);
+bool SolverDDP::backwardPassParallel() {
+  START_PROFILER("SolverDDP::backwardPassParallel");
+  if (bp_nthreads_ <= 1) {
+    // The workspaces are only allocated for more than one thread
+    STOP_PROFILER("SolverDDP::backwardPassParallel");
+    return false;
+  }
+  const std::size_t T = problem_->get_T();
 
-    // Compute the feedforward and feedback gains
-    computeGains(t);
+  // Partition the nodes with parallelizable Riccati steps into chunks of
+  // similar length
+  std::size_t n = 0;
+  for (std::size_t t = 0; t < T; ++t) {
+    if (isRiccatiStepParallelizable(t)) {
+      ++n;
+    }
+  }
+  const std::size_t length = (n + bp_nthreads_ - 1) / bp_nthreads_;
+  bp_chunks_.clear();
+  for (std::size_t t = 0; t < T; ++t) {
+    if (!isRiccatiStepParallelizable(t)) {
+      continue;
+    }
+    if (bp_chunks_.empty() || bp_chunks_.back().second != t ||
+        bp_chunks_.back().second - bp_chunks_.back().first == length) {
+      bp_chunks_.push_back(std::make_pair(t, t + 1));
+    } else {
+      ++bp_chunks_.back().second;
+    }
+  }
+  const std::size_t nchunks = bp_chunks_.size();
+  if (nchunks == 0) {
+    STOP_PROFILER("SolverDDP::backwardPassParallel");
+    return false;
+  }
 
-    // Compute the linear-quadratic approximation of the Value function
-    computeValueFunction(t, m);
+  // Build and combine the Riccati elements of each chunk. The k-th thread
+  // handles the k-th, (k+nthreads)-th, ... chunks with its own workspace
+  const std::size_t nthreads = std::min(bp_nthreads_, nchunks);
+  bool is_valid = true;
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads) reduction(&& : is_valid)
+#endif
+  for (std::size_t k = 0; k < nthreads; ++k) {
+    for (std::size_t i = k; i < nchunks; i += nthreads) {
+      const std::size_t first = bp_chunks_[i].first;
+      const std::size_t last = bp_chunks_[i].second;
+      for (std::size_t t = last; t > first && is_valid; --t) {
+        if (!computeRiccatiElement(t - 1)) {
+          is_valid = false;
+        } else if (t < last) {
+          combineRiccatiElements(t - 1, k);
+        }
+      }
+      if (is_valid && (raiseIfNaN(bp_J_[first].lpNorm<Eigen::Infinity>()) ||
+                       raiseIfNaN(bp_eta_[first].lpNorm<Eigen::Infinity>()))) {
+        is_valid = false;
+      }
+    }
+  }
+  if (!is_valid) {
+    STOP_PROFILER("SolverDDP::backwardPassParallel");
+    return false;
+  }
 
-    if (raiseIfNaN(Vx_[t].lpNorm<Eigen::Infinity>())) {
+  // Stitch the Value functions at the first node of each chunk. The nodes that
+  // do not belong to any chunk run the serial Riccati step
+  const std::shared_ptr<ActionDataAbstract>& d_T = problem_->get_terminalData();
+  Vxx_.back() = d_T->Lxx;
+  Vx_.back() = d_T->Lx;
+  if (!std::isnan(preg_)) {
+    Vxx_.back().diagonal().array() += preg_;
+  }
+  if (!is_feasible_) {
+    Vx_.back().noalias() += Vxx_.back() * fs_.back();
+  }
+  std::size_t t_next = T;
+  for (std::size_t i = nchunks; i > 0; --i) {
+    const std::size_t first = bp_chunks_[i - 1].first;
+    const std::size_t last = bp_chunks_[i - 1].second;
+    for (std::size_t t = t_next; t > last; --t) {
+      computeBackwardPassStep(t - 1);
+    }
+    computeRiccatiValueFunction(first, last, 0);
+    if (raiseIfNaN(Vx_[first].lpNorm<Eigen::Infinity>())) {
       throw_pretty("backward_error");
     }
-    if (raiseIfNaN(Vxx_[t].lpNorm<Eigen::Infinity>())) {
+    if (raiseIfNaN(Vxx_[first].lpNorm<Eigen::Infinity>())) {
       throw_pretty("backward_error");
     }
+    t_next = first;
   }
-  STOP_PROFILER("SolverDDP::backwardPass");
+  for (std::size_t t = t_next; t > 0; --t) {
+    computeBackwardPassStep(t - 1);
+  }
+
+  // Compute the Value functions and gains of each chunk
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads) reduction(&& : is_valid)
+#endif
+  for (std::size_t k = 0; k < nthreads; ++k) {
+    for (std::size_t i = k; i < nchunks; i += nthreads) {
+      const std::size_t first = bp_chunks_[i].first;
+      const std::size_t last = bp_chunks_[i].second;
+      for (std::size_t t = last; t > first && is_valid; --t) {
+        if (t - 1 != first) {
+          computeRiccatiValueFunction(t - 1, last, k);
+          if (raiseIfNaN(Vx_[t - 1].lpNorm<Eigen::Infinity>()) ||
+              raiseIfNaN(Vxx_[t - 1].lpNorm<Eigen::Infinity>())) {
+            is_valid = false;
+          }
+        }
+        if (is_valid && !computeRiccatiGains(t - 1, k)) {
+          is_valid = false;
+        }
+      }
+    }
+  }
+  if (!is_valid) {
+    STOP_PROFILER("SolverDDP::backwardPassParallel");
+    throw_pretty("backward_error");
+  }
+  STOP_PROFILER("SolverDDP::backwardPassParallel");
+  return true;
 }
 
+bool SolverDDP::isRiccatiStepParallelizable(const std::size_t) const {
+  return true;
+}
+
+bool SolverDDP::isLineSearchParallelizable() const { return true; }
+
 void SolverDDP::forwardPass(const double steplength) {
+  START_PROFILER("SolverDDP::forwardPass");
+  try {
+    cost_try_ = computeRollout(steplength, xs_try_, us_try_, dx_,
+                               problem_->get_runningDatas(),
+                               problem_->get_terminalData());
+  } catch (std::exception& e) {
+    STOP_PROFILER("SolverDDP::forwardPass");
+    throw;
+  }
+  STOP_PROFILER("SolverDDP::forwardPass");
+}
+
+double SolverDDP::computeRollout(
+    const double steplength, std::vector<Eigen::VectorXd>& xs_try,
+    std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+    const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+    const std::shared_ptr<ActionDataAbstract>& data_T) {
   if (steplength > 1. || steplength < 0.) {
     throw_pretty("Invalid argument: "
                  << "invalid step length, value is between 0. to 1.");
   }
-  START_PROFILER("SolverDDP::forwardPass");
-  cost_try_ = 0.;
+  double cost_try = 0.;
   const std::size_t T = problem_->get_T();
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
-  const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
-      problem_->get_runningDatas();
+  xs_try[0] = problem_->get_x0();
   for (std::size_t t = 0; t < T; ++t) {
     const std::shared_ptr<ActionModelAbstract>& m = models[t];
     const std::shared_ptr<ActionDataAbstract>& d = datas[t];
 
-    m->get_state()->diff(xs_[t], xs_try_[t], dx_[t]);
+    m->get_state()->diff(xs_[t], xs_try[t], dx[t]);
     if (m->get_nu() != 0) {
-      us_try_[t].noalias() = us_[t];
-      us_try_[t].noalias() -= k_[t] * steplength;
-      us_try_[t].noalias() -= K_[t] * dx_[t];
-      m->calc(d, xs_try_[t], us_try_[t]);
+      us_try[t].noalias() = us_[t];
+      us_try[t].noalias() -= k_[t] * steplength;
+      us_try[t].noalias() -= K_[t] * dx[t];
+      m->calc(d, xs_try[t], us_try[t]);
     } else {
-      m->calc(d, xs_try_[t]);
+      m->calc(d, xs_try[t]);
     }
-    xs_try_[t + 1] = d->xnext;
-    cost_try_ += d->cost;
+    xs_try[t + 1] = d->xnext;
+    cost_try += d->cost;
 
-    if (raiseIfNaN(cost_try_)) {
-      STOP_PROFILER("SolverDDP::forwardPass");
+    if (raiseIfNaN(cost_try)) {
       throw_pretty("forward_error");
     }
-    if (raiseIfNaN(xs_try_[t + 1].lpNorm<Eigen::Infinity>())) {
-      STOP_PROFILER("SolverDDP::forwardPass");
+    if (raiseIfNaN(xs_try[t + 1].lpNorm<Eigen::Infinity>())) {
       throw_pretty("forward_error");
     }
   }
 
   const std::shared_ptr<ActionModelAbstract>& m = problem_->get_terminalModel();
-  const std::shared_ptr<ActionDataAbstract>& d = problem_->get_terminalData();
-  m->calc(d, xs_try_.back());
-  cost_try_ += d->cost;
+  m->calc(data_T, xs_try.back());
+  cost_try += data_T->cost;
 
-  if (raiseIfNaN(cost_try_)) {
-    STOP_PROFILER("SolverDDP::forwardPass");
+  if (raiseIfNaN(cost_try)) {
     throw_pretty("forward_error");
   }
-  STOP_PROFILER("SolverDDP::forwardPass");
+  return cost_try;
 }
 
 void SolverDDP::computeActionValueFunction(
@@ -337,9 +485,20 @@ void SolverDDP::computeActionValueFunction(
     Qxu_[t] = data->Lxu;
     Qxu_[t].noalias() += FxTVxx_p_ * data->Fu;
     STOP_PROFILER("SolverDDP::Qxu");
-    if (!std::isnan(preg_)) {
-      Quu_[t].diagonal().array() += preg_;
+  }
+  if (problem_->get_second_order()) {
+    START_PROFILER("SolverDDP::Qzz_second_order");
+    const Eigen::MatrixXd& Fzz_p = problem_->get_dynamicsHessians()[t];
+    const std::size_t ndx = Qxx_[t].rows();
+    Qxx_[t] += Fzz_p.topLeftCorner(ndx, ndx);
+    if (nu != 0) {
+      Qxu_[t] += Fzz_p.topRightCorner(ndx, nu);
+      Quu_[t] += Fzz_p.bottomRightCorner(nu, nu);
     }
+    STOP_PROFILER("SolverDDP::Qzz_second_order");
+  }
+  if (nu != 0 && !std::isnan(preg_)) {
+    Quu_[t].diagonal().array() += preg_;
   }
 }
 
@@ -399,6 +558,352 @@ void SolverDDP::computeGains(const std::size_t t) {
   STOP_PROFILER("SolverDDP::computeGains");
 }
 
+void SolverDDP::computeBackwardPassStep(const std::size_t t) {
+  if (bp_fixed_step_ != NULL && !problem_->get_second_order() &&
+      isRiccatiStepParallelizable(t)) {
+    (this->*bp_fixed_step_)(t);
+  } else {
+    const std::shared_ptr<ActionModelAbstract>& m =
+        problem_->get_runningModels()[t];
+    const std::shared_ptr<ActionDataAbstract>& d =
+        problem_->get_runningDatas()[t];
+
+    // Compute the linear-quadratic approximation of the control Hamiltonian
+    // function
+    computeActionValueFunction(t, m, d);
+
+    // Compute the feedforward and feedback gains
+    computeGains(t);
+
+    // Compute the linear-quadratic approximation of the Value function
+    computeValueFunction(t, m);
+  }
+
+  if (raiseIfNaN(Vx_[t].lpNorm<Eigen::Infinity>())) {
+    throw_pretty("backward_error");
+  }
+  if (raiseIfNaN(Vxx_[t].lpNorm<Eigen::Infinity>())) {
+    throw_pretty("backward_error");
+  }
+}
+
+template <int NDX, int NU>
+void SolverDDP::computeFixedSizeBackwardPassStep(const std::size_t t) {
+  START_PROFILER("SolverDDP::computeFixedSizeBackwardPassStep");
+  typedef Eigen::Matrix<double, NDX, 1> VectorNdx;
+  typedef Eigen::Matrix<double, NU, 1> VectorNu;
+  typedef Eigen::Matrix<double, NDX, NDX> MatrixNdx;
+  typedef Eigen::Matrix<double, NDX, NU> MatrixNdxNu;
+  typedef Eigen::Matrix<double, NU, NU> MatrixNu;
+  typedef Eigen::Matrix<double, NU, NDX, Eigen::RowMajor> MatrixNuNdxRowMajor;
+  const ActionDataAbstract& d = *problem_->get_runningDatas()[t];
+  const Eigen::Map<const MatrixNdx> Fx(d.Fx.data());
+  const Eigen::Map<const MatrixNdxNu> Fu(d.Fu.data());
+  const Eigen::Map<const VectorNdx> Vx_p(Vx_[t + 1].data());
+  const Eigen::Map<const MatrixNdx> Vxx_p(Vxx_[t + 1].data());
+  Eigen::Map<VectorNdx> Qx(Qx_[t].data());
+  Eigen::Map<VectorNu> Qu(Qu_[t].data());
+  Eigen::Map<MatrixNdx> Qxx(Qxx_[t].data());
+  Eigen::Map<MatrixNdxNu> Qxu(Qxu_[t].data());
+  Eigen::Map<MatrixNu> Quu(Quu_[t].data());
+  Eigen::Map<MatrixNuNdxRowMajor> FuTVxx_p(FuTVxx_p_[t].data());
+  Eigen::Map<MatrixNuNdxRowMajor> K(K_[t].data());
+  Eigen::Map<VectorNu> k(k_[t].data());
+  Eigen::Map<VectorNu> Quuk(Quuk_[t].data());
+  Eigen::Map<VectorNdx> Vx(Vx_[t].data());
+  Eigen::Map<MatrixNdx> Vxx(Vxx_[t].data());
+
+  // Compute the linear-quadratic approximation of the control Hamiltonian
+  // function
+  const MatrixNdx FxTVxx_p = Fx.transpose() * Vxx_p;
+  FuTVxx_p.noalias() = Fu.transpose() * Vxx_p;
+  Qx = Eigen::Map<const VectorNdx>(d.Lx.data());
+  Qx.noalias() += Fx.transpose() * Vx_p;
+  Qu = Eigen::Map<const VectorNu>(d.Lu.data());
+  Qu.noalias() += Fu.transpose() * Vx_p;
+  Qxx = Eigen::Map<const MatrixNdx>(d.Lxx.data());
+  Qxx.noalias() += FxTVxx_p * Fx;
+  Qxu = Eigen::Map<const MatrixNdxNu>(d.Lxu.data());
+  Qxu.noalias() += FxTVxx_p * Fu;
+  Quu = Eigen::Map<const MatrixNu>(d.Luu.data());
+  Quu.noalias() += FuTVxx_p * Fu;
+  if (!std::isnan(preg_)) {
+    Quu.diagonal().array() += preg_;
+  }
+
+  // Compute the feedforward and feedback gains
+  const Eigen::LLT<MatrixNu> Quu_llt(Quu);
+  if (Quu_llt.info() != Eigen::Success) {
+    STOP_PROFILER("SolverDDP::computeFixedSizeBackwardPassStep");
+    throw_pretty("backward_error");
+  }
+  K = Qxu.transpose();
+  Quu_llt.solveInPlace(K);
+  k = Qu;
+  Quu_llt.solveInPlace(k);
+
+  // Compute the linear-quadratic approximation of the Value function
+  Quuk.noalias() = Quu * k;
+  Vx = Qx;
+  Vx.noalias() -= K.transpose() * Qu;
+  MatrixNdx Vxx_tmp = Qxx;
+  Vxx_tmp.noalias() -= Qxu * K;
+  Vxx = 0.5 * (Vxx_tmp + Vxx_tmp.transpose());
+  if (!std::isnan(preg_)) {
+    Vxx.diagonal().array() += preg_;
+  }
+  if (!is_feasible_) {
+    Vx.noalias() += Vxx * Eigen::Map<const VectorNdx>(fs_[t].data());
+  }
+  STOP_PROFILER("SolverDDP::computeFixedSizeBackwardPassStep");
+}
+
+void SolverDDP::updateFixedSizeBackwardPassStep() {
+  bp_fixed_step_ = NULL;
+  if (!bp_fixed_size_) {
+    return;
+  }
+  const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
+      problem_->get_runningModels();
+  if (models.empty()) {
+    return;
+  }
+  const std::size_t nu = models[0]->get_nu();
+  for (std::size_t t = 1; t < models.size(); ++t) {
+    if (models[t]->get_nu() != nu) {
+      return;
+    }
+  }
+  const std::size_t ndx = problem_->get_ndx();
+  if (ndx == 2 && nu == 1) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<2, 1>;
+  } else if (ndx == 3 && nu == 2) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<3, 2>;
+  } else if (ndx == 4 && nu == 2) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<4, 2>;
+  } else if (ndx == 8 && nu == 4) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<8, 4>;
+  } else if (ndx == 12 && nu == 4) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<12, 4>;
+  } else if (ndx == 12 && nu == 6) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<12, 6>;
+  } else if (ndx == 14 && nu == 7) {
+    bp_fixed_step_ = &SolverDDP::computeFixedSizeBackwardPassStep<14, 7>;
+  }
+}
+
+bool SolverDDP::computeRiccatiElement(const std::size_t t) {
+  const std::shared_ptr<ActionDataAbstract>& d =
+      problem_->get_runningDatas()[t];
+  const std::size_t nu = problem_->get_runningModels()[t]->get_nu();
+  bp_A_[t] = d->Fx;
+  if (is_feasible_) {
+    bp_b_[t].setZero();
+  } else {
+    bp_b_[t] = fs_[t + 1];
+  }
+  bp_J_[t] = d->Lxx;
+  bp_eta_[t] = -d->Lx;
+  if (!std::isnan(preg_)) {
+    bp_J_[t].diagonal().array() += preg_;
+  }
+  if (nu == 0) {
+    bp_C_[t].setZero();
+    return true;
+  }
+
+  // The gains and Hamiltonian terms are used as temporary variables, since
+  // they are overwritten once the Value functions are known
+  Quu_[t] = d->Luu;
+  if (!std::isnan(preg_)) {
+    Quu_[t].diagonal().array() += preg_;
+  }
+  Quu_llt_[t].compute(Quu_[t]);
+  if (Quu_llt_[t].info() != Eigen::Success) {
+    return false;
+  }
+  K_[t] = d->Lxu.transpose();
+  Quu_llt_[t].solveInPlace(K_[t]);
+  k_[t] = d->Lu;
+  Quu_llt_[t].solveInPlace(k_[t]);
+  FuTVxx_p_[t] = d->Fu.transpose();
+  Quu_llt_[t].solveInPlace(FuTVxx_p_[t]);
+  bp_A_[t].noalias() -= d->Fu * K_[t];
+  bp_b_[t].noalias() -= d->Fu * k_[t];
+  bp_C_[t].noalias() = d->Fu * FuTVxx_p_[t];
+  bp_J_[t].noalias() -= d->Lxu * K_[t];
+  bp_eta_[t].noalias() += d->Lxu * k_[t];
+  return true;
+}
+
+void SolverDDP::combineRiccatiElements(const std::size_t t,
+                                       const std::size_t k) {
+  const std::size_t l = t + 1;
+  Eigen::PartialPivLU<Eigen::MatrixXd>& lu = bp_lu_[k];
+  Eigen::MatrixXd& MA = bp_MA_[k];
+  Eigen::MatrixXd& MC = bp_MC_[k];
+  Eigen::MatrixXd& tmp = bp_tmp_[k];
+  Eigen::VectorXd& v = bp_v_[k];
+  Eigen::VectorXd& w = bp_w_[k];
+
+  // M = (I + C_t J_l)^{-1}
+  tmp.noalias() = bp_C_[t] * bp_J_[l];
+  tmp.diagonal().array() += 1.;
+  lu.compute(tmp);
+  MA = lu.solve(bp_A_[t]);
+  MC = lu.solve(bp_C_[t]);
+  v = bp_b_[t];
+  v.noalias() += bp_C_[t] * bp_eta_[l];
+  w = lu.solve(v);
+
+  // Combine the costate terms
+  v = bp_eta_[l];
+  v.noalias() -= bp_J_[l] * bp_b_[t];
+  bp_eta_[t].noalias() += MA.transpose() * v;
+  tmp.noalias() = bp_J_[l] * bp_A_[t];
+  bp_J_[t].noalias() += MA.transpose() * tmp;
+  tmp = 0.5 * (bp_J_[t] + bp_J_[t].transpose());
+  bp_J_[t] = tmp;
+
+  // Combine the state terms
+  bp_A_[t].noalias() = bp_A_[l] * MA;
+  bp_b_[t] = bp_b_[l];
+  bp_b_[t].noalias() += bp_A_[l] * w;
+  tmp.noalias() = MC * bp_A_[l].transpose();
+  bp_C_[t] = bp_C_[l];
+  bp_C_[t].noalias() += bp_A_[l] * tmp;
+  MA = 0.5 * (bp_C_[t] + bp_C_[t].transpose());
+  bp_C_[t] = MA;
+}
+
+void SolverDDP::computeRiccatiValueFunction(const std::size_t t,
+                                            const std::size_t e,
+                                            const std::size_t k) {
+  const Eigen::MatrixXd& Vxx_e = Vxx_[e];
+  Eigen::PartialPivLU<Eigen::MatrixXd>& lu = bp_lu_[k];
+  Eigen::MatrixXd& MA = bp_MA_[k];
+  Eigen::MatrixXd& tmp = bp_tmp_[k];
+  Eigen::VectorXd& w = bp_w_[k];
+
+  // Vx_ stores the gradient at the rollout state, so we remove the gap
+  // contribution to combine it with the element
+  w = Vx_[e];
+  if (!is_feasible_) {
+    w.noalias() -= Vxx_e * fs_[e];
+  }
+  w.noalias() += Vxx_e * bp_b_[t];
+  tmp.noalias() = bp_C_[t] * Vxx_e;
+  tmp.diagonal().array() += 1.;
+  lu.compute(tmp);
+  MA = lu.solve(bp_A_[t]);
+
+  tmp.noalias() = Vxx_e * bp_A_[t];
+  Vxx_[t] = bp_J_[t];
+  Vxx_[t].noalias() += MA.transpose() * tmp;
+  tmp = 0.5 * (Vxx_[t] + Vxx_[t].transpose());
+  Vxx_[t] = tmp;
+  Vx_[t] = -bp_eta_[t];
+  Vx_[t].noalias() += MA.transpose() * w;
+  if (!is_feasible_) {
+    Vx_[t].noalias() += Vxx_[t] * fs_[t];
+  }
+}
+
+bool SolverDDP::computeRiccatiGains(const std::size_t t, const std::size_t k) {
+  const std::shared_ptr<ActionDataAbstract>& d =
+      problem_->get_runningDatas()[t];
+  const std::size_t nu = problem_->get_runningModels()[t]->get_nu();
+  const Eigen::MatrixXd& Vxx_p = Vxx_[t + 1];
+  const Eigen::VectorXd& Vx_p = Vx_[t + 1];
+  MatrixXdRowMajor& FxTVxx_p = bp_FxTVxx_[k];
+
+  FxTVxx_p.noalias() = d->Fx.transpose() * Vxx_p;
+  Qx_[t] = d->Lx;
+  Qx_[t].noalias() += d->Fx.transpose() * Vx_p;
+  Qxx_[t] = d->Lxx;
+  Qxx_[t].noalias() += FxTVxx_p * d->Fx;
+  if (nu != 0) {
+    FuTVxx_p_[t].noalias() = d->Fu.transpose() * Vxx_p;
+    Qu_[t] = d->Lu;
+    Qu_[t].noalias() += d->Fu.transpose() * Vx_p;
+    Quu_[t] = d->Luu;
+    Quu_[t].noalias() += FuTVxx_p_[t] * d->Fu;
+    Qxu_[t] = d->Lxu;
+    Qxu_[t].noalias() += FxTVxx_p * d->Fu;
+    if (!std::isnan(preg_)) {
+      Quu_[t].diagonal().array() += preg_;
+    }
+    Quu_llt_[t].compute(Quu_[t]);
+    if (Quu_llt_[t].info() != Eigen::Success) {
+      return false;
+    }
+    K_[t] = Qxu_[t].transpose();
+    Quu_llt_[t].solveInPlace(K_[t]);
+    k_[t] = Qu_[t];
+    Quu_llt_[t].solveInPlace(k_[t]);
+    Quuk_[t].noalias() = Quu_[t] * k_[t];
+  }
+  return true;
+}
+
+double SolverDDP::tryLineSearchStep(const std::size_t i) {
+  if (ls_nthreads_ == 1) {
+    ls_recalc_ = false;
+    return tryStep(alphas_[i]);
+  }
+  const std::size_t j = i % ls_nthreads_;
+  if (j == 0) {
+    // Rollout the next batch of step lengths. The first workspace uses the
+    // solver and problem data, so we don't need to recompute the problem data
+    // when the largest step length of the batch is accepted.
+    START_PROFILER("SolverDDP::tryLineSearchStep");
+    const std::size_t n = std::min(ls_nthreads_, alphas_.size() - i);
+    const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
+        problem_->get_runningDatas();
+    const std::shared_ptr<ActionDataAbstract>& data_T =
+        problem_->get_terminalData();
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(n)
+#endif
+    for (std::size_t k = 0; k < n; ++k) {
+      try {
+        if (k == 0) {
+          ls_cost_try_[k] =
+              computeRollout(alphas_[i], xs_try_, us_try_, dx_, datas, data_T);
+        } else {
+          std::vector<std::shared_ptr<ActionDataAbstract> >& ls_datas =
+              ls_datas_[k];
+          ls_cost_try_[k] = computeRollout(
+              alphas_[i + k], ls_xs_try_[k], ls_us_try_[k], ls_dx_[k],
+              ls_datas, ls_datas.back());
+        }
+      } catch (std::exception& e) {
+        ls_cost_try_[k] = NAN;
+      }
+    }
+    STOP_PROFILER("SolverDDP::tryLineSearchStep");
+  } else {
+    // Retrieve the trial trajectory of the j-th workspace. Swapping keeps all
+    // the workspaces allocated and distinct.
+    xs_try_.swap(ls_xs_try_[j]);
+    us_try_.swap(ls_us_try_[j]);
+    dx_.swap(ls_dx_[j]);
+  }
+  ls_recalc_ = j != 0;
+  if (raiseIfNaN(ls_cost_try_[j])) {
+    throw_pretty("forward_error");
+  }
+  cost_try_ = ls_cost_try_[j];
+  return cost_ - cost_try_;
+}
+
+void SolverDDP::acceptLineSearchStep() {
+  if (ls_recalc_) {
+    problem_->calc(xs_, us_);
+    ls_recalc_ = false;
+  }
+}
+
 void SolverDDP::increaseRegularization() {
   preg_ *= reg_incfactor_;
   if (preg_ > reg_max_) {
@@ -470,6 +975,69 @@ void SolverDDP::allocateData() {
 
   FxTVxx_p_ = MatrixXdRowMajor::Zero(ndx, ndx);
   fTVxx_p_ = Eigen::VectorXd::Zero(ndx);
+  resizeLineSearchData();
+  resizeBackwardPassData();
+  updateFixedSizeBackwardPassStep();
+}
+
+void SolverDDP::resizeLineSearchData() {
+  ls_xs_try_.resize(ls_nthreads_);
+  ls_us_try_.resize(ls_nthreads_);
+  ls_dx_.resize(ls_nthreads_);
+  ls_datas_.resize(ls_nthreads_);
+  ls_cost_try_.resize(ls_nthreads_, 0.);
+  if (ls_nthreads_ == 1) {
+    return;
+  }
+  // The first workspace uses the solver and problem data
+  const std::size_t T = problem_->get_T();
+  const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
+      problem_->get_runningModels();
+  ls_models_.resize(T + 1);
+  for (std::size_t k = 1; k < ls_nthreads_; ++k) {
+    ls_xs_try_[k] = xs_try_;
+    ls_us_try_[k] = us_try_;
+    ls_dx_[k] = dx_;
+    ls_datas_[k].resize(T + 1);
+  }
+  for (std::size_t t = 0; t < T + 1; ++t) {
+    const std::shared_ptr<ActionModelAbstract>& model =
+        t < T ? models[t] : problem_->get_terminalModel();
+    const bool is_updated = ls_models_[t] != model;
+    for (std::size_t k = 1; k < ls_nthreads_; ++k) {
+      if (is_updated || !ls_datas_[k][t]) {
+        ls_datas_[k][t] = model->createData();
+      }
+    }
+    ls_models_[t] = model;
+  }
+}
+
+void SolverDDP::resizeBackwardPassData() {
+  // The Riccati elements are only needed by the parallel backward pass
+  const std::size_t T = bp_nthreads_ > 1 ? problem_->get_T() : 0;
+  const std::size_t nthreads = bp_nthreads_ > 1 ? bp_nthreads_ : 0;
+  const std::size_t ndx = problem_->get_ndx();
+  bp_chunks_.reserve(T);
+  bp_A_.resize(T);
+  bp_b_.resize(T);
+  bp_C_.resize(T);
+  bp_eta_.resize(T);
+  bp_J_.resize(T);
+  for (std::size_t t = 0; t < T; ++t) {
+    bp_A_[t].resize(ndx, ndx);
+    bp_b_[t].resize(ndx);
+    bp_C_[t].resize(ndx, ndx);
+    bp_eta_[t].resize(ndx);
+    bp_J_[t].resize(ndx, ndx);
+  }
+  bp_lu_.resize(nthreads, Eigen::PartialPivLU<Eigen::MatrixXd>(ndx));
+  bp_MA_.resize(nthreads, Eigen::MatrixXd::Zero(ndx, ndx));
+  bp_MC_.resize(nthreads, Eigen::MatrixXd::Zero(ndx, ndx));
+  bp_tmp_.resize(nthreads, Eigen::MatrixXd::Zero(ndx, ndx));
+  bp_FxTVxx_.resize(nthreads, MatrixXdRowMajor::Zero(ndx, ndx));
+  bp_v_.resize(nthreads, Eigen::VectorXd::Zero(ndx));
+  bp_w_.resize(nthreads, Eigen::VectorXd::Zero(ndx));
 }
 
 double SolverDDP::get_reg_incfactor() const { return reg_incfactor_; }
@@ -488,6 +1056,12 @@ double SolverDDP::get_regmax() const { return reg_max_; }
 
 const std::vector<double>& SolverDDP::get_alphas() const { return alphas_; }
 
+std::size_t SolverDDP::get_ls_nthreads() const { return ls_nthreads_; }
+
+std::size_t SolverDDP::get_bp_nthreads() const { return bp_nthreads_; }
+
+bool SolverDDP::get_bp_fixed_size() const { return bp_fixed_size_; }
+
 double SolverDDP::get_th_stepdec() const { return th_stepdec_; }
 
 double SolverDDP::get_th_stepinc() const { return th_stepinc_; }
@@ -586,6 +1160,27 @@ void SolverDDP::set_alphas(const std::vector<double>& alphas) {
   alphas_ = alphas;
 }
 
+void SolverDDP::set_ls_nthreads(const int nthreads) {
+  ls_nthreads_ = getNumberOfThreads(nthreads, "the line search");
+  if (ls_nthreads_ > 1 && !isLineSearchParallelizable()) {
+    std::cerr << "Warning: the line search won't run in parallel as this "
+                 "solver does not support it."
+              << std::endl;
+    ls_nthreads_ = 1;
+  }
+  resizeLineSearchData();
+}
+
+void SolverDDP::set_bp_nthreads(const int nthreads) {
+  bp_nthreads_ = getNumberOfThreads(nthreads, "the backward pass");
+  resizeBackwardPassData();
+}
+
+void SolverDDP::set_bp_fixed_size(const bool fixed_size) {
+  bp_fixed_size_ = fixed_size;
+  updateFixedSizeBackwardPassStep();
+}
+
 void SolverDDP::set_th_stepdec(const double th_stepdec) {
   if (0. >= th_stepdec || th_stepdec > 1.) {
     throw_pretty(
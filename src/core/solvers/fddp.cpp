@@ -13,6 +13,7 @@
 
 #include "crocoddyl/core/solvers/fddp.hpp"
 #include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/malloc-guard.hpp"
 
 namespace crocoddyl {
 
@@ -42,6 +43,8 @@ bool SolverFDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
   }
   was_feasible_ = false;
 
+  // The iterations should not allocate memory
+  MallocGuard guard;
   bool recalcDiff = true;
   for (iter_ = 0; iter_ < maxiter; ++iter_) {
     while (true) {
@@ -62,12 +65,12 @@ bool SolverFDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
 
     // We need to recalculate the derivatives when the step length passes
     recalcDiff = false;
-    for (std::vector<double>::const_iterator it = alphas_.begin();
-         it != alphas_.end(); ++it) {
-      steplength_ = *it;
+    const std::size_t n_alphas = alphas_.size();
+    for (std::size_t i = 0; i < n_alphas; ++i) {
+      steplength_ = alphas_[i];
 
       try {
-        dV_ = tryStep(steplength_);
+        dV_ = tryLineSearchStep(i);
       } catch (std::exception& e) {
         continue;
       }
@@ -79,6 +82,7 @@ bool SolverFDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
           was_feasible_ = is_feasible_;
           setCandidate(xs_try_, us_try_, (was_feasible_) || (steplength_ == 1));
           cost_ = cost_try_;
+          acceptLineSearchStep();
           recalcDiff = true;
           break;
         }
@@ -88,6 +92,7 @@ bool SolverFDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
           was_feasible_ = is_feasible_;
           setCandidate(xs_try_, us_try_, (was_feasible_) || (steplength_ == 1));
           cost_ = cost_try_;
+          acceptLineSearchStep();
           recalcDiff = true;
           break;
         }
@@ -108,6 +113,7 @@ bool SolverFDDP::solve(const std::vector<Eigen::VectorXd>& init_xs,
 
     const std::size_t n_callbacks = callbacks_.size();
     for (std::size_t c = 0; c < n_callbacks; ++c) {
+      MallocGuard allow(true);
       CallbackAbstract& callback = *callbacks_[c];
       callback(*this);
     }
@@ -173,55 +179,50 @@ void SolverFDDP::updateExpectedImprovement() {
   }
 }
 
-void SolverFDDP::forwardPass(const double steplength) {
+double SolverFDDP::computeRollout(
+    const double steplength, std::vector<Eigen::VectorXd>& xs_try,
+    std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx,
+    const std::vector<std::shared_ptr<ActionDataAbstract> >& datas,
+    const std::shared_ptr<ActionDataAbstract>& data_T) {
   if (steplength > 1. || steplength < 0.) {
     throw_pretty("Invalid argument: "
                  << "invalid step length, value is between 0. to 1.");
   }
-  START_PROFILER("SolverFDDP::forwardPass");
-  cost_try_ = 0.;
-  xnext_ = problem_->get_x0();
+  double cost_try = 0.;
   const std::size_t T = problem_->get_T();
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
-  const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
-      problem_->get_runningDatas();
   if ((is_feasible_) || (steplength == 1)) {
     for (std::size_t t = 0; t < T; ++t) {
       const std::shared_ptr<ActionModelAbstract>& m = models[t];
       const std::shared_ptr<ActionDataAbstract>& d = datas[t];
       const std::size_t nu = m->get_nu();
 
-      xs_try_[t] = xnext_;
-      m->get_state()->diff(xs_[t], xs_try_[t], dx_[t]);
+      xs_try[t] = t == 0 ? problem_->get_x0() : datas[t - 1]->xnext;
+      m->get_state()->diff(xs_[t], xs_try[t], dx[t]);
       if (nu != 0) {
-        us_try_[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx_[t];
-        m->calc(d, xs_try_[t], us_try_[t]);
+        us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
+        m->calc(d, xs_try[t], us_try[t]);
       } else {
-        m->calc(d, xs_try_[t]);
+        m->calc(d, xs_try[t]);
       }
-      xnext_ = d->xnext;
-      cost_try_ += d->cost;
+      cost_try += d->cost;
 
-      if (raiseIfNaN(cost_try_)) {
-        STOP_PROFILER("SolverFDDP::forwardPass");
+      if (raiseIfNaN(cost_try)) {
         throw_pretty("forward_error");
       }
-      if (raiseIfNaN(xnext_.lpNorm<Eigen::Infinity>())) {
-        STOP_PROFILER("SolverFDDP::forwardPass");
+      if (raiseIfNaN(d->xnext.lpNorm<Eigen::Infinity>())) {
         throw_pretty("forward_error");
       }
     }
 
     const std::shared_ptr<ActionModelAbstract>& m =
         problem_->get_terminalModel();
-    const std::shared_ptr<ActionDataAbstract>& d = problem_->get_terminalData();
-    xs_try_.back() = xnext_;
-    m->calc(d, xs_try_.back());
-    cost_try_ += d->cost;
+    xs_try.back() = T == 0 ? problem_->get_x0() : datas[T - 1]->xnext;
+    m->calc(data_T, xs_try.back());
+    cost_try += data_T->cost;
 
-    if (raiseIfNaN(cost_try_)) {
-      STOP_PROFILER("SolverFDDP::forwardPass");
+    if (raiseIfNaN(cost_try)) {
       throw_pretty("forward_error");
     }
   } else {
@@ -229,41 +230,43 @@ void SolverFDDP::forwardPass(const double steplength) {
       const std::shared_ptr<ActionModelAbstract>& m = models[t];
       const std::shared_ptr<ActionDataAbstract>& d = datas[t];
       const std::size_t nu = m->get_nu();
-      m->get_state()->integrate(xnext_, fs_[t] * (steplength - 1), xs_try_[t]);
-      m->get_state()->diff(xs_[t], xs_try_[t], dx_[t]);
+      const Eigen::VectorXd& xnext =
+          t == 0 ? problem_->get_x0() : datas[t - 1]->xnext;
+      dx[t] = fs_[t] * (steplength - 1);
+      m->get_state()->integrate(xnext, dx[t], xs_try[t]);
+      m->get_state()->diff(xs_[t], xs_try[t], dx[t]);
       if (nu != 0) {
-        us_try_[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx_[t];
-        m->calc(d, xs_try_[t], us_try_[t]);
+        us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
+        m->calc(d, xs_try[t], us_try[t]);
       } else {
-        m->calc(d, xs_try_[t]);
+        m->calc(d, xs_try[t]);
       }
-      xnext_ = d->xnext;
-      cost_try_ += d->cost;
+      cost_try += d->cost;
 
-      if (raiseIfNaN(cost_try_)) {
-        STOP_PROFILER("SolverFDDP::forwardPass");
+      if (raiseIfNaN(cost_try)) {
         throw_pretty("forward_error");
       }
-      if (raiseIfNaN(xnext_.lpNorm<Eigen::Infinity>())) {
-        STOP_PROFILER("SolverFDDP::forwardPass");
+      if (raiseIfNaN(d->xnext.lpNorm<Eigen::Infinity>())) {
         throw_pretty("forward_error");
       }
     }
 
     const std::shared_ptr<ActionModelAbstract>& m =
         problem_->get_terminalModel();
-    const std::shared_ptr<ActionDataAbstract>& d = problem_->get_terminalData();
-    m->get_state()->integrate(xnext_, fs_.back() * (steplength - 1),
-                              xs_try_.back());
-    m->calc(d, xs_try_.back());
-    cost_try_ += d->cost;
+    const Eigen::VectorXd& xnext =
+        T == 0 ? problem_->get_x0() : datas[T - 1]->xnext;
+    // We re-use the final element of dx for storing the scaled gap of the
+    // terminal node, which avoids allocating a temporary vector
+    dx.back() = fs_.back() * (steplength - 1);
+    m->get_state()->integrate(xnext, dx.back(), xs_try.back());
+    m->calc(data_T, xs_try.back());
+    cost_try += data_T->cost;
 
-    if (raiseIfNaN(cost_try_)) {
-      STOP_PROFILER("SolverFDDP::forwardPass");
+    if (raiseIfNaN(cost_try)) {
       throw_pretty("forward_error");
     }
   }
-  STOP_PROFILER("SolverFDDP::forwardPass");
+  return cost_try;
 }
 
 double SolverFDDP::get_th_acceptnegstep() const { return th_acceptnegstep_; }
@@ -8,13 +8,70 @@
 
 #include "crocoddyl/core/solvers/intro.hpp"
 
+#include <cmath>
 #include <iostream>
 
 #include "crocoddyl/core/utils/exception.hpp"
+#include "crocoddyl/core/utils/malloc-guard.hpp"
 #include "crocoddyl/core/utils/stop-watch.hpp"
 
 namespace crocoddyl {
 
+/**
+ * Compute the kernel of a matrix from its full-pivot LU decomposition. It
+ * follows the implementation of `Eigen::FullPivLU::kernel()`, but it uses the
+ * buffers preallocated by the solver to avoid allocating memory.
+ */
+static void computeKernel(const Eigen::FullPivLU<Eigen::MatrixXd>& lu,
+                          Eigen::MatrixXd& tmp, Eigen::VectorXi& pivots,
+                          Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic,
+                                       Eigen::Dynamic, true>
+                              ker) {
+  const Eigen::Index rank = lu.rank();
+  const Eigen::Index cols = lu.matrixLU().cols();
+  const Eigen::Index nullity = cols - rank;
+  if (nullity == 0) {
+    return;
+  }
+
+  // Bring the nonnegligible pivots of U to the top of its diagonal
+  const double threshold = lu.maxPivot() * lu.threshold();
+  Eigen::Index p = 0;
+  for (Eigen::Index i = 0; i < lu.nonzeroPivots(); ++i) {
+    if (std::abs(lu.matrixLU().coeff(i, i)) > threshold) {
+      pivots.coeffRef(p++) = static_cast<int>(i);
+    }
+  }
+  Eigen::Block<Eigen::MatrixXd> m = tmp.topRows(rank);
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    m.row(i).head(i).setZero();
+    m.row(i).tail(cols - i) =
+        lu.matrixLU().row(pivots.coeff(i)).tail(cols - i);
+  }
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    m.col(i).swap(m.col(pivots.coeff(i)));
+  }
+
+  // Solve the triangular system and undo the column permutation
+  m.topLeftCorner(rank, rank).triangularView<Eigen::Upper>().solveInPlace(
+      m.topRightCorner(rank, nullity));
+  for (Eigen::Index i = rank - 1; i >= 0; --i) {
+    m.col(i).swap(m.col(pivots.coeff(i)));
+  }
+
+  // Ker(A) = Q Ker(U)
+  const Eigen::VectorXi& q = lu.permutationQ().indices();
+  for (Eigen::Index i = 0; i < rank; ++i) {
+    ker.row(q.coeff(i)) = -m.row(i).tail(nullity);
+  }
+  for (Eigen::Index i = rank; i < cols; ++i) {
+    ker.row(q.coeff(i)).setZero();
+  }
+  for (Eigen::Index k = 0; k < nullity; ++k) {
+    ker.coeffRef(q.coeff(rank + k), k) = 1.;
+  }
+}
+
 SolverIntro::SolverIntro(std::shared_ptr<ShootingProblem> problem)
     : SolverFDDP(problem),
       eq_solver_(LuNull),
@@ -40,6 +97,9 @@ SolverIntro::SolverIntro(std::shared_ptr<ShootingProblem> problem)
   Hu_lu_.resize(T);
   Hu_qr_.resize(T);
   Hy_lu_.resize(T);
+  Hu_ker_tmp_.resize(T);
+  Hu_pivots_.resize(T);
+  Hu_qr_ws_.resize(T);
 
   const std::size_t ndx = problem_->get_ndx();
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
@@ -65,6 +125,9 @@ SolverIntro::SolverIntro(std::shared_ptr<ShootingProblem> problem)
     Hu_lu_[t] = Eigen::FullPivLU<Eigen::MatrixXd>(nh, nu);
     Hu_qr_[t] = Eigen::ColPivHouseholderQR<Eigen::MatrixXd>(nu, nh);
     Hy_lu_[t] = Eigen::PartialPivLU<Eigen::MatrixXd>(nh);
+    Hu_ker_tmp_[t] = Eigen::MatrixXd::Zero(nh, nu);
+    Hu_pivots_[t] = Eigen::VectorXi::Zero(nh);
+    Hu_qr_ws_[t] = Eigen::VectorXd::Zero(nu);
   }
 }
 
@@ -94,6 +157,8 @@ bool SolverIntro::solve(const std::vector<Eigen::VectorXd>& init_xs,
     upsilon_ = 0.;
   }
 
+  // The iterations should not allocate memory
+  MallocGuard guard;
   bool recalcDiff = true;
   for (iter_ = 0; iter_ < maxiter; ++iter_) {
     while (true) {
@@ -163,6 +228,7 @@ bool SolverIntro::solve(const std::vector<Eigen::VectorXd>& init_xs,
     stoppingCriteria();
     const std::size_t n_callbacks = callbacks_.size();
     for (std::size_t c = 0; c < n_callbacks; ++c) {
+      MallocGuard allow(true);
       CallbackAbstract& callback = *callbacks_[c];
       callback(*this);
     }
@@ -222,6 +288,9 @@ void SolverIntro::resizeData() {
     ks_[t].conservativeResize(nh);
     Ks_[t].conservativeResize(nh, ndx);
     QuuinvHuT_[t].conservativeResize(nu, nh);
+    Hu_ker_tmp_[t].conservativeResize(nh, nu);
+    Hu_pivots_[t].conservativeResize(nh);
+    Hu_qr_ws_[t].conservativeResize(nu);
   }
   STOP_PROFILER("SolverIntro::resizeData");
 }
@@ -236,56 +305,49 @@ double SolverIntro::calcDiff() {
       problem_->get_runningDatas();
   switch (eq_solver_) {
     case LuNull:
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(problem_->get_nthreads())
-#endif
-      for (std::size_t t = 0; t < T; ++t) {
+      problem_->parallelFor(T, [&](const std::size_t t) {
         const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
             models[t];
         const std::shared_ptr<crocoddyl::ActionDataAbstract>& data = datas[t];
         if (model->get_nu() > 0 && model->get_nh() > 0) {
           Hu_lu_[t].compute(data->Hu);
-          YZ_[t] << Hu_lu_[t].matrixLU().transpose(), Hu_lu_[t].kernel();
           Hu_rank_[t] = Hu_lu_[t].rank();
+          YZ_[t].leftCols(model->get_nh()) =
+              Hu_lu_[t].matrixLU().transpose();
+          computeKernel(Hu_lu_[t], Hu_ker_tmp_[t], Hu_pivots_[t],
+                        YZ_[t].rightCols(model->get_nu() - Hu_rank_[t]));
           const Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic, Eigen::Dynamic,
                              Eigen::RowMajor>
               Y = YZ_[t].leftCols(Hu_lu_[t].rank());
           Hy_[t].noalias() = data->Hu * Y;
           Hy_lu_[t].compute(Hy_[t]);
-          const Eigen::Inverse<Eigen::PartialPivLU<Eigen::MatrixXd> > Hy_inv =
-              Hy_lu_[t].inverse();
-          ks_[t].noalias() = Hy_inv * data->h;
-          Ks_[t].noalias() = Hy_inv * data->Hx;
+          ks_[t].noalias() = Hy_lu_[t].solve(data->h);
+          Ks_[t].noalias() = Hy_lu_[t].solve(data->Hx);
           kz_[t].noalias() = Y * ks_[t];
           Kz_[t].noalias() = Y * Ks_[t];
         }
-      }
+      });
       break;
     case QrNull:
-#ifdef CROCODDYL_WITH_MULTITHREADING
-#pragma omp parallel for num_threads(problem_->get_nthreads())
-#endif
-      for (std::size_t t = 0; t < T; ++t) {
+      problem_->parallelFor(T, [&](const std::size_t t) {
         const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
             models[t];
         const std::shared_ptr<crocoddyl::ActionDataAbstract>& data = datas[t];
         if (model->get_nu() > 0 && model->get_nh() > 0) {
           Hu_qr_[t].compute(data->Hu.transpose());
-          YZ_[t] = Hu_qr_[t].householderQ();
+          Hu_qr_[t].householderQ().evalTo(YZ_[t], Hu_qr_ws_[t]);
           Hu_rank_[t] = Hu_qr_[t].rank();
           const Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic, Eigen::Dynamic,
                              Eigen::RowMajor>
               Y = YZ_[t].leftCols(Hu_qr_[t].rank());
           Hy_[t].noalias() = data->Hu * Y;
           Hy_lu_[t].compute(Hy_[t]);
-          const Eigen::Inverse<Eigen::PartialPivLU<Eigen::MatrixXd> > Hy_inv =
-              Hy_lu_[t].inverse();
-          ks_[t].noalias() = Hy_inv * data->h;
-          Ks_[t].noalias() = Hy_inv * data->Hx;
+          ks_[t].noalias() = Hy_lu_[t].solve(data->h);
+          Ks_[t].noalias() = Hy_lu_[t].solve(data->Hx);
           kz_[t].noalias() = Y * ks_[t];
           Kz_[t].noalias() = Y * Ks_[t];
         }
-      }
+      });
       break;
     case Schur:
       break;
@@ -346,6 +408,7 @@ void SolverIntro::computeGains(const std::size_t t) {
         const Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic, Eigen::Dynamic,
                            Eigen::RowMajor>
             Z = YZ_[t].rightCols(nullity);
+        resizeReducedHamiltonian(t, nullity);
         Quz_[t].noalias() = Quu_[t] * Z;
         Qzz_[t].noalias() = Z.transpose() * Quz_[t];
         Qzz_llt_[t].compute(Qzz_[t]);
@@ -376,6 +439,7 @@ void SolverIntro::computeGains(const std::size_t t) {
       SolverFDDP::computeGains(t);
       if (nu > 0 && nh > 0) {
         START_PROFILER("SolverIntro::Qzz_inv");
+        resizeReducedHamiltonian(t, nh);
         QuuinvHuT_[t] = data->Hu.transpose();
         Quu_llt_[t].solveInPlace(QuuinvHuT_[t]);
         Qzz_[t].noalias() = data->Hu * QuuinvHuT_[t];
@@ -392,13 +456,40 @@ void SolverIntro::computeGains(const std::size_t t) {
         Ks_[t] = data->Hx;
         Ks_[t].noalias() -= data->Hu * K_[t];
         k_[t].noalias() += QuuinvHuT_[t] * ks_[t];
-        K_[t] += QuuinvHuT_[t] * Ks_[t];
+        K_[t].noalias() += QuuinvHuT_[t] * Ks_[t];
       }
       break;
   }
   STOP_PROFILER("SolverIntro::computeGains");
 }
 
+void SolverIntro::resizeReducedHamiltonian(const std::size_t t,
+                                           const std::size_t nz) {
+  if (static_cast<std::size_t>(Qzz_[t].rows()) == nz) {
+    return;
+  }
+  // The rank of Hu or the equality solver has changed
+  MallocGuard allow(true);
+  const std::size_t ndx = problem_->get_ndx();
+  const std::size_t nu = problem_->get_runningModels()[t]->get_nu();
+  Qz_[t].resize(nz);
+  Qzz_[t].resize(nz, nz);
+  Qxz_[t].resize(ndx, nz);
+  Quz_[t].resize(nu, nz);
+  Qzz_llt_[t] = Eigen::LLT<Eigen::MatrixXd>(nz);
+}
+
+bool SolverIntro::isRiccatiStepParallelizable(const std::size_t t) const {
+  // The nullspace and Schur-complement steps are only used in nodes with
+  // equality constraints
+  return problem_->get_runningModels()[t]->get_nh() == 0;
+}
+
+bool SolverIntro::isLineSearchParallelizable() const {
+  // The line search evaluates the merit function in tryStep
+  return false;
+}
+
 EqualitySolverType SolverIntro::get_equality_solver() const {
   return eq_solver_;
 }
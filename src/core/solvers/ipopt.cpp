@@ -80,4 +80,23 @@ void SolverIpopt::set_th_stop(const double th_stop) {
   ipopt_app_->Options()->SetNumericValue("tol", th_stop_);
 }
 
+bool SolverIpopt::get_sparsity_detection() const {
+  return ipopt_iface_->get_sparsity_detection();
+}
+
+void SolverIpopt::set_sparsity_detection(const bool sparsity_detection) {
+  ipopt_iface_->set_sparsity_detection(sparsity_detection);
+}
+
+IpoptHessianType SolverIpopt::get_hessian_type() const {
+  return ipopt_iface_->get_hessian_type();
+}
+
+void SolverIpopt::set_hessian_type(const IpoptHessianType hessian_type) {
+  ipopt_iface_->set_hessian_type(hessian_type);
+  ipopt_app_->Options()->SetStringValue(
+      "hessian_approximation",
+      hessian_type == LimitedMemoryHessian ? "limited-memory" : "exact");
+}
+
 }  // namespace crocoddyl
@@ -16,8 +16,33 @@
 
 namespace crocoddyl {
 
+#ifndef NDEBUG
+namespace {
+
+// Return true if the matrix has nonzeros outside the mask (only in its lower
+// triangular part if lower is true)
+bool hasNonzerosOutside(const Eigen::MatrixXd& M,
+                        const IpoptInterfaceData::MatrixXb& mask,
+                        const bool lower) {
+  for (Eigen::DenseIndex j = 0; j < M.cols(); ++j) {
+    for (Eigen::DenseIndex i = lower ? j : 0; i < M.rows(); ++i) {
+      if (M(i, j) != 0. && !mask(i, j)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+#endif
+
 IpoptInterface::IpoptInterface(const std::shared_ptr<ShootingProblem>& problem)
-    : problem_(problem) {
+    : problem_(problem),
+      sparsity_detection_(false),
+      sparsity_detected_(false),
+      hessian_type_(FullHessian),
+      diff_computed_(false) {
   const std::size_t T = problem_->get_T();
   xs_.resize(T + 1);
   us_.resize(T);
@@ -83,6 +108,8 @@ void IpoptInterface::resizeData() {
   nvar_ += ndxi;  // final node
   xs_[T].conservativeResize(nxi);
   datas_[T]->resize(nxi, ndxi, 0);
+  sparsity_detected_ = false;
+  diff_computed_ = false;
 }
 
 IpoptInterface::~IpoptInterface() {}
@@ -91,42 +118,31 @@ bool IpoptInterface::get_nlp_info(Ipopt::Index& n, Ipopt::Index& m,
                                   Ipopt::Index& nnz_jac_g,
                                   Ipopt::Index& nnz_h_lag,
                                   IndexStyleEnum& index_style) {
+  if (sparsity_detection_ && !sparsity_detected_) {
+    detectSparsity();
+  }
   n = static_cast<Ipopt::Index>(nvar_);    // number of variables
   m = static_cast<Ipopt::Index>(nconst_);  // number of constraints
 
-  nnz_jac_g = 0;  // Jacobian nonzeros for dynamic constraints
-  nnz_h_lag = 0;  // Hessian nonzeros (only lower triangular part)
-  const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
-      problem_->get_runningModels();
+  // The nonzeros are defined by the sparsity pattern of each node, which is
+  // dense unless it has been detected
+  std::size_t nnz_jac = 0;  // Jacobian nonzeros for dynamic constraints
+  std::size_t nnz_h = 0;    // Hessian nonzeros (only lower triangular part)
   const std::size_t T = problem_->get_T();
   for (std::size_t t = 0; t < T; ++t) {
-    const std::size_t ndxi = models[t]->get_state()->get_ndx();
-    const std::size_t ndxi_next =
-        t + 1 == T ? problem_->get_terminalModel()->get_state()->get_ndx()
-                   : models[t + 1]->get_state()->get_ndx();
-    const std::size_t nui = models[t]->get_nu();
-    nnz_jac_g += ndxi * (ndxi + ndxi_next + nui);
-
-    // Hessian
-    std::size_t nonzero = 0;
-    for (std::size_t i = 1; i <= (ndxi + nui); ++i) {
-      nonzero += i;
-    }
-    nnz_h_lag += nonzero;
+    const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+    nnz_jac += d->Jg_dx_mask.count() + d->Jg_u_mask.count() +
+               d->Jg_dxnext_mask.count();
+    nnz_h += d->Ldxdx_mask.count() + d->Ldxu_mask.count() + d->Luu_mask.count();
   }
 
   // Initial condition
-  nnz_jac_g +=
-      models[0]->get_state()->get_ndx() * models[0]->get_state()->get_ndx();
+  nnz_jac += datas_[0]->Jg_ic_mask.count();
 
   // Hessian nonzero for the terminal cost
-  const std::size_t ndxi =
-      problem_->get_terminalModel()->get_state()->get_ndx();
-  std::size_t nonzero = 0;
-  for (std::size_t i = 1; i <= ndxi; ++i) {
-    nonzero += i;
-  }
-  nnz_h_lag += nonzero;
+  nnz_h += datas_[T]->Ldxdx_mask.count();
+  nnz_jac_g = static_cast<Ipopt::Index>(nnz_jac);
+  nnz_h_lag = static_cast<Ipopt::Index>(nnz_h);
 
   // use the C style indexing (0-based)
   index_style = Ipopt::TNLP::C_STYLE;
@@ -237,13 +253,16 @@ bool IpoptInterface::get_starting_point(Ipopt::Index, bool /*init_x*/,
 
 #ifndef NDEBUG
 bool IpoptInterface::eval_f(Ipopt::Index n, const Ipopt::Number* x,
-                            bool /*new_x*/, Ipopt::Number& obj_value) {
+                            bool new_x, Ipopt::Number& obj_value) {
 #else
-bool IpoptInterface::eval_f(Ipopt::Index, const Ipopt::Number* x, bool,
+bool IpoptInterface::eval_f(Ipopt::Index, const Ipopt::Number* x, bool new_x,
                             Ipopt::Number& obj_value) {
 #endif
   assert_pretty(n == static_cast<Ipopt::Index>(nvar_),
                 "Inconsistent number of decision variables");
+  if (new_x) {
+    diff_computed_ = false;
+  }
 
   // Running costs
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
@@ -291,13 +310,16 @@ bool IpoptInterface::eval_f(Ipopt::Index, const Ipopt::Number* x, bool,
 
 #ifndef NDEBUG
 bool IpoptInterface::eval_grad_f(Ipopt::Index n, const Ipopt::Number* x,
-                                 bool /*new_x*/, Ipopt::Number* grad_f) {
+                                 bool new_x, Ipopt::Number* grad_f) {
 #else
-bool IpoptInterface::eval_grad_f(Ipopt::Index, const Ipopt::Number* x, bool,
-                                 Ipopt::Number* grad_f) {
+bool IpoptInterface::eval_grad_f(Ipopt::Index, const Ipopt::Number* x,
+                                 bool new_x, Ipopt::Number* grad_f) {
 #endif
   assert_pretty(n == static_cast<Ipopt::Index>(nvar_),
                 "Inconsistent number of decision variables");
+  if (new_x) {
+    diff_computed_ = false;
+  }
 
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
@@ -318,8 +340,10 @@ bool IpoptInterface::eval_grad_f(Ipopt::Index, const Ipopt::Number* x, bool,
     model->get_state()->integrate(xs_[t], datas_[t]->dx, datas_[t]->x);
     model->get_state()->Jintegrate(xs_[t], datas_[t]->dx, datas_[t]->Jint_dx,
                                    datas_[t]->Jint_dx, second, setto);
-    model->calc(data, datas_[t]->x, datas_[t]->u);
-    model->calcDiff(data, datas_[t]->x, datas_[t]->u);
+    if (!diff_computed_) {
+      model->calc(data, datas_[t]->x, datas_[t]->u);
+      model->calcDiff(data, datas_[t]->x, datas_[t]->u);
+    }
     datas_[t]->Ldx.noalias() = datas_[t]->Jint_dx.transpose() * data->Lx;
   }
   for (std::size_t t = 0; t < T; ++t) {
@@ -346,27 +370,33 @@ bool IpoptInterface::eval_grad_f(Ipopt::Index, const Ipopt::Number* x, bool,
   model->get_state()->integrate(xs_[T], datas_[T]->dx, datas_[T]->x);
   model->get_state()->Jintegrate(xs_[T], datas_[T]->dx, datas_[T]->Jint_dx,
                                  datas_[T]->Jint_dx, second, setto);
-  model->calc(data, datas_[T]->x);
-  model->calcDiff(data, datas_[T]->x);
+  if (!diff_computed_) {
+    model->calc(data, datas_[T]->x);
+    model->calcDiff(data, datas_[T]->x);
+  }
   datas_[T]->Ldx.noalias() = datas_[T]->Jint_dx.transpose() * data->Lx;
   for (std::size_t j = 0; j < ndxi; ++j) {
     grad_f[ixu_.back() + j] = datas_[T]->Ldx(j);
   }
+  diff_computed_ = true;
 
   return true;
 }
 
 #ifndef NDEBUG
 bool IpoptInterface::eval_g(Ipopt::Index n, const Ipopt::Number* x,
-                            bool /*new_x*/, Ipopt::Index m, Ipopt::Number* g) {
+                            bool new_x, Ipopt::Index m, Ipopt::Number* g) {
 #else
-bool IpoptInterface::eval_g(Ipopt::Index, const Ipopt::Number* x,
-                            bool /*new_x*/, Ipopt::Index, Ipopt::Number* g) {
+bool IpoptInterface::eval_g(Ipopt::Index, const Ipopt::Number* x, bool new_x,
+                            Ipopt::Index, Ipopt::Number* g) {
 #endif
   assert_pretty(n == static_cast<Ipopt::Index>(nvar_),
                 "Inconsistent number of decision variables");
   assert_pretty(m == static_cast<Ipopt::Index>(nconst_),
                 "Inconsistent number of constraints");
+  if (new_x) {
+    diff_computed_ = false;
+  }
 
   // Dynamic constraints
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
@@ -423,18 +453,22 @@ bool IpoptInterface::eval_g(Ipopt::Index, const Ipopt::Number* x,
 
 #ifndef NDEBUG
 bool IpoptInterface::eval_jac_g(Ipopt::Index n, const Ipopt::Number* x,
-                                bool /*new_x*/, Ipopt::Index m,
+                                bool new_x, Ipopt::Index m,
                                 Ipopt::Index nele_jac, Ipopt::Index* iRow,
                                 Ipopt::Index* jCol, Ipopt::Number* values) {
 #else
-bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
-                                Ipopt::Index, Ipopt::Index, Ipopt::Index* iRow,
-                                Ipopt::Index* jCol, Ipopt::Number* values) {
+bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x,
+                                bool new_x, Ipopt::Index, Ipopt::Index,
+                                Ipopt::Index* iRow, Ipopt::Index* jCol,
+                                Ipopt::Number* values) {
 #endif
   assert_pretty(n == static_cast<Ipopt::Index>(nvar_),
                 "Inconsistent number of decision variables");
   assert_pretty(m == static_cast<Ipopt::Index>(nconst_),
                 "Inconsistent number of constraints");
+  if (new_x) {
+    diff_computed_ = false;
+  }
 
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
@@ -450,12 +484,29 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
       const std::size_t ndxi_next =
           t + 1 == T ? problem_->get_terminalModel()->get_state()->get_ndx()
                      : models[t + 1]->get_state()->get_ndx();
+      const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
       for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
-        for (std::size_t idx_col = 0; idx_col < (ndxi + nui + ndxi_next);
-             ++idx_col) {
-          iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
-          jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_col);
-          idx++;
+        for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
+          if (d->Jg_dx_mask(idx_row, idx_col)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
+            jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_col);
+            idx++;
+          }
+        }
+        for (std::size_t idx_col = 0; idx_col < nui; ++idx_col) {
+          if (d->Jg_u_mask(idx_row, idx_col)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
+            jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + ndxi + idx_col);
+            idx++;
+          }
+        }
+        for (std::size_t idx_col = 0; idx_col < ndxi_next; ++idx_col) {
+          if (d->Jg_dxnext_mask(idx_row, idx_col)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
+            jCol[idx] =
+                static_cast<Ipopt::Index>(ixu_[t] + ndxi + nui + idx_col);
+            idx++;
+          }
         }
       }
       ix += ndxi;
@@ -465,9 +516,11 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
     const std::size_t ndxi = models[0]->get_state()->get_ndx();
     for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
       for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
-        iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
-        jCol[idx] = static_cast<Ipopt::Index>(idx_col);
-        idx++;
+        if (datas_[0]->Jg_ic_mask(idx_row, idx_col)) {
+          iRow[idx] = static_cast<Ipopt::Index>(ix + idx_row);
+          jCol[idx] = static_cast<Ipopt::Index>(idx_col);
+          idx++;
+        }
       }
     }
 
@@ -498,7 +551,10 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
       model->get_state()->integrate(xs_[t], datas_[t]->dx, datas_[t]->x);
       model_next->get_state()->integrate(xs_[t + 1], datas_[t]->dxnext,
                                          datas_[t]->xnext);
-      model->calcDiff(data, datas_[t]->x, datas_[t]->u);
+      if (!diff_computed_) {
+        model->calc(data, datas_[t]->x, datas_[t]->u);
+        model->calcDiff(data, datas_[t]->x, datas_[t]->u);
+      }
       model_next->get_state()->Jintegrate(
           xs_[t + 1], datas_[t]->dxnext, datas_[t]->Jint_dxnext,
           datas_[t]->Jint_dxnext, second,
@@ -524,23 +580,46 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
       const std::size_t ndxi = model->get_state()->get_ndx();
       const std::size_t nui = model->get_nu();
       const std::size_t ndxi_next = model_next->get_state()->get_ndx();
+      const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
       for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
         for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
-          values[idx] = datas_[t]->Jg_dx(idx_row, idx_col);
-          idx++;
+          if (d->Jg_dx_mask(idx_row, idx_col)) {
+            values[idx] = d->Jg_dx(idx_row, idx_col);
+            idx++;
+          }
         }
         for (std::size_t idx_col = 0; idx_col < nui; ++idx_col) {
-          values[idx] = datas_[t]->Jg_u(idx_row, idx_col);
-          idx++;
+          if (d->Jg_u_mask(idx_row, idx_col)) {
+            values[idx] = d->Jg_u(idx_row, idx_col);
+            idx++;
+          }
         }
-        // This could be more optimized since there are a lot of zeros!
         for (std::size_t idx_col = 0; idx_col < ndxi_next; ++idx_col) {
-          values[idx] = datas_[t]->Jg_dxnext(idx_row, idx_col);
-          idx++;
+          if (d->Jg_dxnext_mask(idx_row, idx_col)) {
+            values[idx] = d->Jg_dxnext(idx_row, idx_col);
+            idx++;
+          }
         }
       }
     }
 
+    // Terminal model, whose derivatives are shared with the other evaluations
+    if (!diff_computed_) {
+      const std::shared_ptr<ActionModelAbstract>& model_T =
+          problem_->get_terminalModel();
+      const std::shared_ptr<ActionDataAbstract>& data_T =
+          problem_->get_terminalData();
+      datas_[T]->dx = Eigen::VectorXd::Map(
+          x + ixu_.back(), model_T->get_state()->get_ndx());
+      model_T->get_state()->integrate(xs_[T], datas_[T]->dx, datas_[T]->x);
+      model_T->get_state()->Jintegrate(xs_[T], datas_[T]->dx,
+                                       datas_[T]->Jint_dx, datas_[T]->Jint_dx,
+                                       second, setto);
+      model_T->calc(data_T, datas_[T]->x);
+      model_T->calcDiff(data_T, datas_[T]->x);
+      diff_computed_ = true;
+    }
+
     // Initial condition
     const std::shared_ptr<ActionModelAbstract>& model = models[0];
     const std::size_t ndxi = model->get_state()->get_ndx();
@@ -554,10 +633,31 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
     datas_[0]->Jg_ic.noalias() = datas_[0]->Jdiff_x * datas_[0]->Jint_dx;
     for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
       for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
-        values[idx] = datas_[0]->Jg_ic(idx_row, idx_col);
-        idx++;
+        if (datas_[0]->Jg_ic_mask(idx_row, idx_col)) {
+          values[idx] = datas_[0]->Jg_ic(idx_row, idx_col);
+          idx++;
+        }
+      }
+    }
+#ifndef NDEBUG
+    // The sparsity detection samples random points, so it might miss nonzeros
+    if (sparsity_detected_) {
+      for (std::size_t t = 0; t < T; ++t) {
+        const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+        assert_pretty(!hasNonzerosOutside(d->Jg_dx, d->Jg_dx_mask, false) &&
+                          !hasNonzerosOutside(d->Jg_u, d->Jg_u_mask, false) &&
+                          !hasNonzerosOutside(d->Jg_dxnext, d->Jg_dxnext_mask,
+                                              false),
+                      "The Jacobian of node " << t
+                                              << " has nonzeros outside its "
+                                                 "detected sparsity pattern");
       }
+      assert_pretty(
+          !hasNonzerosOutside(datas_[0]->Jg_ic, datas_[0]->Jg_ic_mask, false),
+          "The Jacobian of the initial condition has nonzeros outside its "
+          "detected sparsity pattern");
     }
+#endif
   }
 
   return true;
@@ -565,13 +665,13 @@ bool IpoptInterface::eval_jac_g(Ipopt::Index, const Ipopt::Number* x, bool,
 
 #ifndef NDEBUG
 bool IpoptInterface::eval_h(Ipopt::Index n, const Ipopt::Number* x,
-                            bool /*new_x*/, Ipopt::Number obj_factor,
+                            bool new_x, Ipopt::Number obj_factor,
                             Ipopt::Index m, const Ipopt::Number* /*lambda*/,
                             bool /*new_lambda*/, Ipopt::Index nele_hess,
                             Ipopt::Index* iRow, Ipopt::Index* jCol,
                             Ipopt::Number* values) {
 #else
-bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
+bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool new_x,
                             Ipopt::Number obj_factor, Ipopt::Index,
                             const Ipopt::Number*, bool, Ipopt::Index,
                             Ipopt::Index* iRow, Ipopt::Index* jCol,
@@ -581,6 +681,9 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
                 "Inconsistent number of decision variables");
   assert_pretty(m == static_cast<Ipopt::Index>(nconst_),
                 "Inconsistent number of constraints");
+  if (new_x) {
+    diff_computed_ = false;
+  }
 
   const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
       problem_->get_runningModels();
@@ -595,15 +698,31 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
       const std::shared_ptr<ActionModelAbstract> model = models[t];
       const std::size_t ndxi = model->get_state()->get_ndx();
       const std::size_t nui = model->get_nu();
-      for (std::size_t idx_row = 0; idx_row < ndxi + nui; ++idx_row) {
-        for (std::size_t idx_col = 0; idx_col < ndxi + nui; ++idx_col) {
-          // We need the lower triangular matrix
-          if (idx_col > idx_row) {
-            break;
+      const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+      for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
+        // We need the lower triangular matrix
+        for (std::size_t idx_col = 0; idx_col <= idx_row; ++idx_col) {
+          if (d->Ldxdx_mask(idx_row, idx_col)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_row);
+            jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_col);
+            idx++;
+          }
+        }
+      }
+      for (std::size_t idx_row = 0; idx_row < nui; ++idx_row) {
+        for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
+          if (d->Ldxu_mask(idx_col, idx_row)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ixu_[t] + ndxi + idx_row);
+            jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_col);
+            idx++;
+          }
+        }
+        for (std::size_t idx_col = 0; idx_col <= idx_row; ++idx_col) {
+          if (d->Luu_mask(idx_row, idx_col)) {
+            iRow[idx] = static_cast<Ipopt::Index>(ixu_[t] + ndxi + idx_row);
+            jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + ndxi + idx_col);
+            idx++;
           }
-          iRow[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_row);
-          jCol[idx] = static_cast<Ipopt::Index>(ixu_[t] + idx_col);
-          idx++;
         }
       }
     }
@@ -612,14 +731,13 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
     const std::size_t ndxi =
         problem_->get_terminalModel()->get_state()->get_ndx();
     for (std::size_t idx_row = 0; idx_row < ndxi; idx_row++) {
-      for (std::size_t idx_col = 0; idx_col < ndxi; idx_col++) {
-        // We need the lower triangular matrix
-        if (idx_col > idx_row) {
-          break;
+      // We need the lower triangular matrix
+      for (std::size_t idx_col = 0; idx_col <= idx_row; idx_col++) {
+        if (datas_[T]->Ldxdx_mask(idx_row, idx_col)) {
+          iRow[idx] = static_cast<Ipopt::Index>(ixu_.back() + idx_row);
+          jCol[idx] = static_cast<Ipopt::Index>(ixu_.back() + idx_col);
+          idx++;
         }
-        iRow[idx] = static_cast<Ipopt::Index>(ixu_.back() + idx_row);
-        jCol[idx] = static_cast<Ipopt::Index>(ixu_.back() + idx_col);
-        idx++;
       }
     }
 
@@ -628,7 +746,8 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
                   "total non-zero Hessian values");
   } else {
     // return the values. This is a symmetric matrix, fill the lower left
-    // triangle only
+    // triangle only. The derivatives of the action models are only computed
+    // if they were not computed at this point by another evaluation
     // Running Costs
     const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
         problem_->get_runningDatas();
@@ -642,10 +761,11 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
       const std::size_t nui = model->get_nu();
       datas_[t]->dx = Eigen::VectorXd::Map(x + ixu_[t], ndxi);
       datas_[t]->u = Eigen::VectorXd::Map(x + ixu_[t] + ndxi, nui);
-
       model->get_state()->integrate(xs_[t], datas_[t]->dx, datas_[t]->x);
-      model->calcDiff(data, datas_[t]->x,
-                      datas_[t]->u);  // this might be removed
+      if (!diff_computed_) {
+        model->calc(data, datas_[t]->x, datas_[t]->u);
+        model->calcDiff(data, datas_[t]->x, datas_[t]->u);
+      }
       model->get_state()->Jintegrate(xs_[t], datas_[t]->dx, datas_[t]->Jint_dx,
                                      datas_[t]->Jint_dx, second, setto);
       datas_[t]->Ldxdx.noalias() =
@@ -659,27 +779,28 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
       const std::shared_ptr<ActionDataAbstract>& data = datas[t];
       const std::size_t ndxi = model->get_state()->get_ndx();
       const std::size_t nui = model->get_nu();
+      const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
       for (std::size_t idx_row = 0; idx_row < ndxi; ++idx_row) {
-        for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
-          // We need the lower triangular matrix
-          if (idx_col > idx_row) {
-            break;
+        // We need the lower triangular matrix
+        for (std::size_t idx_col = 0; idx_col <= idx_row; ++idx_col) {
+          if (d->Ldxdx_mask(idx_row, idx_col)) {
+            values[idx] = obj_factor * d->Ldxdx(idx_row, idx_col);
+            idx++;
           }
-          values[idx] = obj_factor * datas_[t]->Ldxdx(idx_row, idx_col);
-          idx++;
         }
       }
       for (std::size_t idx_row = 0; idx_row < nui; ++idx_row) {
         for (std::size_t idx_col = 0; idx_col < ndxi; ++idx_col) {
-          values[idx] = obj_factor * datas_[t]->Ldxu(idx_col, idx_row);
-          idx++;
+          if (d->Ldxu_mask(idx_col, idx_row)) {
+            values[idx] = obj_factor * d->Ldxu(idx_col, idx_row);
+            idx++;
+          }
         }
-        for (std::size_t idx_col = 0; idx_col < nui; ++idx_col) {
-          if (idx_col > idx_row) {
-            break;
+        for (std::size_t idx_col = 0; idx_col <= idx_row; ++idx_col) {
+          if (d->Luu_mask(idx_row, idx_col)) {
+            values[idx] = obj_factor * data->Luu(idx_row, idx_col);
+            idx++;
           }
-          values[idx] = obj_factor * data->Luu(idx_row, idx_col);
-          idx++;
         }
       }
     }
@@ -691,24 +812,43 @@ bool IpoptInterface::eval_h(Ipopt::Index, const Ipopt::Number* x, bool,
         problem_->get_terminalData();
     const std::size_t ndxi = model->get_state()->get_ndx();
     datas_[T]->dx = Eigen::VectorXd::Map(x + ixu_.back(), ndxi);
-
     model->get_state()->integrate(xs_[T], datas_[T]->dx, datas_[T]->x);
-    model->calc(data, datas_[T]->x);
-    model->calcDiff(data, datas_[T]->x);
+    if (!diff_computed_) {
+      model->calc(data, datas_[T]->x);
+      model->calcDiff(data, datas_[T]->x);
+    }
     model->get_state()->Jintegrate(xs_[T], datas_[T]->dx, datas_[T]->Jint_dx,
                                    datas_[T]->Jint_dx, second, setto);
+    diff_computed_ = true;
     datas_[T]->Ldxdx.noalias() =
         datas_[T]->Jint_dx.transpose() * data->Lxx * datas_[T]->Jint_dx;
     for (std::size_t idx_row = 0; idx_row < ndxi; idx_row++) {
-      for (std::size_t idx_col = 0; idx_col < ndxi; idx_col++) {
-        // We need the lower triangular matrix
-        if (idx_col > idx_row) {
-          break;
+      // We need the lower triangular matrix
+      for (std::size_t idx_col = 0; idx_col <= idx_row; idx_col++) {
+        if (datas_[T]->Ldxdx_mask(idx_row, idx_col)) {
+          values[idx] = obj_factor * datas_[T]->Ldxdx(idx_row, idx_col);
+          idx++;
         }
-        values[idx] = datas_[T]->Ldxdx(idx_row, idx_col);
-        idx++;
       }
     }
+#ifndef NDEBUG
+    // The sparsity detection samples random points, so it might miss nonzeros
+    if (sparsity_detected_) {
+      for (std::size_t t = 0; t < T; ++t) {
+        const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+        assert_pretty(!hasNonzerosOutside(d->Ldxdx, d->Ldxdx_mask, true) &&
+                          !hasNonzerosOutside(d->Ldxu, d->Ldxu_mask, false) &&
+                          !hasNonzerosOutside(datas[t]->Luu, d->Luu_mask, true),
+                      "The Hessian of node " << t
+                                             << " has nonzeros outside its "
+                                                "detected sparsity pattern");
+      }
+      assert_pretty(
+          !hasNonzerosOutside(datas_[T]->Ldxdx, datas_[T]->Ldxdx_mask, true),
+          "The Hessian of the terminal node has nonzeros outside its detected "
+          "sparsity pattern");
+    }
+#endif
   }
 
   return true;
@@ -757,10 +897,83 @@ bool IpoptInterface::intermediate_callback(
   return true;
 }
 
+void IpoptInterface::detectSparsity() {
+  const std::size_t T = problem_->get_T();
+  const std::vector<std::shared_ptr<ActionModelAbstract> >& models =
+      problem_->get_runningModels();
+  const std::vector<std::shared_ptr<ActionDataAbstract> >& datas =
+      problem_->get_runningDatas();
+  // Evaluate the dense derivatives, and accumulate their absolute values, at
+  // random points around the current guess
+  for (std::size_t t = 0; t <= T; ++t) {
+    datas_[t]->setDensePattern();
+  }
+  sparsity_detected_ = true;
+  Ipopt::Index n, m, nnz_jac_g, nnz_h_lag;
+  IndexStyleEnum index_style;
+  get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+  std::vector<Ipopt::Number> x(n), g(m), lambda(m, 0.), jac(nnz_jac_g),
+      hess(nnz_h_lag);
+  std::vector<Eigen::MatrixXd> Jg_dx(T), Jg_dxnext(T), Jg_u(T), Ldxdx(T + 1),
+      Ldxu(T), Luu(T);
+  for (std::size_t t = 0; t < T; ++t) {
+    const std::size_t ndxi = models[t]->get_state()->get_ndx();
+    const std::size_t nui = models[t]->get_nu();
+    Jg_dx[t] = Eigen::MatrixXd::Zero(ndxi, ndxi);
+    Jg_dxnext[t] = Eigen::MatrixXd::Zero(ndxi, ndxi);
+    Jg_u[t] = Eigen::MatrixXd::Zero(ndxi, nui);
+    Ldxdx[t] = Eigen::MatrixXd::Zero(ndxi, ndxi);
+    Ldxu[t] = Eigen::MatrixXd::Zero(ndxi, nui);
+    Luu[t] = Eigen::MatrixXd::Zero(nui, nui);
+  }
+  const std::size_t ndxT =
+      problem_->get_terminalModel()->get_state()->get_ndx();
+  Ldxdx[T] = Eigen::MatrixXd::Zero(ndxT, ndxT);
+  Eigen::MatrixXd Jg_ic = Eigen::MatrixXd::Zero(datas_[0]->Jg_ic.rows(),
+                                                datas_[0]->Jg_ic.cols());
+  const std::size_t nsamples = 3;
+  for (std::size_t s = 0; s < nsamples; ++s) {
+    Eigen::VectorXd::Map(x.data(), n) = Eigen::VectorXd::Random(n);
+    eval_g(n, x.data(), true, m, g.data());
+    eval_jac_g(n, x.data(), false, m, nnz_jac_g, NULL, NULL, jac.data());
+    if (hessian_type_ != LimitedMemoryHessian) {
+      eval_h(n, x.data(), false, 1., m, lambda.data(), true, nnz_h_lag, NULL,
+             NULL, hess.data());
+    }
+    for (std::size_t t = 0; t < T; ++t) {
+      const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+      Jg_dx[t] += d->Jg_dx.cwiseAbs();
+      Jg_dxnext[t] += d->Jg_dxnext.cwiseAbs();
+      Jg_u[t] += d->Jg_u.cwiseAbs();
+      Ldxdx[t] += d->Ldxdx.cwiseAbs() + d->Ldxdx.transpose().cwiseAbs();
+      Ldxu[t] += d->Ldxu.cwiseAbs();
+      Luu[t] += datas[t]->Luu.cwiseAbs() + datas[t]->Luu.transpose().cwiseAbs();
+    }
+    Ldxdx[T] +=
+        datas_[T]->Ldxdx.cwiseAbs() + datas_[T]->Ldxdx.transpose().cwiseAbs();
+    Jg_ic += datas_[0]->Jg_ic.cwiseAbs();
+  }
+
+  // Keep the entries that are nonzero in any of the evaluated points
+  for (std::size_t t = 0; t < T; ++t) {
+    const std::shared_ptr<IpoptInterfaceData>& d = datas_[t];
+    d->Jg_dx_mask = (Jg_dx[t].array() != 0.).matrix();
+    d->Jg_dxnext_mask = (Jg_dxnext[t].array() != 0.).matrix();
+    d->Jg_u_mask = (Jg_u[t].array() != 0.).matrix();
+    d->Ldxdx_mask =
+        (d->Ldxdx_mask.array() && (Ldxdx[t].array() != 0.)).matrix();
+    d->Ldxu_mask = (Ldxu[t].array() != 0.).matrix();
+    d->Luu_mask = (d->Luu_mask.array() && (Luu[t].array() != 0.)).matrix();
+  }
+  datas_[T]->Ldxdx_mask =
+      (datas_[T]->Ldxdx_mask.array() && (Ldxdx[T].array() != 0.)).matrix();
+  datas_[0]->Jg_ic_mask = (Jg_ic.array() != 0.).matrix();
+}
+
 std::shared_ptr<IpoptInterfaceData> IpoptInterface::createData(
     const std::size_t nx, const std::size_t ndx, const std::size_t nu) {
   return std::allocate_shared<IpoptInterfaceData>(
-      Eigen::aligned_allocator<IpoptInterfaceData>(), nx, ndx, nu);
+      DataAllocator<IpoptInterfaceData>(), nx, ndx, nu);
 }
 
 void IpoptInterface::set_xs(const std::vector<Eigen::VectorXd>& xs) {
@@ -789,4 +1002,26 @@ const std::shared_ptr<ShootingProblem>& IpoptInterface::get_problem() const {
 
 double IpoptInterface::get_cost() const { return cost_; }
 
+bool IpoptInterface::get_sparsity_detection() const {
+  return sparsity_detection_;
+}
+
+IpoptHessianType IpoptInterface::get_hessian_type() const {
+  return hessian_type_;
+}
+
+void IpoptInterface::set_sparsity_detection(const bool sparsity_detection) {
+  sparsity_detection_ = sparsity_detection;
+  sparsity_detected_ = false;
+  if (!sparsity_detection) {
+    for (std::size_t t = 0; t < datas_.size(); ++t) {
+      datas_[t]->setDensePattern();
+    }
+  }
+}
+
+void IpoptInterface::set_hessian_type(const IpoptHessianType hessian_type) {
+  hessian_type_ = hessian_type;
+}
+
 }  // namespace crocoddyl
@@ -10,6 +10,8 @@
 
 #include "crocoddyl/core/solvers/kkt.hpp"
 
+#include "crocoddyl/core/utils/exception.hpp"
+
 namespace crocoddyl {
 
 SolverKKT::SolverKKT(std::shared_ptr<ShootingProblem> problem)
@@ -45,6 +47,7 @@ bool SolverKKT::solve(const std::vector<Eigen::VectorXd>& init_xs,
         computeDirection(recalc);
       } catch (std::exception& e) {
         recalc = false;
+        increaseRegularization();
         if (preg_ == reg_max_) {
           return false;
         } else {
@@ -68,6 +71,9 @@ bool SolverKKT::solve(const std::vector<Eigen::VectorXd>& init_xs,
         was_feasible_ = is_feasible_;
         setCandidate(xs_try_, us_try_, true);
         cost_ = cost_try_;
+        if (preg_ != 0.) {
+          decreaseRegularization();
+        }
         break;
       }
     }
@@ -167,12 +173,12 @@ const Eigen::Vector2d& SolverKKT::expectedImprovement() {
   // -grad^T.primal
   d_(0) = -kktref_.segment(0, ndx_ + nu_).dot(primal_);
   // -(hessian.primal)^T.primal
-  kkt_primal_.noalias() = kkt_.block(0, 0, ndx_ + nu_, ndx_ + nu_) * primal_;
+  kkt_primal_.noalias() = kkt_.topLeftCorner(ndx_ + nu_, ndx_ + nu_) * primal_;
   d_(1) = -kkt_primal_.dot(primal_);
   return d_;
 }
 
-const Eigen::MatrixXd& SolverKKT::get_kkt() const { return kkt_; }
+Eigen::MatrixXd SolverKKT::get_kkt() const { return Eigen::MatrixXd(kkt_); }
 
 const Eigen::VectorXd& SolverKKT::get_kktref() const { return kktref_; }
 
@@ -203,7 +209,6 @@ double SolverKKT::calcDiff() {
   std::size_t ix = 0;
   std::size_t iu = 0;
   const std::size_t T = problem_->get_T();
-  kkt_.block(ndx_ + nu_, 0, ndx_, ndx_).setIdentity();
   for (std::size_t t = 0; t < T; ++t) {
     const std::shared_ptr<ActionModelAbstract>& m =
         problem_->get_runningModels()[t];
@@ -218,13 +223,16 @@ double SolverKKT::calcDiff() {
                            kktref_.segment(ndx_ + nu_, ndxi));
     }
 
-    // Filling KKT matrix
-    kkt_.block(ix, ix, ndxi, ndxi) = d->Lxx;
-    kkt_.block(ix, ndx_ + iu, ndxi, nui) = d->Lxu;
-    kkt_.block(ndx_ + iu, ix, nui, ndxi) = d->Lxu.transpose();
-    kkt_.block(ndx_ + iu, ndx_ + iu, nui, nui) = d->Luu;
-    kkt_.block(ndx_ + nu_ + cx0 + ix, ix, ndxi, ndxi) = -d->Fx;
-    kkt_.block(ndx_ + nu_ + cx0 + ix, ndx_ + iu, ndxi, nui) = -d->Fu;
+    // Filling KKT matrix. Note that the identities of the dynamics
+    // constraints are set when allocating its sparsity pattern
+    setBlock(ix, ix, d->Lxx);
+    setBlock(ix, ndx_ + iu, d->Lxu);
+    setBlock(ndx_ + iu, ix, d->Lxu.transpose());
+    setBlock(ndx_ + iu, ndx_ + iu, d->Luu);
+    setBlock(ndx_ + nu_ + cx0 + ix, ix, -d->Fx);
+    setBlock(ix, ndx_ + nu_ + cx0 + ix, -d->Fx.transpose());
+    setBlock(ndx_ + nu_ + cx0 + ix, ndx_ + iu, -d->Fu);
+    setBlock(ndx_ + iu, ndx_ + nu_ + cx0 + ix, -d->Fu.transpose());
 
     // Filling KKT vector
     kktref_.segment(ix, ndxi) = d->Lx;
@@ -238,21 +246,48 @@ double SolverKKT::calcDiff() {
   const std::shared_ptr<ActionDataAbstract>& df = problem_->get_terminalData();
   const std::size_t ndxf =
       problem_->get_terminalModel()->get_state()->get_ndx();
-  kkt_.block(ix, ix, ndxf, ndxf) = df->Lxx;
+  setBlock(ix, ix, df->Lxx);
   kktref_.segment(ix, ndxf) = df->Lx;
-  kkt_.block(0, ndx_ + nu_, ndx_ + nu_, ndx_) =
-      kkt_.block(ndx_ + nu_, 0, ndx_, ndx_ + nu_).transpose();
   return cost_;
 }
 
+void SolverKKT::setBlock(const std::size_t row, const std::size_t col,
+                         const Eigen::Ref<const Eigen::MatrixXd>& block) {
+  for (Eigen::Index j = 0; j < block.cols(); ++j) {
+    for (Eigen::Index i = 0; i < block.rows(); ++i) {
+      kkt_.coeffRef(row + i, col + j) = block(i, j);
+    }
+  }
+}
+
 void SolverKKT::computePrimalDual() {
-  primaldual_ = kkt_.lu().solve(-kktref_);
+  // The KKT matrix is symmetric indefinite and block banded, so we factorize
+  // it with a sparse LU. Its sparsity pattern is analyzed once
+  if (preg_ == 0. && dreg_ == 0.) {
+    kkt_lu_.factorize(kkt_);
+  } else {
+    kkt_reg_ = kkt_;
+    for (std::size_t i = 0; i < ndx_ + nu_; ++i) {
+      kkt_reg_.coeffRef(i, i) += preg_;
+    }
+    for (std::size_t i = ndx_ + nu_; i < 2 * ndx_ + nu_; ++i) {
+      kkt_reg_.coeffRef(i, i) -= dreg_;
+    }
+    kkt_lu_.factorize(kkt_reg_);
+  }
+  if (kkt_lu_.info() != Eigen::Success) {
+    throw_pretty("KKT matrix is singular: " << kkt_lu_.lastErrorMessage());
+  }
+  primaldual_ = kkt_lu_.solve(-kktref_);
   primal_ = primaldual_.segment(0, ndx_ + nu_);
   dual_ = primaldual_.segment(ndx_ + nu_, ndx_);
 }
 
 void SolverKKT::increaseRegularization() {
   preg_ *= reg_incfactor_;
+  if (preg_ < reg_min_) {
+    preg_ = reg_min_;
+  }
   if (preg_ > reg_max_) {
     preg_ = reg_max_;
   }
@@ -304,9 +339,42 @@ void SolverKKT::allocateData() {
   dxs_.back() = Eigen::VectorXd::Zero(ndx);
   lambdas_.back() = Eigen::VectorXd::Zero(ndx);
 
-  // Set dimensions for kkt matrix and kkt_ref vector
+  // Set the sparsity pattern of the kkt matrix, i.e., the cost Hessians, the
+  // dynamics Jacobians and the diagonal of the dual variables
+  std::vector<Eigen::Triplet<double> > triplets;
+  const std::size_t ndual = ndx_ + nu_;
+  std::size_t ix = 0;
+  std::size_t iu = 0;
+  for (std::size_t t = 0; t <= T; ++t) {
+    const std::size_t nui = t < T ? models[t]->get_nu() : 0;
+    const std::size_t nwi = ndx + nui;
+    for (std::size_t i = 0; i < ndx; ++i) {
+      triplets.push_back(Eigen::Triplet<double>(ndual + ix + i, ix + i, 1.));
+      triplets.push_back(Eigen::Triplet<double>(ix + i, ndual + ix + i, 1.));
+      triplets.push_back(
+          Eigen::Triplet<double>(ndual + ix + i, ndual + ix + i, 0.));
+    }
+    for (std::size_t j = 0; j < nwi; ++j) {
+      const std::size_t col = j < ndx ? ix + j : ndx_ + iu + j - ndx;
+      for (std::size_t i = 0; i < nwi; ++i) {
+        const std::size_t row = i < ndx ? ix + i : ndx_ + iu + i - ndx;
+        triplets.push_back(Eigen::Triplet<double>(row, col, 0.));
+      }
+      if (t < T) {
+        for (std::size_t i = 0; i < ndx; ++i) {
+          triplets.push_back(
+              Eigen::Triplet<double>(ndual + ndx + ix + i, col, 0.));
+          triplets.push_back(
+              Eigen::Triplet<double>(col, ndual + ndx + ix + i, 0.));
+        }
+      }
+    }
+    ix += ndx;
+    iu += nui;
+  }
   kkt_.resize(2 * ndx_ + nu_, 2 * ndx_ + nu_);
-  kkt_.setZero();
+  kkt_.setFromTriplets(triplets.begin(), triplets.end());
+  kkt_lu_.analyzePattern(kkt_);
   kktref_.resize(2 * ndx_ + nu_);
   kktref_.setZero();
   primaldual_.resize(2 * ndx_ + nu_);
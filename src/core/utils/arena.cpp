@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/arena.hpp"
+
+#include <cstdint>
+
+#include "crocoddyl/core/utils/exception.hpp"
+
+namespace crocoddyl {
+
+namespace {
+
+// Alignment of the blocks. It makes the layout of the allocations independent
+// of the address returned by the heap.
+const std::size_t kBlockAlignment = 64;
+
+inline char* alignPointer(char* ptr, const std::size_t alignment) {
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+  return ptr + (alignment - address % alignment) % alignment;
+}
+
+}  // namespace
+
+DataArena::DataArena(const std::size_t block_size)
+    : block_size_(block_size),
+      ptr_(NULL),
+      available_(0),
+      size_(0),
+      capacity_(0) {}
+
+DataArena::~DataArena() {}
+
+void* DataArena::allocate(const std::size_t size, const std::size_t alignment) {
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+    throw_pretty("Invalid argument: "
+                 << "the alignment should be a power of two");
+  }
+  std::size_t padding = alignPointer(ptr_, alignment) - ptr_;
+  if (ptr_ == NULL || padding + size > available_) {
+    // Reserve a new block with enough space for the requested memory
+    const std::size_t nbytes =
+        size + alignment > block_size_ ? size + alignment : block_size_;
+    blocks_.push_back(
+        std::unique_ptr<char[]>(new char[nbytes + kBlockAlignment]));
+    ptr_ = alignPointer(blocks_.back().get(), kBlockAlignment);
+    available_ = nbytes;
+    capacity_ += nbytes;
+    padding = alignPointer(ptr_, alignment) - ptr_;
+  }
+  void* p = ptr_ + padding;
+  ptr_ += padding + size;
+  available_ -= padding + size;
+  size_ += padding + size;
+  return p;
+}
+
+std::size_t DataArena::get_size() const { return size_; }
+
+std::size_t DataArena::get_capacity() const { return capacity_; }
+
+std::size_t DataArena::get_nblocks() const { return blocks_.size(); }
+
+std::size_t DataArena::get_block_size() const { return block_size_; }
+
+const std::shared_ptr<DataArena>& DataArena::get_current() {
+  return current();
+}
+
+std::shared_ptr<DataArena>& DataArena::current() {
+  static thread_local std::shared_ptr<DataArena> arena;
+  return arena;
+}
+
+DataArenaScope::DataArenaScope(const std::shared_ptr<DataArena>& arena)
+    : previous_(DataArena::current()) {
+  DataArena::current() = arena;
+}
+
+DataArenaScope::~DataArenaScope() { DataArena::current() = previous_; }
+
+}  // namespace crocoddyl
@@ -0,0 +1,394 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif  // CROCODDYL_WITH_MULTITHREADING
+
+#include "crocoddyl/core/utils/executor.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "crocoddyl/core/fwd.hpp"
+
+namespace crocoddyl {
+
+namespace {
+
+// Number of times that an idle worker checks for a new job before sleeping
+const std::size_t kSpinCount = 1024;
+
+void runSerial(const std::size_t n, ExecutorAbstract::TaskFunction fn,
+               const void* task) {
+  std::exception_ptr exception;
+  for (std::size_t i = 0; i < n; ++i) {
+    try {
+      fn(task, i);
+    } catch (...) {
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+#ifdef CROCODDYL_WITH_MULTITHREADING
+inline void runIteration(const std::size_t i, ExecutorAbstract::TaskFunction fn,
+                         const void* task, std::exception_ptr& exception) {
+  try {
+    fn(task, i);
+  } catch (...) {
+#pragma omp critical(crocoddyl_executor_openmp)
+    if (!exception) {
+      exception = std::current_exception();
+    }
+  }
+}
+#endif
+
+inline std::uint64_t packRange(const std::size_t begin, const std::size_t end) {
+  return (static_cast<std::uint64_t>(begin) << 32) |
+         static_cast<std::uint64_t>(end);
+}
+
+}  // namespace
+
+std::size_t getNumberOfThreads(const int nthreads, const char* what) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  if (enableMultithreading()) {
+    return nthreads < 1 ? static_cast<std::size_t>(CROCODDYL_WITH_NTHREADS)
+                        : static_cast<std::size_t>(nthreads);
+  }
+#else
+  (void)nthreads;
+#endif
+  std::cerr << "Warning: " << what
+            << " won't run in parallel as multithreading support is not "
+               "enabled."
+            << std::endl;
+  return 1;
+}
+
+ExecutorAbstract::ExecutorAbstract() {}
+
+ExecutorAbstract::~ExecutorAbstract() {}
+
+std::size_t ExecutorAbstract::getNumberOfThreads(const int nthreads,
+                                                 const char* what) const {
+  return crocoddyl::getNumberOfThreads(nthreads, what);
+}
+
+ExecutorOpenMP::ExecutorOpenMP() : ExecutorAbstract() {}
+
+ExecutorOpenMP::~ExecutorOpenMP() {}
+
+void ExecutorOpenMP::run(const std::size_t n, const std::size_t nthreads,
+                         TaskFunction fn, const void* task,
+                         const std::vector<double>& costs) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  if (nthreads > 1 && n > 1) {
+    std::exception_ptr exception;
+    double total = 0.;
+    if (costs.size() == n) {
+      for (std::size_t i = 0; i < n; ++i) {
+        total += std::max(costs[i], 0.);
+      }
+    }
+    if (total > 0.) {
+      // Each thread computes a contiguous range of iterations with a similar
+      // accumulated cost
+#pragma omp parallel num_threads(nthreads)
+      {
+        const std::size_t m = static_cast<std::size_t>(omp_get_num_threads());
+        const std::size_t k = static_cast<std::size_t>(omp_get_thread_num());
+        const std::size_t end = balancedBound(costs, total, k + 1, m);
+        for (std::size_t i = balancedBound(costs, total, k, m); i < end; ++i) {
+          runIteration(i, fn, task, exception);
+        }
+      }
+    } else {
+#pragma omp parallel for num_threads(nthreads)
+      for (std::size_t i = 0; i < n; ++i) {
+        runIteration(i, fn, task, exception);
+      }
+    }
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+    return;
+  }
+#else
+  (void)nthreads;
+  (void)costs;
+#endif
+  runSerial(n, fn, task);
+}
+
+std::size_t ExecutorOpenMP::balancedBound(const std::vector<double>& costs,
+                                          const double total,
+                                          const std::size_t k,
+                                          const std::size_t m) {
+  const std::size_t n = costs.size();
+  if (k == 0) {
+    return 0;
+  } else if (k >= m) {
+    return n;
+  }
+  const double target =
+      total * static_cast<double>(k) / static_cast<double>(m);
+  double acc = 0.;
+  for (std::size_t i = 0; i < n; ++i) {
+    const double cost = std::max(costs[i], 0.);
+    if (acc + 0.5 * cost >= target) {
+      return i;
+    }
+    acc += cost;
+  }
+  return n;
+}
+
+ExecutorWorkStealing::ExecutorWorkStealing(const int nthreads,
+                                           const std::size_t nchunks)
+    : ExecutorAbstract(),
+      nthreads_(1),
+      nchunks_(std::max(nchunks, std::size_t(1))),
+      busy_(false),
+      stop_(false),
+      done_(0),
+      ticket_(0),
+      nparticipants_(0),
+      fn_(NULL),
+      task_(NULL) {
+  // The pool is built on std::thread, so it does not depend on OpenMP
+  if (nthreads < 1) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+    nthreads_ = CROCODDYL_WITH_NTHREADS;
+#else
+    nthreads_ = std::max(
+        static_cast<std::size_t>(std::thread::hardware_concurrency()),
+        std::size_t(1));
+#endif
+  } else {
+    nthreads_ = static_cast<std::size_t>(nthreads);
+  }
+  slots_.reset(new Slot[nthreads_]);
+  workers_.reserve(nthreads_ - 1);
+  for (std::size_t id = 1; id < nthreads_; ++id) {
+    workers_.push_back(std::thread(&ExecutorWorkStealing::work, this, id));
+  }
+}
+
+ExecutorWorkStealing::~ExecutorWorkStealing() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  cv_.notify_all();
+  for (std::size_t i = 0; i < workers_.size(); ++i) {
+    workers_[i].join();
+  }
+}
+
+void ExecutorWorkStealing::run(const std::size_t n, const std::size_t nthreads,
+                               TaskFunction fn, const void* task,
+                               const std::vector<double>& costs) {
+  const std::size_t m = std::min(std::min(nthreads, nthreads_), n);
+  bool is_idle = false;
+  // Nested and concurrent loops are computed serially by the calling thread
+  if (m < 2 || !busy_.compare_exchange_strong(is_idle, true,
+                                              std::memory_order_acquire)) {
+    runSerial(n, fn, task);
+    return;
+  }
+
+  // Distribute contiguous ranges of chunks with similar costs
+  const std::size_t nchunks = partition(n, std::min(n, m * nchunks_), costs);
+  for (std::size_t id = 0; id < m; ++id) {
+    slots_[id].range.store(packRange(id * nchunks / m, (id + 1) * nchunks / m),
+                           std::memory_order_relaxed);
+  }
+  fn_ = fn;
+  task_ = task;
+  nparticipants_ = m;
+  exception_ = std::exception_ptr();
+  done_.store(0, std::memory_order_relaxed);
+
+  // Assign the job to the workers. We hold the mutex to avoid missing the
+  // notification of the sleeping workers.
+  ++ticket_;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t id = 1; id < m; ++id) {
+      slots_[id].ticket.store(ticket_, std::memory_order_release);
+    }
+  }
+  cv_.notify_all();
+  execute(0);
+  while (done_.load(std::memory_order_acquire) != m - 1) {
+    std::this_thread::yield();
+  }
+
+  const std::exception_ptr exception = exception_;
+  exception_ = std::exception_ptr();
+  busy_.store(false, std::memory_order_release);
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+std::size_t ExecutorWorkStealing::getNumberOfThreads(const int nthreads,
+                                                     const char*) const {
+  if (nthreads < 1) {
+    return nthreads_;
+  }
+  return std::min(static_cast<std::size_t>(nthreads), nthreads_);
+}
+
+std::size_t ExecutorWorkStealing::get_nthreads() const { return nthreads_; }
+
+std::size_t ExecutorWorkStealing::get_nchunks() const { return nchunks_; }
+
+void ExecutorWorkStealing::set_nchunks(const std::size_t nchunks) {
+  nchunks_ = std::max(nchunks, std::size_t(1));
+}
+
+void ExecutorWorkStealing::work(const std::size_t id) {
+  Slot& slot = slots_[id];
+  std::size_t seen = 0;
+  while (true) {
+    // Spin for a short period as the next job usually comes shortly after
+    std::size_t ticket = slot.ticket.load(std::memory_order_acquire);
+    for (std::size_t k = 0; ticket == seen && k < kSpinCount; ++k) {
+      if (stop_.load(std::memory_order_acquire)) {
+        return;
+      }
+      std::this_thread::yield();
+      ticket = slot.ticket.load(std::memory_order_acquire);
+    }
+    if (ticket == seen) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&] {
+        return stop_.load(std::memory_order_acquire) ||
+               slot.ticket.load(std::memory_order_acquire) != seen;
+      });
+      ticket = slot.ticket.load(std::memory_order_acquire);
+      if (ticket == seen) {
+        return;
+      }
+    }
+    seen = ticket;
+    execute(id);
+    done_.fetch_add(1, std::memory_order_release);
+  }
+}
+
+void ExecutorWorkStealing::execute(const std::size_t id) {
+  const std::size_t m = nparticipants_;
+  std::size_t chunk;
+  while (true) {
+    if (!pop(id, chunk)) {
+      bool is_stolen = false;
+      for (std::size_t k = 1; k < m && !is_stolen; ++k) {
+        is_stolen = steal((id + k) % m, chunk);
+      }
+      if (!is_stolen) {
+        break;
+      }
+    }
+    for (std::size_t i = bounds_[chunk]; i < bounds_[chunk + 1]; ++i) {
+      try {
+        fn_(task_, i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex_);
+        if (!exception_) {
+          exception_ = std::current_exception();
+        }
+      }
+    }
+  }
+}
+
+std::size_t ExecutorWorkStealing::partition(const std::size_t n,
+                                            const std::size_t nchunks,
+                                            const std::vector<double>& costs) {
+  bounds_.resize(nchunks + 1);
+  bounds_[0] = 0;
+  if (costs.size() == n) {
+    double total = 0.;
+    for (std::size_t i = 0; i < n; ++i) {
+      total += std::max(costs[i], 0.);
+    }
+    if (total > 0.) {
+      // Cut the chunks once their accumulated cost reaches the next fraction
+      // of the total cost. Heavy iterations might cross several fractions, so
+      // the number of chunks can be lower than requested.
+      std::size_t k = 1, target = 1;
+      double acc = 0.;
+      for (std::size_t i = 0; i + 1 < n && target < nchunks; ++i) {
+        acc += std::max(costs[i], 0.);
+        if (acc >= total * static_cast<double>(target) /
+                       static_cast<double>(nchunks)) {
+          bounds_[k++] = i + 1;
+          while (target < nchunks &&
+                 acc >= total * static_cast<double>(target) /
+                            static_cast<double>(nchunks)) {
+            ++target;
+          }
+        }
+      }
+      bounds_[k] = n;
+      return k;
+    }
+  }
+  for (std::size_t k = 1; k <= nchunks; ++k) {
+    bounds_[k] = k * n / nchunks;
+  }
+  return nchunks;
+}
+
+bool ExecutorWorkStealing::pop(const std::size_t id, std::size_t& chunk) {
+  std::atomic<std::uint64_t>& range = slots_[id].range;
+  std::uint64_t current = range.load(std::memory_order_acquire);
+  while (true) {
+    const std::size_t begin = static_cast<std::size_t>(current >> 32);
+    const std::size_t end = static_cast<std::size_t>(current & 0xffffffff);
+    if (begin >= end) {
+      return false;
+    }
+    if (range.compare_exchange_weak(current, packRange(begin + 1, end),
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      chunk = begin;
+      return true;
+    }
+  }
+}
+
+bool ExecutorWorkStealing::steal(const std::size_t id, std::size_t& chunk) {
+  std::atomic<std::uint64_t>& range = slots_[id].range;
+  std::uint64_t current = range.load(std::memory_order_acquire);
+  while (true) {
+    const std::size_t begin = static_cast<std::size_t>(current >> 32);
+    const std::size_t end = static_cast<std::size_t>(current & 0xffffffff);
+    if (begin >= end) {
+      return false;
+    }
+    if (range.compare_exchange_weak(current, packRange(begin, end - 1),
+                                    std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      chunk = end - 1;
+      return true;
+    }
+  }
+}
+
+}  // namespace crocoddyl
@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/malloc-guard.hpp"
+
+#include <Eigen/Core>
+#include <cstddef>
+#include <mutex>
+
+namespace crocoddyl {
+
+namespace {
+
+enum GuardState { NoGuard = 0, AllowingGuard, ForbiddingGuard };
+
+#ifdef CROCODDYL_WITH_RUNTIME_NO_MALLOC
+// State of the innermost guard of each thread
+thread_local int thread_state = NoGuard;
+
+// Number of threads whose innermost guard allows or forbids the allocations
+std::mutex guard_mutex;
+std::size_t nallowing = 0;
+std::size_t nforbidding = 0;
+
+void updateThreadState(const int previous, const int current) {
+  std::lock_guard<std::mutex> lock(guard_mutex);
+  if (previous == AllowingGuard) {
+    --nallowing;
+  } else if (previous == ForbiddingGuard) {
+    --nforbidding;
+  }
+  if (current == AllowingGuard) {
+    ++nallowing;
+  } else if (current == ForbiddingGuard) {
+    ++nforbidding;
+  }
+  Eigen::internal::set_is_malloc_allowed(nallowing > 0 || nforbidding == 0);
+  thread_state = current;
+}
+#endif
+
+}  // namespace
+
+MallocGuard::MallocGuard(const bool allowed) : previous_(NoGuard) {
+#ifdef CROCODDYL_WITH_RUNTIME_NO_MALLOC
+  previous_ = thread_state;
+  updateThreadState(previous_, allowed ? AllowingGuard : ForbiddingGuard);
+#else
+  (void)allowed;
+#endif
+}
+
+MallocGuard::~MallocGuard() {
+#ifdef CROCODDYL_WITH_RUNTIME_NO_MALLOC
+  updateThreadState(thread_state, previous_);
+#endif
+}
+
+}  // namespace crocoddyl
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2025, University of Edinburgh, Heriot-Watt University
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * It replaces the allocation functions of the test executable, so it has to
+ * be included only once per executable (i.e., in the test_XXX.cpp).
+ *
+ * With glibc, `malloc`, `calloc`, `realloc`, `posix_memalign` and
+ * `aligned_alloc` are counted, which covers the allocations done by
+ * `operator new` and Eigen. Otherwise, only `operator new` is counted.
+ */
+
+#ifndef CROCODDYL_ALLOCATION_COUNTER_HPP_
+#define CROCODDYL_ALLOCATION_COUNTER_HPP_
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace crocoddyl {
+namespace unittest {
+
+static std::atomic<std::size_t> nallocations(0);
+
+/**
+ * @brief Count the heap allocations done during its lifetime
+ */
+class AllocationCounter {
+ public:
+  AllocationCounter() : start_(nallocations.load()) {}
+
+  /**
+   * @brief Return the number of allocations since its creation
+   */
+  std::size_t get_nallocations() const { return nallocations.load() - start_; }
+
+ private:
+  std::size_t start_;
+};
+
+}  // namespace unittest
+}  // namespace crocoddyl
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+  ++crocoddyl::unittest::nallocations;
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) noexcept {
+  ++crocoddyl::unittest::nallocations;
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size) noexcept {
+  ++crocoddyl::unittest::nallocations;
+  return __libc_realloc(ptr, size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment,
+                   std::size_t size) noexcept {
+  ++crocoddyl::unittest::nallocations;
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr == NULL ? ENOMEM : 0;
+}
+
+void* aligned_alloc(std::size_t alignment, std::size_t size) noexcept {
+  ++crocoddyl::unittest::nallocations;
+  return __libc_memalign(alignment, size);
+}
+}
+#else
+void* operator new(std::size_t size) {
+  ++crocoddyl::unittest::nallocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == NULL) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+#endif
+
+#endif  // CROCODDYL_ALLOCATION_COUNTER_HPP_
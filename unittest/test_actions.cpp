@@ -11,6 +11,9 @@
 #define BOOST_TEST_NO_MAIN
 #define BOOST_TEST_ALTERNATIVE_INIT_API
 
+#include "crocoddyl/core/actions/lqr.hpp"
+#include "crocoddyl/core/actions/unicycle.hpp"
+#include "crocoddyl/core/autodiff/action.hpp"
 #include "factory/action.hpp"
 #include "factory/control.hpp"
 #include "factory/diff_action.hpp"
@@ -112,6 +115,119 @@ void test_partial_derivatives_against_numdiff(
   BOOST_CHECK((data->Gx - data_num_diff->Gx).isZero(tol));
 }
 
+void test_numdiff_multithreading(ActionModelTypes::Type action_model_type,
+                                 const bool work_stealing) {
+  // create the model
+  ActionModelFactory factory;
+  const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+      factory.create(action_model_type);
+
+  // create the serial and parallel numdiff models and datas
+  crocoddyl::ActionModelNumDiff model_num_diff(model);
+  crocoddyl::ActionModelNumDiff model_num_diff_mt(model);
+  // the work-stealing executor runs in parallel without OpenMP support
+  if (work_stealing) {
+    model_num_diff_mt.set_executor(
+        std::make_shared<crocoddyl::ExecutorWorkStealing>(4));
+  }
+  model_num_diff_mt.set_nthreads(4);
+  BOOST_CHECK(model_num_diff_mt.get_nthreads() == 4);
+  const std::shared_ptr<crocoddyl::ActionDataAbstract>& data =
+      model_num_diff.createData();
+  const std::shared_ptr<crocoddyl::ActionDataAbstract>& data_mt =
+      model_num_diff_mt.createData();
+
+  // Generating random values for the state and control
+  Eigen::VectorXd x = model->get_state()->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model->get_nu());
+
+  // Checking that both models compute the same derivatives
+  model_num_diff.calc(data, x, u);
+  model_num_diff.calcDiff(data, x, u);
+  model_num_diff_mt.calc(data_mt, x, u);
+  model_num_diff_mt.calcDiff(data_mt, x, u);
+  BOOST_CHECK((data->Fx - data_mt->Fx).isZero(1e-9));
+  BOOST_CHECK((data->Fu - data_mt->Fu).isZero(1e-9));
+  BOOST_CHECK((data->Lx - data_mt->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lu - data_mt->Lu).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_mt->Lxx).isZero(1e-9));
+  BOOST_CHECK((data->Lxu - data_mt->Lxu).isZero(1e-9));
+  BOOST_CHECK((data->Luu - data_mt->Luu).isZero(1e-9));
+  BOOST_CHECK((data->Gx - data_mt->Gx).isZero(1e-9));
+  BOOST_CHECK((data->Gu - data_mt->Gu).isZero(1e-9));
+  BOOST_CHECK((data->Hx - data_mt->Hx).isZero(1e-9));
+  BOOST_CHECK((data->Hu - data_mt->Hu).isZero(1e-9));
+
+  // Checking the terminal derivatives
+  x = model->get_state()->rand();
+  model_num_diff.calc(data, x);
+  model_num_diff.calcDiff(data, x);
+  model_num_diff_mt.calc(data_mt, x);
+  model_num_diff_mt.calcDiff(data_mt, x);
+  BOOST_CHECK((data->Lx - data_mt->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_mt->Lxx).isZero(1e-9));
+  BOOST_CHECK((data->Gx - data_mt->Gx).isZero(1e-9));
+  BOOST_CHECK((data->Hx - data_mt->Hx).isZero(1e-9));
+}
+
+void test_autodiff_against_analytical(
+    const std::shared_ptr<crocoddyl::ActionModelAbstract>& model,
+    const std::shared_ptr<crocoddyl::ActionModelAbstractTpl<
+        crocoddyl::ActionModelAutoDiff::ADScalar> >& admodel) {
+  // create the autodiff model and the datas
+  crocoddyl::ActionModelAutoDiff model_auto_diff(admodel, model);
+  const std::shared_ptr<crocoddyl::ActionDataAbstract>& data =
+      model->createData();
+  const std::shared_ptr<crocoddyl::ActionDataAbstract>& data_auto_diff =
+      model_auto_diff.createData();
+
+  // Generating random values for the state and control
+  Eigen::VectorXd x = model->get_state()->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model->get_nu());
+
+  // Checking the exact Jacobians and the Hessians
+  model->calc(data, x, u);
+  model->calcDiff(data, x, u);
+  model_auto_diff.calc(data_auto_diff, x, u);
+  model_auto_diff.calcDiff(data_auto_diff, x, u);
+  const double tol = std::sqrt(model_auto_diff.get_disturbance());
+  BOOST_CHECK(std::abs(data->cost - data_auto_diff->cost) < 1e-9);
+  BOOST_CHECK((data->xnext - data_auto_diff->xnext).isZero(1e-9));
+  BOOST_CHECK((data->Fx - data_auto_diff->Fx).isZero(1e-9));
+  BOOST_CHECK((data->Fu - data_auto_diff->Fu).isZero(1e-9));
+  BOOST_CHECK((data->Lx - data_auto_diff->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lu - data_auto_diff->Lu).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_auto_diff->Lxx).isZero(tol));
+  BOOST_CHECK((data->Lxu - data_auto_diff->Lxu).isZero(tol));
+  BOOST_CHECK((data->Luu - data_auto_diff->Luu).isZero(tol));
+
+  // Checking the terminal derivatives
+  x = model->get_state()->rand();
+  model->calc(data, x);
+  model->calcDiff(data, x);
+  model_auto_diff.calc(data_auto_diff, x);
+  model_auto_diff.calcDiff(data_auto_diff, x);
+  BOOST_CHECK((data->Lx - data_auto_diff->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_auto_diff->Lxx).isZero(tol));
+}
+
+void register_autodiff_unit_tests() {
+  typedef crocoddyl::ActionModelAutoDiff::ADScalar ADScalar;
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_ActionModelAutoDiff";
+  std::cout << "Running " << test_name.str() << std::endl;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  ts->add(BOOST_TEST_CASE(boost::bind(
+      &test_autodiff_against_analytical,
+      std::make_shared<crocoddyl::ActionModelUnicycle>(),
+      std::make_shared<crocoddyl::ActionModelUnicycleTpl<ADScalar> >())));
+  ts->add(BOOST_TEST_CASE(boost::bind(
+      &test_autodiff_against_analytical,
+      std::make_shared<crocoddyl::ActionModelLQR>(8, 4, false),
+      std::make_shared<crocoddyl::ActionModelLQRTpl<ADScalar> >(8, 4, false))));
+  framework::master_test_suite().add(ts);
+}
+
 void test_check_action_data(ActionModelTypes::Type action_model_type) {
   // create the model
   ActionModelFactory factory;
@@ -270,6 +386,12 @@ void register_action_model_unit_tests(
       BOOST_TEST_CASE(boost::bind(&test_calc_action_model, action_model_type)));
   ts->add(BOOST_TEST_CASE(
       boost::bind(&test_partial_derivatives_action_model, action_model_type)));
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_numdiff_multithreading, action_model_type, false)));
+#endif  // CROCODDYL_WITH_MULTITHREADING
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_numdiff_multithreading, action_model_type, true)));
   framework::master_test_suite().add(ts);
 }
 
@@ -297,6 +419,7 @@ bool init_function() {
   for (size_t i = 0; i < ActionModelTypes::all.size(); ++i) {
     register_action_model_unit_tests(ActionModelTypes::all[i]);
   }
+  register_autodiff_unit_tests();
 
   for (size_t i = 0; i < DifferentialActionModelTypes::all.size(); ++i) {
     register_integrated_action_model_unit_tests(
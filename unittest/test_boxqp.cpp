@@ -145,6 +145,95 @@ void test_box_qp_with_identity_hessian() {
   BOOST_CHECK(sol_reg.clamped_idx.size() == nc_reg);
 }
 
+void test_warm_started_box_qp() {
+  std::size_t nx = random_int_in_range(2, 10);
+  crocoddyl::BoxQP boxqp(nx, 100, 0.1, 1e-12, 0.);
+
+  Eigen::MatrixXd H = Eigen::MatrixXd::Random(nx, nx);
+  Eigen::MatrixXd hessian =
+      H.transpose() * H + nx * Eigen::MatrixXd::Identity(nx, nx);
+  hessian = 0.5 * (hessian + hessian.transpose()).eval();
+  Eigen::VectorXd gradient = 2. * nx * Eigen::VectorXd::Random(nx);
+  Eigen::VectorXd lb = -Eigen::VectorXd::Ones(nx);
+  Eigen::VectorXd ub = Eigen::VectorXd::Ones(nx);
+  Eigen::VectorXd xinit = Eigen::VectorXd::Zero(nx);
+  crocoddyl::BoxQPSolution sol = boxqp.solve(hessian, gradient, lb, ub, xinit);
+
+  // Checking that warm-starting from the solved active set returns the same
+  // solution
+  crocoddyl::BoxQPSolution sol_warm =
+      boxqp.solve(hessian, gradient, lb, ub, xinit, sol.clamped_idx);
+  BOOST_CHECK((sol_warm.x - sol.x).isZero(1e-9));
+  BOOST_CHECK(sol_warm.free_idx == sol.free_idx);
+  BOOST_CHECK(sol_warm.clamped_idx == sol.clamped_idx);
+
+  // Checking the inverse of the free space Hessian
+  const std::size_t nf = sol.free_idx.size();
+  Eigen::MatrixXd Hff(nf, nf);
+  for (std::size_t i = 0; i < nf; ++i) {
+    for (std::size_t j = 0; j < nf; ++j) {
+      Hff(i, j) = hessian(sol.free_idx[i], sol.free_idx[j]);
+    }
+  }
+  BOOST_CHECK(
+      (sol_warm.Hff_inv.topLeftCorner(nf, nf) * Hff -
+       Eigen::MatrixXd::Identity(nf, nf))
+          .isZero(1e-9));
+
+  // Checking the solution without computing the inverse of the free space
+  // Hessian, which is replaced by its Cholesky decomposition
+  boxqp.set_compute_inverse(false);
+  crocoddyl::BoxQPSolution sol_noinv =
+      boxqp.solve(hessian, gradient, lb, ub, xinit);
+  BOOST_CHECK((sol_noinv.x - sol.x).isZero(1e-9));
+  Eigen::MatrixXd B = Eigen::MatrixXd::Random(nf, nx);
+  Eigen::MatrixXd HffB = B;
+  boxqp.solveFreeInPlace(HffB);
+  BOOST_CHECK((Hff * HffB - B).isZero(1e-9));
+}
+
+void test_single_index_factor_update() {
+  crocoddyl::BoxQP boxqp(3, 100, 0.1, 1e-12, 0.);
+  const double inf = std::numeric_limits<double>::infinity();
+  Eigen::MatrixXd hessian(3, 3);
+  hessian << 2., 1., 0., 1., 2., 1., 0., 1., 2.;
+  Eigen::VectorXd lb(3), ub(3);
+  lb << -inf, -1., -inf;
+  ub << inf, 1., inf;
+  const Eigen::VectorXd xinit = Eigen::VectorXd::Zero(3);
+
+  // The middle index is clamped by the warm start and then enters the free
+  // space after the first Newton step, which updates the factorization
+  Eigen::VectorXd xopt(3);
+  xopt << -2., 0.5, -2.;
+  Eigen::VectorXd gradient = -hessian * xopt;
+  crocoddyl::BoxQPSolution sol = boxqp.solve(
+      hessian, gradient, lb, ub, xinit, std::vector<std::size_t>(1, 1));
+  BOOST_CHECK((sol.x - xopt).isZero(1e-9));
+  BOOST_CHECK(sol.free_idx.size() == 3);
+  Eigen::MatrixXd Hff_inv = Eigen::MatrixXd::Identity(3, 3);
+  boxqp.solveFreeInPlace(Hff_inv);
+  BOOST_CHECK(
+      (Hff_inv - hessian.llt().solve(Eigen::MatrixXd::Identity(3, 3)))
+          .isZero(1e-9));
+  BOOST_CHECK((sol.Hff_inv - Hff_inv).isZero(1e-9));
+
+  // The middle index leaves the free space after the first step hits its
+  // upper bound, which downdates the factorization
+  xopt << 0.1, 5., 0.1;
+  gradient = -hessian * xopt;
+  sol = boxqp.solve(hessian, gradient, lb, ub, xinit);
+  BOOST_CHECK(sol.clamped_idx == std::vector<std::size_t>(1, 1));
+  BOOST_CHECK(sol.free_idx.size() == 2);
+  Eigen::MatrixXd Hff(2, 2);
+  Hff << hessian(0, 0), hessian(0, 2), hessian(2, 0), hessian(2, 2);
+  Hff_inv = Eigen::MatrixXd::Identity(2, 2);
+  boxqp.solveFreeInPlace(Hff_inv);
+  BOOST_CHECK((Hff_inv - Hff.llt().solve(Eigen::MatrixXd::Identity(2, 2)))
+                  .isZero(1e-9));
+  BOOST_CHECK((sol.Hff_inv.topLeftCorner(2, 2) - Hff_inv).isZero(1e-9));
+}
+
 void register_unit_tests() {
   framework::master_test_suite().add(
       BOOST_TEST_CASE(boost::bind(&test_constructor)));
@@ -154,6 +243,10 @@ void register_unit_tests() {
       BOOST_TEST_CASE(boost::bind(&test_unconstrained_qp)));
   framework::master_test_suite().add(
       BOOST_TEST_CASE(boost::bind(&test_box_qp_with_identity_hessian)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_warm_started_box_qp)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_single_index_factor_update)));
 }
 
 bool init_function() {
@@ -18,6 +18,10 @@
 #include "crocoddyl/core/activations/quadratic-barrier.hpp"
 #include "crocoddyl/core/activations/weighted-quadratic-barrier.hpp"
 #include "crocoddyl/core/codegen/action-base.hpp"
+#include "crocoddyl/core/codegen/builder.hpp"
+#include "crocoddyl/core/codegen/horizon.hpp"
+#include "crocoddyl/core/constraints/constraint-manager.hpp"
+#include "crocoddyl/core/constraints/residual.hpp"
 #include "crocoddyl/core/costs/cost-sum.hpp"
 #include "crocoddyl/core/costs/residual.hpp"
 #include "crocoddyl/core/integrator/euler.hpp"
@@ -83,7 +87,7 @@ void change_env(
 
 template <typename Scalar>
 const std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> >
-build_arm_action_model() {
+build_arm_action_model(const bool with_constraints = false) {
   typedef typename crocoddyl::MathBaseTpl<Scalar>::VectorXs VectorXs;
   typedef typename crocoddyl::MathBaseTpl<Scalar>::Vector3s Vector3s;
   typedef typename crocoddyl::MathBaseTpl<Scalar>::Matrix3s Matrix3s;
@@ -101,6 +105,10 @@ build_arm_action_model() {
   typedef typename crocoddyl::ResidualModelControlTpl<Scalar>
       ResidualModelControl;
   typedef typename crocoddyl::CostModelSumTpl<Scalar> CostModelSum;
+  typedef typename crocoddyl::ConstraintModelResidualTpl<Scalar>
+      ConstraintModelResidual;
+  typedef typename crocoddyl::ConstraintModelManagerTpl<Scalar>
+      ConstraintModelManager;
   typedef typename crocoddyl::ActionModelAbstractTpl<Scalar>
       ActionModelAbstract;
   typedef typename crocoddyl::ActuationModelFullTpl<Scalar> ActuationModelFull;
@@ -214,12 +222,35 @@ build_arm_action_model() {
   std::shared_ptr<ActuationModelFull> actuation =
       std::make_shared<ActuationModelFull>(state);
 
+  // Optionally, we define an equality constraint on the gripper translation
+  // and an inequality constraint on the state
+  std::shared_ptr<ConstraintModelManager> runningConstraints;
+  if (with_constraints) {
+    runningConstraints =
+        std::make_shared<ConstraintModelManager>(state, actuation->get_nu());
+    runningConstraints->addConstraint(
+        "gripperTrans",
+        std::make_shared<ConstraintModelResidual>(
+            state,
+            std::make_shared<ResidualModelFrameTranslation>(
+                state, model.getFrameId("gripper_left_joint"),
+                Vector3s(Scalar(0), Scalar(0), Scalar(.4)),
+                actuation->get_nu()),
+            false));
+    runningConstraints->addConstraint(
+        "stateBounds",
+        std::make_shared<ConstraintModelResidual>(
+            state,
+            std::make_shared<ResidualModelState>(state, actuation->get_nu()),
+            xlb, xub, false));
+  }
+
   // Next, we need to create an action model for running and terminal knots. The
   // forward dynamics (computed using ABA) are implemented
   // inside DifferentialActionModelFullyActuated.
   std::shared_ptr<DifferentialActionModelFreeFwdDynamics> runningDAM =
       std::make_shared<DifferentialActionModelFreeFwdDynamics>(
-          state, actuation, runningCostModel);
+          state, actuation, runningCostModel, runningConstraints);
 
   // VectorXs armature(state->get_nq());
   // armature << 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.;
@@ -443,6 +474,217 @@ void test_codegen_4DoFArm() {
   BOOST_CHECK(runningDataCG->Luu.isApprox(runningDataD->Luu));
   BOOST_CHECK(runningDataCG->Fx.isApprox(runningDataD->Fx));
   BOOST_CHECK(runningDataCG->Fu.isApprox(runningDataD->Fu));
+
+  // The constant derivatives (e.g., the identity block of Fx) are not generated
+  BOOST_CHECK(rmcg->get_calcDiff_indexes().size() <
+              static_cast<std::size_t>(rmcg->getCalcDiffOutputDimension()));
+}
+
+void test_codegen_4DoFArm_constraints() {
+  typedef double Scalar;
+  typedef CppAD::cg::CG<Scalar> CGScalar;
+  typedef CppAD::AD<CGScalar> ADScalar;
+  typedef typename crocoddyl::MathBaseTpl<Scalar>::VectorXs VectorXs;
+
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> > runningModelD =
+      build_arm_action_model<Scalar>(true);
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<ADScalar> > runningModelAD =
+      build_arm_action_model<ADScalar>(true);
+
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> > runningModelCG =
+      std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+          runningModelAD, runningModelD, "pyrene_arm_constrained_running");
+
+  // Check that code-generated constraints are the same as original.
+  /**************************************************************************/
+  BOOST_CHECK_EQUAL(runningModelCG->get_ng(), runningModelD->get_ng());
+  BOOST_CHECK_EQUAL(runningModelCG->get_nh(), runningModelD->get_nh());
+  BOOST_CHECK(runningModelCG->get_g_lb().isApprox(runningModelD->get_g_lb()));
+  BOOST_CHECK(runningModelCG->get_g_ub().isApprox(runningModelD->get_g_ub()));
+
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > runningDataCG =
+      runningModelCG->createData();
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > runningDataD =
+      runningModelD->createData();
+  VectorXs x_rand = runningModelCG->get_state()->rand();
+  VectorXs u_rand = VectorXs::Random(runningModelCG->get_nu());
+  runningModelD->calc(runningDataD, x_rand, u_rand);
+  runningModelD->calcDiff(runningDataD, x_rand, u_rand);
+  runningModelCG->calc(runningDataCG, x_rand, u_rand);
+  runningModelCG->calcDiff(runningDataCG, x_rand, u_rand);
+
+  BOOST_CHECK(runningDataCG->xnext.isApprox(runningDataD->xnext));
+  BOOST_CHECK_CLOSE(runningDataCG->cost, runningDataD->cost, Scalar(1e-10));
+  BOOST_CHECK(runningDataCG->g.isApprox(runningDataD->g));
+  BOOST_CHECK(runningDataCG->h.isApprox(runningDataD->h));
+  BOOST_CHECK(runningDataCG->Gx.isApprox(runningDataD->Gx));
+  BOOST_CHECK(runningDataCG->Gu.isApprox(runningDataD->Gu));
+  BOOST_CHECK(runningDataCG->Hx.isApprox(runningDataD->Hx));
+  BOOST_CHECK(runningDataCG->Hu.isApprox(runningDataD->Hu));
+  BOOST_CHECK(runningDataCG->Fx.isApprox(runningDataD->Fx));
+  BOOST_CHECK(runningDataCG->Fu.isApprox(runningDataD->Fu));
+  BOOST_CHECK(runningDataCG->Lx.isApprox(runningDataD->Lx));
+  BOOST_CHECK(runningDataCG->Lu.isApprox(runningDataD->Lu));
+}
+
+void test_codegen_cache() {
+  typedef double Scalar;
+  typedef CppAD::cg::CG<Scalar> CGScalar;
+  typedef CppAD::AD<CGScalar> ADScalar;
+  typedef typename crocoddyl::MathBaseTpl<Scalar>::VectorXs VectorXs;
+
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> > runningModelD =
+      build_arm_action_model<Scalar>();
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> >
+      runningModelConsD = build_arm_action_model<Scalar>(true);
+
+  // The libraries are cached by content, so an unchanged model reuses its
+  // library, while a different model gets a new one
+  std::shared_ptr<crocoddyl::ActionModelCodeGenTpl<Scalar> > runningModelCG =
+      std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+          build_arm_action_model<ADScalar>(), runningModelD,
+          "pyrene_arm_running", 0,
+          crocoddyl::ActionModelCodeGenTpl<Scalar>::empty_record_env, "calc",
+          "calcDiff", "codegen_cache");
+  BOOST_CHECK(runningModelCG->existLib());
+  std::shared_ptr<crocoddyl::ActionModelCodeGenTpl<Scalar> > runningModelCG2 =
+      std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+          build_arm_action_model<ADScalar>(), runningModelD,
+          "pyrene_arm_running", 0,
+          crocoddyl::ActionModelCodeGenTpl<Scalar>::empty_record_env, "calc",
+          "calcDiff", "codegen_cache");
+  BOOST_CHECK_EQUAL(runningModelCG->getLibraryPath(),
+                    runningModelCG2->getLibraryPath());
+  std::shared_ptr<crocoddyl::ActionModelCodeGenTpl<Scalar> >
+      runningModelConsCG =
+          std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+              build_arm_action_model<ADScalar>(true), runningModelConsD,
+              "pyrene_arm_running", 0,
+              crocoddyl::ActionModelCodeGenTpl<Scalar>::empty_record_env,
+              "calc", "calcDiff", "codegen_cache");
+  BOOST_CHECK(runningModelCG->getLibraryPath() !=
+              runningModelConsCG->getLibraryPath());
+
+  // The cached library computes the same derivatives
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > runningDataCG =
+      runningModelCG2->createData();
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > runningDataD =
+      runningModelD->createData();
+  VectorXs x_rand = runningModelCG2->get_state()->rand();
+  VectorXs u_rand = VectorXs::Random(runningModelCG2->get_nu());
+  runningModelD->calc(runningDataD, x_rand, u_rand);
+  runningModelD->calcDiff(runningDataD, x_rand, u_rand);
+  runningModelCG2->calc(runningDataCG, x_rand, u_rand);
+  runningModelCG2->calcDiff(runningDataCG, x_rand, u_rand);
+  BOOST_CHECK(runningDataCG->xnext.isApprox(runningDataD->xnext));
+  BOOST_CHECK(runningDataCG->Fx.isApprox(runningDataD->Fx));
+  BOOST_CHECK(runningDataCG->Lxx.isApprox(runningDataD->Lxx));
+}
+
+void test_codegen_builder() {
+  typedef double Scalar;
+  typedef CppAD::cg::CG<Scalar> CGScalar;
+  typedef CppAD::AD<CGScalar> ADScalar;
+  typedef typename crocoddyl::MathBaseTpl<Scalar>::VectorXs VectorXs;
+
+  std::vector<std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> > >
+      modelsD;
+  modelsD.push_back(build_arm_action_model<Scalar>());
+  modelsD.push_back(build_arm_action_model<Scalar>(true));
+
+  // The libraries are compiled in parallel and then loaded by the builder
+  crocoddyl::CodeGenBuilderTpl<Scalar> builder(2);
+  for (std::size_t i = 0; i < modelsD.size(); ++i) {
+    builder.add(std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+        build_arm_action_model<ADScalar>(i == 1), modelsD[i],
+        "pyrene_arm_builder", 0,
+        crocoddyl::ActionModelCodeGenTpl<Scalar>::empty_record_env, "calc",
+        "calcDiff", "codegen_builder", false));
+  }
+  builder.build();
+
+  for (std::size_t i = 0; i < modelsD.size(); ++i) {
+    const std::shared_ptr<crocoddyl::ActionModelCodeGenTpl<Scalar> >& modelCG =
+        builder.get_models()[i];
+    BOOST_CHECK(modelCG->existLib());
+    std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > dataCG =
+        modelCG->createData();
+    std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > dataD =
+        modelsD[i]->createData();
+    VectorXs x_rand = modelCG->get_state()->rand();
+    VectorXs u_rand = VectorXs::Random(modelCG->get_nu());
+    modelsD[i]->calc(dataD, x_rand, u_rand);
+    modelsD[i]->calcDiff(dataD, x_rand, u_rand);
+    modelCG->calc(dataCG, x_rand, u_rand);
+    modelCG->calcDiff(dataCG, x_rand, u_rand);
+    BOOST_CHECK(dataCG->xnext.isApprox(dataD->xnext));
+    BOOST_CHECK(dataCG->Fx.isApprox(dataD->Fx));
+    BOOST_CHECK(dataCG->Lxx.isApprox(dataD->Lxx));
+    BOOST_CHECK(dataCG->g.isApprox(dataD->g));
+  }
+}
+
+void test_codegen_horizon() {
+  typedef double Scalar;
+  typedef CppAD::cg::CG<Scalar> CGScalar;
+  typedef CppAD::AD<CGScalar> ADScalar;
+  typedef typename crocoddyl::MathBaseTpl<Scalar>::VectorXs VectorXs;
+
+  std::shared_ptr<crocoddyl::ActionModelAbstractTpl<Scalar> > runningModelD =
+      build_arm_action_model<Scalar>(true);
+  std::shared_ptr<crocoddyl::ActionModelCodeGenTpl<Scalar> > runningModelCG =
+      std::make_shared<crocoddyl::ActionModelCodeGenTpl<Scalar> >(
+          build_arm_action_model<ADScalar>(true), runningModelD,
+          "pyrene_arm_horizon");
+
+  // The kernel evaluates all the nodes at once
+  const std::size_t T = 5;
+  crocoddyl::HorizonCodeGenTpl<Scalar> horizon(runningModelCG, T, 2);
+  std::vector<VectorXs> xs(T), us(T);
+  for (std::size_t t = 0; t < T; ++t) {
+    xs[t] = runningModelCG->get_state()->rand();
+    us[t] = VectorXs::Random(runningModelCG->get_nu());
+  }
+  horizon.calc(xs, us);
+  horizon.calcDiff(xs, us);
+
+  // It matches the node-wise evaluation
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > dataH =
+      runningModelCG->createData();
+  std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > dataCG =
+      runningModelCG->createData();
+  for (std::size_t t = 0; t < T; ++t) {
+    horizon.distribute(t, dataH);
+    runningModelCG->calc(dataCG, xs[t], us[t]);
+    runningModelCG->calcDiff(dataCG, xs[t], us[t]);
+    BOOST_CHECK_EQUAL(dataH->cost, dataCG->cost);
+    BOOST_CHECK(dataH->xnext == dataCG->xnext);
+    BOOST_CHECK(dataH->g == dataCG->g);
+    BOOST_CHECK(dataH->Fx == dataCG->Fx);
+    BOOST_CHECK(dataH->Fu == dataCG->Fu);
+    BOOST_CHECK(dataH->Lx == dataCG->Lx);
+    BOOST_CHECK(dataH->Lu == dataCG->Lu);
+    BOOST_CHECK(dataH->Lxx == dataCG->Lxx);
+    BOOST_CHECK(dataH->Lxu == dataCG->Lxu);
+    BOOST_CHECK(dataH->Luu == dataCG->Luu);
+    BOOST_CHECK(dataH->Gx == dataCG->Gx);
+    BOOST_CHECK(dataH->Gu == dataCG->Gu);
+  }
+
+  // It distributes the outputs of all the nodes at once
+  std::vector<std::shared_ptr<crocoddyl::ActionDataAbstractTpl<Scalar> > >
+      datas(T);
+  for (std::size_t t = 0; t < T; ++t) {
+    datas[t] = runningModelCG->createData();
+  }
+  horizon.distribute(datas);
+  BOOST_CHECK(datas[T - 1]->xnext == dataCG->xnext);
+  BOOST_CHECK(datas[T - 1]->Fx == dataCG->Fx);
+  BOOST_CHECK(datas[T - 1]->Luu == dataCG->Luu);
+
+  // It checks the dimension of each node input
+  us[0] = VectorXs::Zero(runningModelCG->get_nu() + 1);
+  BOOST_CHECK_THROW(horizon.set_xus(xs, us), crocoddyl::Exception);
 }
 
 void test_codegen_bipedal() {
@@ -487,6 +729,10 @@ bool init_function() {
   const std::string test_name = "test_codegen";
   test_suite* ts = BOOST_TEST_SUITE(test_name);
   ts->add(BOOST_TEST_CASE(&test_codegen_4DoFArm));
+  ts->add(BOOST_TEST_CASE(&test_codegen_4DoFArm_constraints));
+  ts->add(BOOST_TEST_CASE(&test_codegen_cache));
+  ts->add(BOOST_TEST_CASE(&test_codegen_builder));
+  ts->add(BOOST_TEST_CASE(&test_codegen_horizon));
   ts->add(BOOST_TEST_CASE(&test_codegen_bipedal));
   framework::master_test_suite().add(ts);
 
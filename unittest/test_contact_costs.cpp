@@ -66,6 +66,57 @@ void test_partial_derivatives_against_contact_numdiff(
   }
 }
 
+void test_lazy_kinematics(ContactCostModelTypes::Type cost_type,
+                          PinocchioModelTypes::Type model_type,
+                          ActivationModelTypes::Type activation_type,
+                          ActuationModelTypes::Type actuation_type) {
+  // create the model
+  const std::shared_ptr<crocoddyl::DifferentialActionModelContactFwdDynamics>&
+      model = std::static_pointer_cast<
+          crocoddyl::DifferentialActionModelContactFwdDynamics>(
+          ContactCostModelFactory().create(cost_type, model_type,
+                                           activation_type, actuation_type));
+
+  // create the data objects used with and without lazy kinematics
+  const std::shared_ptr<crocoddyl::DifferentialActionDataAbstract>& data =
+      model->createData();
+  const std::shared_ptr<crocoddyl::DifferentialActionDataAbstract>&
+      data_lazy = model->createData();
+
+  // Generating random values for the state and control
+  Eigen::VectorXd x = model->get_state()->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model->get_nu());
+
+  // Computing the action derivatives
+  model->set_lazy_kinematics(false);
+  model->calc(data, x, u);
+  model->calcDiff(data, x, u);
+  model->set_lazy_kinematics(true);
+  model->calc(data_lazy, x, u);
+  BOOST_CHECK((data->xout - data_lazy->xout).isZero(1e-9));
+  BOOST_CHECK(std::abs(data->cost - data_lazy->cost) < 1e-9);
+  model->calcDiff(data_lazy, x, u);
+  BOOST_CHECK((data->Fx - data_lazy->Fx).isZero(1e-9));
+  BOOST_CHECK((data->Fu - data_lazy->Fu).isZero(1e-9));
+  BOOST_CHECK((data->Lx - data_lazy->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lu - data_lazy->Lu).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_lazy->Lxx).isZero(1e-9));
+  BOOST_CHECK((data->Lxu - data_lazy->Lxu).isZero(1e-9));
+  BOOST_CHECK((data->Luu - data_lazy->Luu).isZero(1e-9));
+
+  // Computing the action derivatives
+  x = model->get_state()->rand();
+  model->set_lazy_kinematics(false);
+  model->calc(data, x);
+  model->calcDiff(data, x);
+  model->set_lazy_kinematics(true);
+  model->calc(data_lazy, x);
+  BOOST_CHECK(std::abs(data->cost - data_lazy->cost) < 1e-9);
+  model->calcDiff(data_lazy, x);
+  BOOST_CHECK((data->Lx - data_lazy->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_lazy->Lxx).isZero(1e-9));
+}
+
 //----------------------------------------------------------------------------//
 
 void register_contact_cost_model_unit_tests(
@@ -80,6 +131,9 @@ void register_contact_cost_model_unit_tests(
   ts->add(BOOST_TEST_CASE(
       boost::bind(&test_partial_derivatives_against_contact_numdiff, cost_type,
                   model_type, activation_type, actuation_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_lazy_kinematics, cost_type,
+                                      model_type, activation_type,
+                                      actuation_type)));
   framework::master_test_suite().add(ts);
 }
 
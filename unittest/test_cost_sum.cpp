@@ -399,6 +399,59 @@ void test_get_nr(StateModelTypes::Type state_type) {
   BOOST_CHECK(nr == model.get_nr());
 }
 
+void test_get_cost_items(StateModelTypes::Type state_type) {
+  // setup the test
+  StateModelFactory state_factory;
+  crocoddyl::CostModelSum model(state_factory.create(state_type));
+  const std::shared_ptr<crocoddyl::StateMultibody>& state =
+      std::static_pointer_cast<crocoddyl::StateMultibody>(model.get_state());
+  pinocchio::Model& pinocchio_model = *state->get_pinocchio().get();
+  pinocchio::Data pinocchio_data(pinocchio_model);
+  crocoddyl::DataCollectorMultibody shared_data(&pinocchio_data);
+
+  // create and add some cost objects in reverse order
+  for (unsigned i = 0; i < 5; ++i) {
+    std::ostringstream os;
+    os << "random_cost_" << 4 - i;
+    model.addCost(os.str(), create_random_cost(state_type), 1., i % 2 == 0);
+  }
+  model.removeCost("random_cost_2");
+  model.changeCostStatus("random_cost_1", true);
+  model.changeCostStatus("random_cost_0", false);
+  const std::shared_ptr<crocoddyl::CostDataSum>& data =
+      model.createData(&shared_data);
+
+  // check that the items and their datas follow the order of the map
+  const crocoddyl::CostModelSum::CostItemVector& items =
+      model.get_cost_items();
+  BOOST_CHECK(items.size() == model.get_costs().size());
+  BOOST_CHECK(data->cost_datas.size() == model.get_costs().size());
+  std::size_t i = 0;
+  crocoddyl::CostModelSum::CostModelContainer::const_iterator it_m, end_m;
+  for (it_m = model.get_costs().begin(), end_m = model.get_costs().end();
+       it_m != end_m; ++it_m, ++i) {
+    BOOST_CHECK(items[i] == it_m->second);
+    BOOST_CHECK(data->cost_datas[i] == data->costs.find(it_m->first)->second);
+  }
+
+  // check that the status of the items is read in each call, i.e., an item
+  // deactivated through get_costs() is skipped too
+  const Eigen::VectorXd x = state->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model.get_nu());
+  crocoddyl::unittest::updateAllPinocchio(&pinocchio_model, &pinocchio_data,
+                                          x);
+  model.get_costs().find("random_cost_1")->second->active = false;
+  model.calc(data, x, u);
+  double cost = 0.;
+  for (i = 0; i < items.size(); ++i) {
+    if (items[i]->active) {
+      items[i]->cost->calc(data->cost_datas[i], x, u);
+      cost += items[i]->weight * data->cost_datas[i]->cost;
+    }
+  }
+  BOOST_CHECK_CLOSE(data->cost, cost, 1e-9);
+}
+
 void test_shareMemory(StateModelTypes::Type state_type) {
   // setup the test
   StateModelFactory state_factory;
@@ -449,6 +502,7 @@ void register_unit_tests(StateModelTypes::Type state_type) {
   ts->add(BOOST_TEST_CASE(boost::bind(&test_calcDiff, state_type)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_get_costs, state_type)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_get_nr, state_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_get_cost_items, state_type)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_shareMemory, state_type)));
   framework::master_test_suite().add(ts);
 }
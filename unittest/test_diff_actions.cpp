@@ -77,6 +77,71 @@ void test_calc_returns_a_cost(DifferentialActionModelTypes::Type action_type) {
   BOOST_CHECK(!std::isnan(data->cost));
 }
 
+void test_calc_at_same_point(DifferentialActionModelTypes::Type action_type) {
+  // create the model
+  DifferentialActionModelFactory factory;
+  std::shared_ptr<crocoddyl::DifferentialActionModelAbstract> model =
+      factory.create(action_type);
+
+  // create the corresponding data objects
+  std::shared_ptr<crocoddyl::DifferentialActionDataAbstract> data =
+      model->createData();
+  std::shared_ptr<crocoddyl::DifferentialActionDataAbstract> data_ref =
+      model->createData();
+
+  // Generating random state and control vectors
+  const Eigen::VectorXd x = model->get_state()->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model->get_nu());
+
+  // Checking that evaluating twice the same point gives the same results
+  model->calc(data_ref, x, u);
+  model->calcDiff(data_ref, x, u);
+  model->calc(data, x, u);
+  model->calc(data, x, u);
+  BOOST_CHECK((data->xout - data_ref->xout).isZero(1e-9));
+  BOOST_CHECK(std::abs(data->cost - data_ref->cost) < 1e-9);
+  model->calcDiff(data, x, u);
+  BOOST_CHECK((data->Fx - data_ref->Fx).isZero(1e-9));
+  BOOST_CHECK((data->Fu - data_ref->Fu).isZero(1e-9));
+  BOOST_CHECK((data->Lx - data_ref->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lu - data_ref->Lu).isZero(1e-9));
+
+  // Checking that a new armature is considered at the same point
+  std::shared_ptr<crocoddyl::DifferentialActionModelFreeFwdDynamics>
+      model_free = std::dynamic_pointer_cast<
+          crocoddyl::DifferentialActionModelFreeFwdDynamics>(model);
+  if (model_free) {
+    // Checking that the second evaluation reuses the stored dynamics, i.e.,
+    // it keeps the generation and does not overwrite the acceleration
+    std::shared_ptr<crocoddyl::DifferentialActionDataFreeFwdDynamics>
+        data_free = std::dynamic_pointer_cast<
+            crocoddyl::DifferentialActionDataFreeFwdDynamics>(data);
+    model->calc(data, x, u);
+    const std::size_t generation = data_free->generation;
+    BOOST_CHECK(generation != 0);
+    const Eigen::VectorXd xout_mark =
+        Eigen::VectorXd::Constant(model->get_state()->get_nv(), 1e3);
+    data->xout = xout_mark;
+    model->calc(data, x, u);
+    BOOST_CHECK(data_free->generation == generation);
+    BOOST_CHECK(data->xout == xout_mark);
+
+    // Checking that calcDiff invalidates the stored dynamics
+    model->calcDiff(data, x, u);
+    BOOST_CHECK(data_free->generation == 0);
+    model->calc(data, x, u);
+    BOOST_CHECK((data->xout - data_ref->xout).isZero(1e-9));
+
+    model_free->set_armature(
+        Eigen::VectorXd::Ones(model->get_state()->get_nv()));
+    data_ref = model->createData();
+    model->calc(data, x, u);
+    model->calc(data_ref, x, u);
+    BOOST_CHECK((data->xout - data_ref->xout).isZero(1e-9));
+    BOOST_CHECK(std::abs(data->cost - data_ref->cost) < 1e-9);
+  }
+}
+
 void test_quasi_static(DifferentialActionModelTypes::Type action_type) {
   if (action_type ==
       DifferentialActionModelTypes::
@@ -192,6 +257,61 @@ void test_partial_derivatives_against_numdiff(
   BOOST_CHECK((data->Gx - data_num_diff->Gx).isZero(tol));
 }
 
+void test_numdiff_multithreading(
+    DifferentialActionModelTypes::Type action_type, const bool work_stealing) {
+  // create the model
+  DifferentialActionModelFactory factory;
+  std::shared_ptr<crocoddyl::DifferentialActionModelAbstract> model =
+      factory.create(action_type);
+
+  // create the serial and parallel numdiff models and datas
+  crocoddyl::DifferentialActionModelNumDiff model_num_diff(model);
+  crocoddyl::DifferentialActionModelNumDiff model_num_diff_mt(model);
+  // the work-stealing executor runs in parallel without OpenMP support
+  if (work_stealing) {
+    model_num_diff_mt.set_executor(
+        std::make_shared<crocoddyl::ExecutorWorkStealing>(4));
+  }
+  model_num_diff_mt.set_nthreads(4);
+  BOOST_CHECK(model_num_diff_mt.get_nthreads() == 4);
+  std::shared_ptr<crocoddyl::DifferentialActionDataAbstract> data =
+      model_num_diff.createData();
+  std::shared_ptr<crocoddyl::DifferentialActionDataAbstract> data_mt =
+      model_num_diff_mt.createData();
+
+  // Generating random values for the state and control
+  Eigen::VectorXd x = model->get_state()->rand();
+  const Eigen::VectorXd u = Eigen::VectorXd::Random(model->get_nu());
+
+  // Checking that both models compute the same derivatives
+  model_num_diff.calc(data, x, u);
+  model_num_diff.calcDiff(data, x, u);
+  model_num_diff_mt.calc(data_mt, x, u);
+  model_num_diff_mt.calcDiff(data_mt, x, u);
+  BOOST_CHECK((data->Fx - data_mt->Fx).isZero(1e-9));
+  BOOST_CHECK((data->Fu - data_mt->Fu).isZero(1e-9));
+  BOOST_CHECK((data->Lx - data_mt->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lu - data_mt->Lu).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_mt->Lxx).isZero(1e-9));
+  BOOST_CHECK((data->Lxu - data_mt->Lxu).isZero(1e-9));
+  BOOST_CHECK((data->Luu - data_mt->Luu).isZero(1e-9));
+  BOOST_CHECK((data->Gx - data_mt->Gx).isZero(1e-9));
+  BOOST_CHECK((data->Gu - data_mt->Gu).isZero(1e-9));
+  BOOST_CHECK((data->Hx - data_mt->Hx).isZero(1e-9));
+  BOOST_CHECK((data->Hu - data_mt->Hu).isZero(1e-9));
+
+  // Checking the terminal derivatives
+  x = model->get_state()->rand();
+  model_num_diff.calc(data, x);
+  model_num_diff.calcDiff(data, x);
+  model_num_diff_mt.calc(data_mt, x);
+  model_num_diff_mt.calcDiff(data_mt, x);
+  BOOST_CHECK((data->Lx - data_mt->Lx).isZero(1e-9));
+  BOOST_CHECK((data->Lxx - data_mt->Lxx).isZero(1e-9));
+  BOOST_CHECK((data->Gx - data_mt->Gx).isZero(1e-9));
+  BOOST_CHECK((data->Hx - data_mt->Hx).isZero(1e-9));
+}
+
 //----------------------------------------------------------------------------//
 
 void register_action_model_unit_tests(
@@ -205,7 +325,14 @@ void register_action_model_unit_tests(
   ts->add(BOOST_TEST_CASE(boost::bind(&test_calc_returns_a_cost, action_type)));
   ts->add(BOOST_TEST_CASE(
       boost::bind(&test_partial_derivatives_against_numdiff, action_type)));
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_numdiff_multithreading, action_type, false)));
+#endif  // CROCODDYL_WITH_MULTITHREADING
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_numdiff_multithreading, action_type, true)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_quasi_static, action_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_calc_at_same_point, action_type)));
   framework::master_test_suite().add(ts);
 }
 
@@ -11,6 +11,7 @@
 
 #include "crocoddyl/core/integrator/euler.hpp"
 #include "crocoddyl/core/optctrl/shooting.hpp"
+#include "allocation_counter.hpp"
 #include "factory/action.hpp"
 #include "factory/diff_action.hpp"
 #include "factory/integrator.hpp"
@@ -434,6 +435,269 @@ void test_quasiStatic_diffAction(
   }
 }
 
+void test_executor(ActionModelTypes::Type action_model_type) {
+  // create the model
+  ActionModelFactory factory;
+  const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+      factory.create(action_model_type);
+
+  // create two shooting problems (with OpenMP and work-stealing executors)
+  std::size_t T = 20;
+  const Eigen::VectorXd& x0 = model->get_state()->rand();
+  std::vector<std::shared_ptr<crocoddyl::ActionModelAbstract> > models(T,
+                                                                       model);
+  crocoddyl::ShootingProblem problem1(x0, models, model);
+  crocoddyl::ShootingProblem problem2(x0, models, model);
+  problem2.set_executor(
+      std::make_shared<crocoddyl::ExecutorWorkStealing>(3, 2));
+  problem1.set_balance_nodes(true);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  problem1.set_nthreads(3);
+#endif
+  // the work-stealing executor runs in parallel without OpenMP support
+  problem2.set_nthreads(3);
+  BOOST_CHECK_EQUAL(problem2.get_nthreads(), 3);
+
+  // create random trajectory
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T);
+  for (std::size_t i = 0; i < T; ++i) {
+    xs[i] = model->get_state()->rand();
+    us[i] = Eigen::VectorXd::Random(model->get_nu());
+  }
+  xs.back() = model->get_state()->rand();
+
+  // check that both executors compute the same nodes (the second call of the
+  // first problem uses the measured timings to balance its nodes)
+  problem1.calc(xs, us);
+  problem1.calcDiff(xs, us);
+  BOOST_CHECK(problem1.calc(xs, us) == problem2.calc(xs, us));
+  problem1.calcDiff(xs, us);
+  problem2.calcDiff(xs, us);
+  BOOST_CHECK(problem1.get_calc_times().size() == T + 1);
+  BOOST_CHECK(problem1.get_calcDiff_times().size() == T + 1);
+  for (std::size_t i = 0; i < T + 1; ++i) {
+    BOOST_CHECK(problem1.get_calc_times()[i] >= 0.);
+    BOOST_CHECK(problem1.get_calcDiff_times()[i] >= 0.);
+  }
+  for (std::size_t i = 0; i < T; ++i) {
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data1 =
+        problem1.get_runningDatas()[i];
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data2 =
+        problem2.get_runningDatas()[i];
+    BOOST_CHECK(data1->cost == data2->cost);
+    BOOST_CHECK((data1->xnext - data2->xnext).isZero(1e-9));
+    BOOST_CHECK((data1->Fx - data2->Fx).isZero(1e-9));
+    BOOST_CHECK((data1->Fu - data2->Fu).isZero(1e-9));
+    BOOST_CHECK((data1->Lx - data2->Lx).isZero(1e-9));
+    BOOST_CHECK((data1->Lu - data2->Lu).isZero(1e-9));
+    BOOST_CHECK((data1->Lxx - data2->Lxx).isZero(1e-9));
+    BOOST_CHECK((data1->Lxu - data2->Lxu).isZero(1e-9));
+    BOOST_CHECK((data1->Luu - data2->Luu).isZero(1e-9));
+  }
+  BOOST_CHECK((problem1.get_terminalData()->Lx -
+               problem2.get_terminalData()->Lx)
+                  .isZero(1e-9));
+  BOOST_CHECK((problem1.get_terminalData()->Lxx -
+               problem2.get_terminalData()->Lxx)
+                  .isZero(1e-9));
+
+  // check that a skewed profile is split into ranges with similar costs,
+  // i.e., {10}, {1, ..., 1} with 9 iterations and {1, ..., 1} with 10
+  // iterations
+  std::vector<double> profile(T, 1.);
+  profile[0] = 10.;
+  const double total = 10. + static_cast<double>(T - 1);
+  BOOST_CHECK_EQUAL(
+      crocoddyl::ExecutorOpenMP::balancedBound(profile, total, 0, 3), 0);
+  BOOST_CHECK_EQUAL(
+      crocoddyl::ExecutorOpenMP::balancedBound(profile, total, 1, 3), 1);
+  BOOST_CHECK_EQUAL(
+      crocoddyl::ExecutorOpenMP::balancedBound(profile, total, 2, 3), 10);
+  BOOST_CHECK_EQUAL(
+      crocoddyl::ExecutorOpenMP::balancedBound(profile, total, 3, 3), T);
+
+  // check that each iteration is computed once with cost-aware chunks, and
+  // that the exceptions are propagated to the caller. The work-stealing pool
+  // runs these loops in parallel even without multithreading support.
+  const std::shared_ptr<crocoddyl::ExecutorAbstract>& executor =
+      problem2.get_executor();
+  BOOST_CHECK_EQUAL(
+      std::static_pointer_cast<crocoddyl::ExecutorWorkStealing>(executor)
+          ->get_nthreads(),
+      3);
+  std::vector<std::size_t> counts(T, 0);
+  std::vector<double> costs(T, 1.);
+  costs[0] = 10.;
+  executor->parallelFor(
+      T, 3, [&](const std::size_t i) { ++counts[i]; }, costs);
+  for (std::size_t i = 0; i < T; ++i) {
+    BOOST_CHECK(counts[i] == 1);
+  }
+  BOOST_CHECK_THROW(executor->parallelFor(T, 3,
+                                          [&](const std::size_t i) {
+                                            if (i == T - 1) {
+                                              throw_pretty("Test exception");
+                                            }
+                                          }),
+                    crocoddyl::Exception);
+
+  // check that the appended node does not inherit the timings of the removed
+  // one
+  const std::vector<double> calc_times = problem1.get_calc_times();
+  const std::vector<double> calcDiff_times = problem1.get_calcDiff_times();
+  problem1.circularAppend(model);
+  for (std::size_t i = 0; i < T - 1; ++i) {
+    BOOST_CHECK(problem1.get_calc_times()[i] == calc_times[i + 1]);
+    BOOST_CHECK(problem1.get_calcDiff_times()[i] == calcDiff_times[i + 1]);
+  }
+  BOOST_CHECK(problem1.get_calc_times()[T - 1] == 0.);
+  BOOST_CHECK(problem1.get_calcDiff_times()[T - 1] == 0.);
+  BOOST_CHECK(problem1.get_calc_times()[T] == calc_times[T]);
+  BOOST_CHECK(problem1.get_calcDiff_times()[T] == calcDiff_times[T]);
+}
+
+void test_arena(ActionModelTypes::Type action_model_type) {
+  // create the model
+  ActionModelFactory factory;
+  const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+      factory.create(action_model_type);
+
+  // check that the data tree is allocated in the enabled arena
+  const std::shared_ptr<crocoddyl::DataArena> arena =
+      std::make_shared<crocoddyl::DataArena>();
+  std::shared_ptr<crocoddyl::ActionDataAbstract> data;
+  {
+    crocoddyl::DataArenaScope scope(arena);
+    data = model->createData();
+  }
+  BOOST_CHECK(arena->get_size() > 0);
+  BOOST_CHECK(arena->get_size() <= arena->get_capacity());
+  BOOST_CHECK(!crocoddyl::DataArena::get_current());
+  BOOST_CHECK(model->checkData(data));
+
+  // create two shooting problems (with and without arenas)
+  std::size_t T = 20;
+  const Eigen::VectorXd& x0 = model->get_state()->rand();
+  std::vector<std::shared_ptr<crocoddyl::ActionModelAbstract> > models(T,
+                                                                       model);
+  crocoddyl::ShootingProblem problem1(x0, models, model);
+  crocoddyl::ShootingProblem problem2(x0, models, model);
+  problem2.set_use_arena(true);
+  BOOST_CHECK(problem2.get_use_arena());
+  problem2.updateModel(0, model);
+  problem2.circularAppend(model);
+
+  // create random trajectory
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T);
+  for (std::size_t i = 0; i < T; ++i) {
+    xs[i] = model->get_state()->rand();
+    us[i] = Eigen::VectorXd::Random(model->get_nu());
+  }
+  xs.back() = model->get_state()->rand();
+
+  // check that both problems compute the same nodes
+  BOOST_CHECK(problem1.calc(xs, us) == problem2.calc(xs, us));
+  problem1.calcDiff(xs, us);
+  problem2.calcDiff(xs, us);
+  for (std::size_t i = 0; i < T; ++i) {
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data1 =
+        problem1.get_runningDatas()[i];
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data2 =
+        problem2.get_runningDatas()[i];
+    BOOST_CHECK(data1->cost == data2->cost);
+    BOOST_CHECK((data1->xnext - data2->xnext).isZero(1e-9));
+    BOOST_CHECK((data1->Fx - data2->Fx).isZero(1e-9));
+    BOOST_CHECK((data1->Fu - data2->Fu).isZero(1e-9));
+    BOOST_CHECK((data1->Lx - data2->Lx).isZero(1e-9));
+    BOOST_CHECK((data1->Lu - data2->Lu).isZero(1e-9));
+    BOOST_CHECK((data1->Lxx - data2->Lxx).isZero(1e-9));
+    BOOST_CHECK((data1->Lxu - data2->Lxu).isZero(1e-9));
+    BOOST_CHECK((data1->Luu - data2->Luu).isZero(1e-9));
+  }
+}
+
+void test_data_pool(ActionModelTypes::Type action_model_type) {
+  // create the models
+  ActionModelFactory factory;
+  const std::shared_ptr<crocoddyl::ActionModelAbstract>& model1 =
+      factory.create(action_model_type);
+  const std::shared_ptr<crocoddyl::ActionModelAbstract>& model2 =
+      factory.create(action_model_type);
+
+  // create a shooting problem with a periodic sequence of models
+  std::size_t T = 20;
+  const Eigen::VectorXd& x0 = model1->get_state()->rand();
+  std::vector<std::shared_ptr<crocoddyl::ActionModelAbstract> > models;
+  for (std::size_t i = 0; i < T; ++i) {
+    models.push_back(i % 2 == 0 ? model1 : model2);
+  }
+  crocoddyl::ShootingProblem problem(x0, models, model1);
+  problem.set_data_pool_size(2);
+  BOOST_CHECK(problem.get_data_pool_size() == 2);
+  problem.reserveDatas(model2, 1);
+  BOOST_CHECK(problem.get_data_pool_ndatas() == 1);
+  BOOST_CHECK_THROW(problem.reserveDatas(model2, 2), crocoddyl::Exception);
+
+  // check that shifting the horizon does not allocate memory
+  std::size_t nallocs;
+  {
+    AllocationCounter counter;
+    for (std::size_t k = 0; k < 2 * T; ++k) {
+      problem.circularAppend(problem.get_runningModels()[0]);
+    }
+    problem.updateModel(0, model2);
+    problem.updateModel(T, model1);
+    nallocs = counter.get_nallocations();
+  }
+  BOOST_CHECK(nallocs == 0);
+
+  // check that each node has its own data
+  const std::vector<std::shared_ptr<crocoddyl::ActionDataAbstract> >& datas =
+      problem.get_runningDatas();
+  for (std::size_t i = 0; i < T; ++i) {
+    BOOST_CHECK(problem.get_runningModels()[i]->checkData(datas[i]));
+    BOOST_CHECK(datas[i] != problem.get_terminalData());
+    for (std::size_t j = i + 1; j < T; ++j) {
+      BOOST_CHECK(datas[i] != datas[j]);
+    }
+  }
+
+  // check that the recycled datas compute the same nodes
+  crocoddyl::ShootingProblem problem2(x0, problem.get_runningModels(),
+                                      problem.get_terminalModel());
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T);
+  for (std::size_t i = 0; i < T; ++i) {
+    xs[i] = model1->get_state()->rand();
+    us[i] = Eigen::VectorXd::Random(problem.get_runningModels()[i]->get_nu());
+  }
+  xs.back() = model1->get_state()->rand();
+  BOOST_CHECK(problem.calc(xs, us) == problem2.calc(xs, us));
+  problem.calcDiff(xs, us);
+  problem2.calcDiff(xs, us);
+  for (std::size_t i = 0; i < T; ++i) {
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data1 = datas[i];
+    const std::shared_ptr<crocoddyl::ActionDataAbstract>& data2 =
+        problem2.get_runningDatas()[i];
+    BOOST_CHECK((data1->xnext - data2->xnext).isZero(1e-9));
+    BOOST_CHECK((data1->Fx - data2->Fx).isZero(1e-9));
+    BOOST_CHECK((data1->Lx - data2->Lx).isZero(1e-9));
+    BOOST_CHECK((data1->Lxx - data2->Lxx).isZero(1e-9));
+  }
+
+  // check that the datas referenced elsewhere are not recycled
+  problem.set_data_pool_size(0);
+  BOOST_CHECK(problem.get_data_pool_ndatas() == 0);
+  problem.set_data_pool_size(1);
+  std::shared_ptr<crocoddyl::ActionDataAbstract> data = datas[0];
+  problem.updateNode(0, model1, model1->createData());
+  BOOST_CHECK(problem.get_data_pool_ndatas() == 0);
+  problem.updateNode(1, model1, model1->createData());
+  BOOST_CHECK(problem.get_data_pool_ndatas() == 1);
+}
+
 //----------------------------------------------------------------------------//
 
 void register_action_model_unit_tests(
@@ -446,6 +710,9 @@ void register_action_model_unit_tests(
   ts->add(BOOST_TEST_CASE(boost::bind(&test_calcDiff, action_model_type)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_quasiStatic, action_model_type)));
   ts->add(BOOST_TEST_CASE(boost::bind(&test_rollout, action_model_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_executor, action_model_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_arena, action_model_type)));
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_data_pool, action_model_type)));
   framework::master_test_suite().add(ts);
 }
 
@@ -188,6 +188,17 @@ void test_partial_derivatives_against_numdiff(
   BOOST_CHECK((data->Rx - data_num_diff->Rx).isZero(tol));
   BOOST_CHECK((data->Ru - data_num_diff->Ru).isZero(tol));
 
+  // Checking that the Jacobian is zero outside the declared blocks
+  const crocoddyl::ResidualModelAbstract::JacobianBlocks& blocks =
+      model->get_Rx_blocks();
+  Eigen::MatrixXd Rx_blocks = Eigen::MatrixXd::Zero(data->Rx.rows(),
+                                                    data->Rx.cols());
+  for (std::size_t k = 0; k < blocks.size(); ++k) {
+    Rx_blocks.middleCols(blocks[k].first, blocks[k].second) =
+        data_num_diff->Rx.middleCols(blocks[k].first, blocks[k].second);
+  }
+  BOOST_CHECK((data_num_diff->Rx - Rx_blocks).isZero(tol));
+
   // Computing the residual derivatives
   x = model->get_state()->rand();
   crocoddyl::unittest::updateAllPinocchio(&pinocchio_model, &pinocchio_data, x);
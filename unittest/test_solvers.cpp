@@ -11,6 +11,14 @@
 #define BOOST_TEST_NO_MAIN
 #define BOOST_TEST_ALTERNATIVE_INIT_API
 
+#include "crocoddyl/core/solvers/batch.hpp"
+#include "crocoddyl/core/actions/lqr.hpp"
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/solvers/intro.hpp"
+#ifdef CROCODDYL_WITH_IPOPT
+#include "crocoddyl/core/solvers/ipopt.hpp"
+#endif
+#include "allocation_counter.hpp"
 #include "crocoddyl/core/utils/callbacks.hpp"
 #include "factory/solver.hpp"
 #include "unittest_common.hpp"
@@ -101,6 +109,59 @@ void test_kkt_search_direction(ActionModelTypes::Type action_type, size_t T) {
 
 //____________________________________________________________________________//
 
+void test_kkt_regularized_direction(ActionModelTypes::Type action_type,
+                                    size_t T) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the kkt solver
+  SolverFactory factory;
+  std::shared_ptr<crocoddyl::SolverKKT> kkt =
+      std::static_pointer_cast<crocoddyl::SolverKKT>(
+          factory.create(SolverTypes::SolverKKT, model, model2, modelT, T));
+
+  // Generate the different state along the trajectory
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      kkt->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t i = 0; i < T; ++i) {
+    xs.push_back(state->rand());
+    us.push_back(
+        Eigen::VectorXd::Random(problem->get_runningModels()[i]->get_nu()));
+  }
+  xs.push_back(state->rand());
+  kkt->setCandidate(xs, us);
+  kkt->computeDirection();
+
+  // Checking that the regularized refactorizations (without recomputing the
+  // derivatives) match the dense solution of the regularized KKT system. The
+  // dual regularization has to be considered even without primal one
+  const std::size_t ndx = kkt->get_ndx();
+  const std::size_t nu = kkt->get_nu();
+  const double pregs[] = {1e-3, 0.};
+  for (std::size_t k = 0; k < 2; ++k) {
+    kkt->set_preg(pregs[k]);
+    kkt->set_dreg(1e-3);
+    kkt->computeDirection(false);
+    Eigen::MatrixXd kkt_reg = kkt->get_kkt();
+    kkt_reg.diagonal().head(ndx + nu).array() += pregs[k];
+    kkt_reg.diagonal().tail(ndx).array() -= 1e-3;
+    const Eigen::VectorXd primaldual =
+        kkt_reg.partialPivLu().solve(-kkt->get_kktref());
+    BOOST_CHECK((kkt->get_primaldual() - primaldual).isZero(1e-6));
+  }
+}
+
+//____________________________________________________________________________//
+
 void test_solver_against_kkt_solver(SolverTypes::Type solver_type,
                                     ActionModelTypes::Type action_type,
                                     size_t T) {
@@ -173,17 +234,581 @@ void test_solver_against_kkt_solver(SolverTypes::Type solver_type,
 
 //____________________________________________________________________________//
 
+void test_solver_parallel_linesearch(SolverTypes::Type solver_type,
+                                     ActionModelTypes::Type action_type,
+                                     size_t T) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the serial and parallel line-search solvers
+  SolverFactory solver_factory;
+  std::shared_ptr<crocoddyl::SolverDDP> solver =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model2, modelT, T));
+  std::shared_ptr<crocoddyl::SolverDDP> solver_ls =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model2, modelT, T));
+  solver_ls->set_ls_nthreads(3);
+  BOOST_CHECK_EQUAL(solver_ls->get_ls_nthreads(), 3);
+
+  // Generate the different state along the trajectory
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      solver->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t i = 0; i < T; ++i) {
+    const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+        problem->get_runningModels()[i];
+    xs.push_back(state->rand());
+    us.push_back(Eigen::VectorXd::Random(model->get_nu()));
+  }
+  xs.push_back(state->rand());
+
+  // Both line searches have to accept the same step lengths
+  solver->solve(xs, us, 10);
+  solver_ls->solve(xs, us, 10);
+  BOOST_CHECK_EQUAL(solver->get_iter(), solver_ls->get_iter());
+  BOOST_CHECK_CLOSE(solver->get_cost(), solver_ls->get_cost(), 1e-9);
+  for (std::size_t t = 0; t < T; ++t) {
+    BOOST_CHECK((state->diff_dx(solver->get_xs()[t], solver_ls->get_xs()[t]))
+                    .isZero(1e-9));
+    BOOST_CHECK((solver->get_us()[t] - solver_ls->get_us()[t]).isZero(1e-9));
+  }
+  BOOST_CHECK((state->diff_dx(solver->get_xs()[T], solver_ls->get_xs()[T]))
+                  .isZero(1e-9));
+
+  // The problem data has to match the accepted trajectory, even when it was
+  // rolled out in another line-search workspace
+  for (std::size_t maxiter = 1; maxiter <= 10; maxiter += 9) {
+    solver_ls->solve(xs, us, maxiter);
+    const std::shared_ptr<crocoddyl::ShootingProblem>& problem_ls =
+        solver_ls->get_problem();
+    for (std::size_t t = 0; t < T; ++t) {
+      const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+          problem_ls->get_runningModels()[t];
+      const std::shared_ptr<crocoddyl::ActionDataAbstract>& data =
+          problem_ls->get_runningDatas()[t];
+      std::shared_ptr<crocoddyl::ActionDataAbstract> data_ref =
+          model->createData();
+      model->calc(data_ref, solver_ls->get_xs()[t], solver_ls->get_us()[t]);
+      BOOST_CHECK((data->xnext - data_ref->xnext).isZero(1e-9));
+      BOOST_CHECK_CLOSE(data->cost, data_ref->cost, 1e-9);
+    }
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_solver_parallel_backwardpass(SolverTypes::Type solver_type,
+                                       ActionModelTypes::Type action_type,
+                                       size_t T) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the serial and parallel backward-pass solvers
+  SolverFactory solver_factory;
+  std::shared_ptr<crocoddyl::SolverDDP> solver =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model2, modelT, T));
+  std::shared_ptr<crocoddyl::SolverDDP> solver_bp =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model2, modelT, T));
+  solver_bp->set_bp_nthreads(3);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  BOOST_CHECK_EQUAL(solver_bp->get_bp_nthreads(), 3);
+#endif
+
+  // Generate the different state along the trajectory
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      solver->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t i = 0; i < T; ++i) {
+    const std::shared_ptr<crocoddyl::ActionModelAbstract>& model =
+        problem->get_runningModels()[i];
+    xs.push_back(state->rand());
+    us.push_back(Eigen::VectorXd::Random(model->get_nu()));
+  }
+  xs.push_back(state->rand());
+
+  // Both backward passes have to compute the same search direction
+  solver->setCandidate(xs, us, false);
+  solver_bp->setCandidate(xs, us, false);
+  // The parallel backward pass is called directly, so it cannot silently fall
+  // back to the serial one. Without multithreading support, it has no
+  // workspaces and has to fall back
+  solver->computeDirection();
+  solver_bp->calcDiff();
+  if (solver_bp->get_bp_nthreads() > 1) {
+    BOOST_CHECK(solver_bp->backwardPassParallel());
+  } else {
+    BOOST_CHECK(!solver_bp->backwardPassParallel());
+    solver_bp->backwardPass();
+  }
+  for (std::size_t t = 0; t < T; ++t) {
+    BOOST_CHECK((solver->get_Vxx()[t] - solver_bp->get_Vxx()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_Vx()[t] - solver_bp->get_Vx()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_K()[t] - solver_bp->get_K()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_k()[t] - solver_bp->get_k()[t]).isZero(1e-7));
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_solver_batch(SolverTypes::Type solver_type,
+                       ActionModelTypes::Type action_type, size_t T) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the batch and reference solvers with different warm starts
+  const std::size_t N = 3;
+  SolverFactory solver_factory;
+  std::vector<std::shared_ptr<crocoddyl::SolverAbstract> > solvers;
+  std::vector<std::shared_ptr<crocoddyl::SolverAbstract> > solvers_ref;
+  std::vector<std::vector<Eigen::VectorXd> > xs(N);
+  std::vector<std::vector<Eigen::VectorXd> > us(N);
+  for (std::size_t i = 0; i < N; ++i) {
+    solvers.push_back(
+        solver_factory.create(solver_type, model, model2, modelT, T));
+    solvers_ref.push_back(
+        solver_factory.create(solver_type, model, model2, modelT, T));
+    const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+        solvers[i]->get_problem();
+    const std::shared_ptr<crocoddyl::StateAbstract>& state =
+        problem->get_runningModels()[0]->get_state();
+    for (std::size_t t = 0; t < T; ++t) {
+      xs[i].push_back(state->rand());
+      us[i].push_back(
+          Eigen::VectorXd::Random(problem->get_runningModels()[t]->get_nu()));
+    }
+    xs[i].push_back(state->rand());
+  }
+  crocoddyl::SolverBatch batch(solvers);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  // The batch runs each solver serially and restores its threads afterwards
+  batch.set_nthreads(2);
+  BOOST_CHECK_EQUAL(batch.get_nthreads(), 2);
+  std::shared_ptr<crocoddyl::SolverDDP> ddp =
+      std::dynamic_pointer_cast<crocoddyl::SolverDDP>(solvers[0]);
+  if (ddp) {
+    ddp->set_ls_nthreads(2);
+    ddp->set_bp_nthreads(2);
+  }
+#endif
+
+  // The batch has to reproduce the result of each solver
+  batch.solve(xs, us, 10);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  if (ddp) {
+    BOOST_CHECK_EQUAL(ddp->get_ls_nthreads(), 2);
+    BOOST_CHECK_EQUAL(ddp->get_bp_nthreads(), 2);
+  }
+#endif
+  for (std::size_t i = 0; i < N; ++i) {
+    const bool is_converged = solvers_ref[i]->solve(xs[i], us[i], 10);
+    const crocoddyl::SolverBatchResult& result = batch.get_results()[i];
+    BOOST_CHECK(result.error.empty());
+    BOOST_CHECK_EQUAL(result.is_converged, is_converged);
+    BOOST_CHECK_EQUAL(result.iter, solvers_ref[i]->get_iter());
+    BOOST_CHECK_CLOSE(result.cost, solvers_ref[i]->get_cost(), 1e-9);
+    for (std::size_t t = 0; t < T; ++t) {
+      BOOST_CHECK(
+          (solvers[i]->get_us()[t] - solvers_ref[i]->get_us()[t]).isZero(1e-9));
+    }
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_solver_fixed_size_backwardpass(SolverTypes::Type solver_type,
+                                         ActionModelTypes::Type action_type,
+                                         size_t T) {
+  // Create action models with the same dimensions
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the dynamic-size and fixed-size backward-pass solvers
+  SolverFactory solver_factory;
+  std::shared_ptr<crocoddyl::SolverDDP> solver =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model, modelT, T));
+  std::shared_ptr<crocoddyl::SolverDDP> solver_fs =
+      std::static_pointer_cast<crocoddyl::SolverDDP>(
+          solver_factory.create(solver_type, model, model, modelT, T));
+  solver_fs->set_bp_fixed_size(true);
+  BOOST_CHECK(solver_fs->get_bp_fixed_size());
+
+  // Generate the different state along the trajectory
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      solver->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t i = 0; i < T; ++i) {
+    xs.push_back(state->rand());
+    us.push_back(Eigen::VectorXd::Random(model->get_nu()));
+  }
+  xs.push_back(state->rand());
+
+  // Both backward passes have to compute the same search direction
+  solver->setCandidate(xs, us, false);
+  solver_fs->setCandidate(xs, us, false);
+  solver->computeDirection();
+  solver_fs->computeDirection();
+  for (std::size_t t = 0; t < T; ++t) {
+    BOOST_CHECK((solver->get_Vxx()[t] - solver_fs->get_Vxx()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_Vx()[t] - solver_fs->get_Vx()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_K()[t] - solver_fs->get_K()[t]).isZero(1e-7));
+    BOOST_CHECK((solver->get_k()[t] - solver_fs->get_k()[t]).isZero(1e-7));
+  }
+
+  // And the same solution
+  solver->solve(xs, us, 10, false);
+  solver_fs->solve(xs, us, 10, false);
+  BOOST_CHECK_EQUAL(solver->get_iter(), solver_fs->get_iter());
+  BOOST_CHECK(std::abs(solver->get_cost() - solver_fs->get_cost()) < 1e-7);
+}
+
+//____________________________________________________________________________//
+
+void test_solver_allocations(SolverTypes::Type solver_type,
+                             ActionModelTypes::Type action_type, size_t T) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the solver
+  SolverFactory solver_factory;
+  std::shared_ptr<crocoddyl::SolverAbstract> solver =
+      solver_factory.create(solver_type, model, model2, modelT, T);
+
+  // Generate a feasible and an infeasible warm start
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      solver->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t t = 0; t < T; ++t) {
+    xs.push_back(state->rand());
+    us.push_back(
+        Eigen::VectorXd::Random(problem->get_runningModels()[t]->get_nu()));
+  }
+  xs.push_back(state->rand());
+  std::vector<Eigen::VectorXd> xs_feas(T + 1, problem->get_x0());
+  problem->rollout(us, xs_feas);
+
+  // The solver iterations do not allocate memory once it is warmed up
+  solver->solve(xs_feas, us, 10, true);
+  {
+    AllocationCounter counter;
+    solver->solve(xs_feas, us, 10, true);
+    BOOST_CHECK_EQUAL(counter.get_nallocations(), 0);
+  }
+  solver->solve(xs, us, 10, false);
+  {
+    AllocationCounter counter;
+    solver->solve(xs, us, 10, false);
+    BOOST_CHECK_EQUAL(counter.get_nallocations(), 0);
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_solver_second_order(SolverTypes::Type solver_type,
+                              ActionModelTypes::Type action_type, size_t T,
+                              const bool intro) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the iLQR and full DDP solvers. SolverIntro inherits the
+  // second-order terms from SolverDDP, so it is built on the same problems
+  SolverFactory solver_factory;
+  std::shared_ptr<crocoddyl::SolverAbstract> solver =
+      solver_factory.create(solver_type, model, model2, modelT, T);
+  std::shared_ptr<crocoddyl::SolverAbstract> solver_so =
+      solver_factory.create(solver_type, model, model2, modelT, T);
+  if (intro) {
+    solver = std::make_shared<crocoddyl::SolverIntro>(solver->get_problem());
+    solver_so =
+        std::make_shared<crocoddyl::SolverIntro>(solver_so->get_problem());
+  }
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      solver_so->get_problem();
+  problem->set_second_order(true);
+  BOOST_CHECK(problem->get_second_order());
+
+  // Generate the different state along the trajectory and random costates
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  const std::size_t ndx = state->get_ndx();
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  std::vector<Eigen::VectorXd> lambdas;
+  for (std::size_t t = 0; t < T; ++t) {
+    xs.push_back(state->rand());
+    us.push_back(
+        Eigen::VectorXd::Random(problem->get_runningModels()[t]->get_nu()));
+    lambdas.push_back(Eigen::VectorXd::Random(ndx));
+  }
+  xs.push_back(state->rand());
+  lambdas.push_back(Eigen::VectorXd::Random(ndx));
+
+  // Checking that costates with a wrong dimension are rejected
+  std::vector<Eigen::VectorXd> lambdas_wrong = lambdas;
+  lambdas_wrong[0] = Eigen::VectorXd::Zero(ndx + 1);
+  BOOST_CHECK_THROW(problem->calcDiff(xs, us, lambdas_wrong),
+                    crocoddyl::Exception);
+
+  // The second-order terms have to match the second differences of the
+  // costate-weighted dynamics (the states of these models are Euclidean).
+  // Their computation does not allocate memory once it is warmed up
+  problem->calcDiff(xs, us, lambdas);
+  {
+    AllocationCounter counter;
+    problem->calcDiff(xs, us, lambdas);
+    BOOST_CHECK_EQUAL(counter.get_nallocations(), 0);
+  }
+  const double h = 1e-4;
+  for (std::size_t t = 0; t < T; ++t) {
+    const std::shared_ptr<crocoddyl::ActionModelAbstract>& m =
+        problem->get_runningModels()[t];
+    const std::shared_ptr<crocoddyl::ActionDataAbstract> d = m->createData();
+    const std::size_t nz = ndx + m->get_nu();
+    Eigen::VectorXd z = Eigen::VectorXd::Zero(nz);
+    Eigen::VectorXd phi = Eigen::VectorXd::Zero(nz + 1);
+    Eigen::MatrixXd Fzz = Eigen::MatrixXd::Zero(nz, nz);
+    for (std::size_t i = 0; i < nz + 1; ++i) {
+      z.setZero();
+      if (i < nz) {
+        z(i) = h;
+      }
+      m->calc(d, xs[t] + z.head(ndx), us[t] + z.tail(nz - ndx));
+      phi(i) = lambdas[t + 1].dot(d->xnext);
+    }
+    for (std::size_t i = 0; i < nz; ++i) {
+      for (std::size_t j = 0; j < nz; ++j) {
+        z.setZero();
+        z(i) += h;
+        z(j) += h;
+        m->calc(d, xs[t] + z.head(ndx), us[t] + z.tail(nz - ndx));
+        Fzz(i, j) = lambdas[t + 1].dot(d->xnext) - phi(i) - phi(j) + phi(nz);
+        Fzz(i, j) /= h * h;
+      }
+    }
+    BOOST_CHECK((problem->get_dynamicsHessians()[t] - Fzz).isZero(1e-4));
+  }
+
+  // Both solvers have to converge to the same solution
+  solver->solve(xs, us, 100, false);
+  solver_so->solve(xs, us, 100, false);
+  const double cost = solver->get_cost();
+  BOOST_CHECK(std::abs(cost - solver_so->get_cost()) <=
+              1e-6 * std::max(1., std::abs(cost)));
+
+  // The full DDP does not need more iterations than the iLQR one
+  if (solver_type == SolverTypes::SolverDDP && !intro) {
+    BOOST_CHECK_LE(solver_so->get_iter(), solver->get_iter());
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_intro_allocations(crocoddyl::EqualitySolverType type, size_t T) {
+  // Create a problem with equality constraints
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      std::make_shared<crocoddyl::ActionModelLQR>(
+          crocoddyl::ActionModelLQR::Random(8, 4, 0, 2));
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      std::make_shared<crocoddyl::ActionModelLQR>(
+          crocoddyl::ActionModelLQR::Random(8, 4));
+  std::shared_ptr<crocoddyl::ShootingProblem> problem =
+      std::make_shared<crocoddyl::ShootingProblem>(
+          Eigen::VectorXd::Random(8),
+          std::vector<std::shared_ptr<crocoddyl::ActionModelAbstract> >(T,
+                                                                        model),
+          modelT);
+  crocoddyl::SolverIntro solver(problem);
+  solver.set_equality_solver(type);
+
+  // Generate an infeasible warm start
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  for (std::size_t t = 0; t < T; ++t) {
+    xs.push_back(Eigen::VectorXd::Random(8));
+    us.push_back(Eigen::VectorXd::Random(4));
+  }
+  xs.push_back(Eigen::VectorXd::Random(8));
+
+  // The solver iterations do not allocate memory once it is warmed up
+  solver.solve(xs, us, 10, false);
+  AllocationCounter counter;
+  solver.solve(xs, us, 10, false);
+  BOOST_CHECK_EQUAL(counter.get_nallocations(), 0);
+}
+
+//____________________________________________________________________________//
+
 void register_kkt_solver_unit_tests(ActionModelTypes::Type action_type,
                                     const std::size_t T) {
   boost::test_tools::output_test_stream test_name;
-  test_name << "test_SolverKKT_" << action_type;
+  test_name << "test_SolverKKT_" << action_type << "_" << T;
   test_suite* ts = BOOST_TEST_SUITE(test_name.str());
   std::cout << "Running " << test_name.str() << std::endl;
   ts->add(BOOST_TEST_CASE(boost::bind(&test_kkt_dimension, action_type, T)));
   ts->add(
       BOOST_TEST_CASE(boost::bind(&test_kkt_search_direction, action_type, T)));
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_kkt_regularized_direction, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+#ifdef CROCODDYL_WITH_IPOPT
+void create_ipopt_solvers(ActionModelTypes::Type action_type, size_t T,
+                          std::shared_ptr<crocoddyl::SolverIpopt>& ref,
+                          std::shared_ptr<crocoddyl::SolverIpopt>& solver,
+                          std::vector<Eigen::VectorXd>& xs,
+                          std::vector<Eigen::VectorXd>& us) {
+  // Create action models
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model =
+      ActionModelFactory().create(action_type);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> model2 =
+      ActionModelFactory().create(action_type, ActionModelFactory::Second);
+  std::shared_ptr<crocoddyl::ActionModelAbstract> modelT =
+      ActionModelFactory().create(action_type, ActionModelFactory::Terminal);
+
+  // Create the reference Ipopt solver, with its default options, and the one
+  // whose options are tested
+  SolverFactory solver_factory;
+  ref = std::static_pointer_cast<crocoddyl::SolverIpopt>(solver_factory.create(
+      SolverTypes::SolverIpopt, model, model2, modelT, T));
+  solver =
+      std::static_pointer_cast<crocoddyl::SolverIpopt>(solver_factory.create(
+          SolverTypes::SolverIpopt, model, model2, modelT, T));
+
+  // Generate the different state along the trajectory
+  const std::shared_ptr<crocoddyl::ShootingProblem>& problem =
+      ref->get_problem();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      problem->get_runningModels()[0]->get_state();
+  xs.clear();
+  us.clear();
+  for (std::size_t i = 0; i < T; ++i) {
+    xs.push_back(state->rand());
+    us.push_back(
+        Eigen::VectorXd::Random(problem->get_runningModels()[i]->get_nu()));
+  }
+  xs.push_back(state->rand());
+}
+
+void check_ipopt_solvers(const std::shared_ptr<crocoddyl::SolverIpopt>& ref,
+                         const std::shared_ptr<crocoddyl::SolverIpopt>& solver,
+                         const std::vector<Eigen::VectorXd>& xs,
+                         const std::vector<Eigen::VectorXd>& us,
+                         const double tol, const std::size_t maxiter = 100) {
+  // Both solvers have to converge to the same solution
+  const std::size_t T = ref->get_problem()->get_T();
+  const std::shared_ptr<crocoddyl::StateAbstract>& state =
+      ref->get_problem()->get_runningModels()[0]->get_state();
+  ref->solve(xs, us, 100);
+  solver->solve(xs, us, maxiter);
+  for (std::size_t t = 0; t < T; ++t) {
+    BOOST_CHECK(
+        (state->diff_dx(solver->get_xs()[t], ref->get_xs()[t])).isZero(tol));
+    BOOST_CHECK((solver->get_us()[t] - ref->get_us()[t]).isZero(tol));
+  }
+  BOOST_CHECK(
+      (state->diff_dx(solver->get_xs()[T], ref->get_xs()[T])).isZero(tol));
+}
+
+void test_ipopt_sparsity_detection(ActionModelTypes::Type action_type,
+                                   size_t T) {
+  std::shared_ptr<crocoddyl::SolverIpopt> dense, sparse;
+  std::vector<Eigen::VectorXd> xs, us;
+  create_ipopt_solvers(action_type, T, dense, sparse, xs, us);
+  sparse->set_sparsity_detection(true);
+  BOOST_CHECK(sparse->get_sparsity_detection());
+
+  // Checking that the detected pattern does not have more nonzeros than the
+  // dense one. The unicycle has structurally-zero derivatives, so it has fewer
+  crocoddyl::IpoptInterface dense_iface(dense->get_problem());
+  crocoddyl::IpoptInterface sparse_iface(sparse->get_problem());
+  sparse_iface.set_sparsity_detection(true);
+  Ipopt::Index n, m, nnz_jac_g, nnz_h_lag, n_dense, m_dense, nnz_jac_g_dense,
+      nnz_h_lag_dense;
+  Ipopt::TNLP::IndexStyleEnum index_style;
+  dense_iface.get_nlp_info(n_dense, m_dense, nnz_jac_g_dense, nnz_h_lag_dense,
+                           index_style);
+  sparse_iface.get_nlp_info(n, m, nnz_jac_g, nnz_h_lag, index_style);
+  BOOST_CHECK_EQUAL(n, n_dense);
+  BOOST_CHECK_EQUAL(m, m_dense);
+  BOOST_CHECK_LE(nnz_jac_g, nnz_jac_g_dense);
+  BOOST_CHECK_LE(nnz_h_lag, nnz_h_lag_dense);
+  if (action_type == ActionModelTypes::ActionModelUnicycle) {
+    BOOST_CHECK_LT(nnz_jac_g, nnz_jac_g_dense);
+    BOOST_CHECK_LT(nnz_h_lag, nnz_h_lag_dense);
+  }
+
+  check_ipopt_solvers(dense, sparse, xs, us, 1e-9);
+}
+
+void test_ipopt_limited_memory_hessian(ActionModelTypes::Type action_type,
+                                       size_t T) {
+  std::shared_ptr<crocoddyl::SolverIpopt> full, lbfgs;
+  std::vector<Eigen::VectorXd> xs, us;
+  create_ipopt_solvers(action_type, T, full, lbfgs, xs, us);
+  lbfgs->set_hessian_type(crocoddyl::LimitedMemoryHessian);
+  BOOST_CHECK(lbfgs->get_hessian_type() == crocoddyl::LimitedMemoryHessian);
+
+  // The quasi-Newton approximation converges to the same solution, but it
+  // needs more iterations and only up to the stopping tolerance
+  check_ipopt_solvers(full, lbfgs, xs, us, 1e-5, 1000);
+}
+
+void register_ipopt_unit_tests(ActionModelTypes::Type action_type,
+                               const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_SolverIpopt_options_" << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_ipopt_sparsity_detection, action_type, T)));
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_ipopt_limited_memory_hessian, action_type, T)));
   framework::master_test_suite().add(ts);
 }
+#endif
 
 void register_solvers_againt_kkt_unit_tests(SolverTypes::Type solver_type,
                                             ActionModelTypes::Type action_type,
@@ -197,6 +822,103 @@ void register_solvers_againt_kkt_unit_tests(SolverTypes::Type solver_type,
   framework::master_test_suite().add(ts);
 }
 
+void register_solver_parallel_linesearch_unit_tests(
+    SolverTypes::Type solver_type, ActionModelTypes::Type action_type,
+    const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_parallel_linesearch_"
+            << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_solver_parallel_linesearch,
+                                      solver_type, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_solver_parallel_backwardpass_unit_tests(
+    SolverTypes::Type solver_type, ActionModelTypes::Type action_type,
+    const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_parallel_backwardpass_"
+            << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_solver_parallel_backwardpass,
+                                      solver_type, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_solver_batch_unit_tests(SolverTypes::Type solver_type,
+                                     ActionModelTypes::Type action_type,
+                                     const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_batch_" << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_solver_batch, solver_type, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_solver_fixed_size_backwardpass_unit_tests(
+    SolverTypes::Type solver_type, ActionModelTypes::Type action_type,
+    const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_fixed_size_backwardpass_"
+            << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_solver_fixed_size_backwardpass,
+                                      solver_type, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_solver_allocations_unit_tests(SolverTypes::Type solver_type,
+                                            ActionModelTypes::Type action_type,
+                                            const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_allocations_" << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(
+      boost::bind(&test_solver_allocations, solver_type, action_type, T)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_solver_second_order_unit_tests(SolverTypes::Type solver_type,
+                                             ActionModelTypes::Type action_type,
+                                             const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_" << solver_type << "_second_order_" << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_solver_second_order, solver_type,
+                                      action_type, T, false)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_intro_second_order_unit_tests(ActionModelTypes::Type action_type,
+                                            const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_SolverIntro_second_order_" << action_type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_solver_second_order,
+                                      SolverTypes::SolverFDDP, action_type, T,
+                                      true)));
+  framework::master_test_suite().add(ts);
+}
+
+void register_intro_allocations_unit_tests(crocoddyl::EqualitySolverType type,
+                                           const std::size_t T) {
+  boost::test_tools::output_test_stream test_name;
+  test_name << "test_SolverIntro_allocations_" << type;
+  test_suite* ts = BOOST_TEST_SUITE(test_name.str());
+  std::cout << "Running " << test_name.str() << std::endl;
+  ts->add(BOOST_TEST_CASE(boost::bind(&test_intro_allocations, type, T)));
+  framework::master_test_suite().add(ts);
+}
+
 //____________________________________________________________________________//
 
 bool init_function() {
@@ -205,6 +927,9 @@ bool init_function() {
   for (size_t i = 0; i < ActionModelTypes::all.size(); ++i) {
     register_kkt_solver_unit_tests(ActionModelTypes::all[i], T);
   }
+  // The sparse factorization of the KKT system scales with longer horizons
+  register_kkt_solver_unit_tests(ActionModelTypes::ActionModelUnicycle, 100);
+  register_kkt_solver_unit_tests(ActionModelTypes::ActionModelLQR, 100);
 
   // We start from 1 as 0 is the kkt solver
   for (size_t s = 1; s < SolverTypes::all.size(); ++s) {
@@ -212,8 +937,65 @@ bool init_function() {
          ++i) {
       register_solvers_againt_kkt_unit_tests(SolverTypes::all[s],
                                              ActionModelTypes::all[i], T);
+      // The linear solvers used by Ipopt are not thread-safe
+      if (SolverTypes::all[s] != SolverTypes::SolverIpopt) {
+        register_solver_batch_unit_tests(SolverTypes::all[s],
+                                         ActionModelTypes::all[i], T);
+      }
     }
   }
+
+  // The parallel line search and backward pass are available in the
+  // DDP-based solvers
+  for (size_t s = 1; s < SolverTypes::all.size(); ++s) {
+    if (SolverTypes::all[s] == SolverTypes::SolverIpopt) {
+      continue;
+    }
+    for (size_t i = 0; i < ActionModelTypes::ActionModelImpulseFwdDynamics_HyQ;
+         ++i) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+      // The line search runs serially without multithreading support
+      register_solver_parallel_linesearch_unit_tests(
+          SolverTypes::all[s], ActionModelTypes::all[i], T);
+#endif
+      register_solver_parallel_backwardpass_unit_tests(
+          SolverTypes::all[s], ActionModelTypes::all[i], T);
+    }
+    // The Unicycle and LQR(8,4) dimensions have a fixed-size Riccati step
+    register_solver_fixed_size_backwardpass_unit_tests(
+        SolverTypes::all[s], ActionModelTypes::ActionModelUnicycle, T);
+    register_solver_fixed_size_backwardpass_unit_tests(
+        SolverTypes::all[s], ActionModelTypes::ActionModelLQR, T);
+    // The core action models do not allocate memory in their calc and calcDiff
+    register_solver_allocations_unit_tests(
+        SolverTypes::all[s], ActionModelTypes::ActionModelUnicycle, T);
+    register_solver_allocations_unit_tests(
+        SolverTypes::all[s], ActionModelTypes::ActionModelLQR, T);
+  }
+
+  // The second-order mode is used by the DDP-based solvers and by SolverIntro,
+  // which inherits their value-function update. The full DDP terms are
+  // compared against finite differences, which requires Euclidean states
+  const SolverTypes::Type ddp_solvers[] = {
+      SolverTypes::SolverDDP, SolverTypes::SolverFDDP,
+      SolverTypes::SolverBoxDDP, SolverTypes::SolverBoxFDDP};
+  for (std::size_t s = 0; s < 4; ++s) {
+    register_solver_second_order_unit_tests(
+        ddp_solvers[s], ActionModelTypes::ActionModelUnicycle, T);
+    register_solver_second_order_unit_tests(
+        ddp_solvers[s], ActionModelTypes::ActionModelLQR, T);
+  }
+  register_intro_second_order_unit_tests(ActionModelTypes::ActionModelUnicycle,
+                                         T);
+  register_intro_second_order_unit_tests(ActionModelTypes::ActionModelLQR, T);
+#ifdef CROCODDYL_WITH_IPOPT
+  // The detected sparsity and the reused Hessians do not change the solution
+  register_ipopt_unit_tests(ActionModelTypes::ActionModelUnicycle, T);
+  register_ipopt_unit_tests(ActionModelTypes::ActionModelLQR, T);
+#endif
+  register_intro_allocations_unit_tests(crocoddyl::LuNull, T);
+  register_intro_allocations_unit_tests(crocoddyl::QrNull, T);
+  register_intro_allocations_unit_tests(crocoddyl::Schur, T);
   return true;
 }
 